@@ -1,5 +1,8 @@
 #include "Interface.h"
 
+#include <cstdlib>
+#include <iostream>
+
 #include "Printer.h"
 #include "Reader.h"
 
@@ -82,6 +85,12 @@ char Interface::initialDirection() {
     READ_AND_RETURN_CHAR();
 }
 
+std::string Interface::getDeclaredState() {
+    PRINT("getDeclaredState");
+    READ_LINE();
+    return input;
+}
+
 double Interface::getRandomFloat() {
     PRINT("getRandomFloat");
     READ_AND_RETURN_DOUBLE();
@@ -92,11 +101,26 @@ int Interface::millis() {
     READ_AND_RETURN_INT();
 }
 
+long long Interface::micros() {
+    PRINT("micros");
+    READ_AND_RETURN_LONG_LONG();
+}
+
 void Interface::delay(int milliseconds) {
     PRINT("delay", milliseconds);
     READ();
 }
 
+void Interface::setTimer(int periodUs) {
+    PRINT("setTimer", periodUs);
+    READ();
+}
+
+long long Interface::waitForTimer() {
+    PRINT("waitForTimer");
+    READ_AND_RETURN_LONG_LONG();
+}
+
 void Interface::setTileColor(int x, int y, char color) {
     PRINT("setTileColor", x, y, color);
 }
@@ -301,6 +325,11 @@ void Interface::diagonalRightRight(int count) {
     READ();
 }
 
+int Interface::executePath(const std::string& path) {
+    PRINT("executePath", path);
+    READ_AND_RETURN_INT();
+}
+
 int Interface::currentXTile() {
     PRINT("currentXTile");
     READ_AND_RETURN_INT();
@@ -331,6 +360,94 @@ double Interface::currentRotationDegrees() {
     READ_AND_RETURN_DOUBLE();
 }
 
+int Interface::request(const std::string& command) {
+    int id = m_nextRequestId;
+    m_nextRequestId += 1;
+    PRINT("#" + std::to_string(id), command);
+    return id;
+}
+
+std::string Interface::collect(int id) {
+
+    // Any responses before this one belong to requests (or asynchronous
+    // movements) that haven't been collected yet
+    while (m_responses.find(id) == m_responses.end()) {
+        std::string line;
+        std::getline(std::cin, line);
+        setAsideTaggedResponse(line);
+    }
+    std::string response = m_responses[id];
+    m_responses.erase(id);
+    if (!response.empty() && response.at(0) == '!') {
+        throw;
+    }
+    return response;
+}
+
+int Interface::moveAsync(const std::string& movement) {
+    int token = m_nextRequestId;
+    m_nextRequestId += 1;
+    PRINT("#" + std::to_string(token), "async", movement);
+    return token;
+}
+
+void Interface::waitMove(int token) {
+    collect(token);
+}
+
+bool Interface::moveDone(int token) {
+
+    // Once a movement is reported as done, its response is thrown away, so
+    // that responses to movements that are never waited on don't pile up
+    if (m_responses.erase(token) == 1) {
+        return true;
+    }
+    PRINT("moveDone", token);
+    READ();
+
+    // The response to the movement comes before this one, so it's already
+    // been set aside
+    bool done = (input == "true");
+    if (done) {
+        m_responses.erase(token);
+    }
+    return done;
+}
+
+bool Interface::collectBool(int id) {
+    return collect(id) == "true";
+}
+
+int Interface::collectInt(int id) {
+    return atoi(collect(id).c_str());
+}
+
+double Interface::collectDouble(int id) {
+    return atof(collect(id).c_str());
+}
+
+std::string Interface::readResponse() {
+    std::string line;
+    std::getline(std::cin, line);
+    while (!line.empty() && line.at(0) == '#') {
+        setAsideTaggedResponse(line);
+        std::getline(std::cin, line);
+    }
+    return line;
+}
+
+void Interface::setAsideTaggedResponse(const std::string& line) {
+
+    // The tag is followed by a space, and then the rest of the line is the
+    // response, which may itself contain spaces (e.g., getDeclaredState)
+    std::string::size_type space = line.find(' ');
+    std::string response;
+    if (space != std::string::npos) {
+        response = line.substr(space + 1);
+    }
+    m_responses[atoi(line.c_str() + 1)] = response;
+}
+
 std::string Interface::boolToString(bool value) {
     return value ? "true" : "false";
 }
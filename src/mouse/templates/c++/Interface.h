@@ -1,5 +1,6 @@
 #pragma once
 
+#include <map>
 #include <string>
 
 class Interface {
@@ -33,10 +34,19 @@ public:
     bool isOfficialMaze();
     char initialDirection();
 
+    // The walls, colors, and text declared by a previous run of the algorithm
+    // that crashed, as a single line: the number of records, followed by
+    // "wall <x> <y> <direction> <isWall>", "color <x> <y> <color>", and
+    // "text <x> <y> <text>" records. After a clean start, this is just "0".
+    std::string getDeclaredState();
+
     // Misc functions
     double getRandomFloat();
     int millis(); // # of milliseconds of sim time (adjusted based on sim speed) that have passed
+    long long micros(); // # of microseconds of sim time (adjusted based on sim speed) that have passed
     void delay(int milliseconds); // # of milliseconds of sim time (adjusted based on sim speed)
+    void setTimer(int periodUs); // Arm a periodic timer, in microseconds of sim time (zero disarms it)
+    long long waitForTimer(); // Block until the next timer deadline, and return it in microseconds
     void resetPosition(); // Reset position of the mouse
 
     // Input buttons
@@ -83,7 +93,8 @@ public:
     // Reset the encoder for a particular wheel to zero, but only if the encoder type is relative
     void resetWheelEncoder(const std::string& name);
 
-    // Returns a value in [0.0, 1.0]
+    // Returns a value in [0.0, 1.0] for area (ANALOG) sensors, 0.0 or 1.0
+    // for DIGITAL sensors, and meters for DISTANCE sensors
     double readSensor(const std::string& name);
 
     // Returns deg/s of rotation
@@ -126,6 +137,49 @@ public:
     void diagonalRightLeft(int count);
     void diagonalRightRight(int count);
 
+    // Executes a whole sequence of moves in one go, without stopping in
+    // between, e.g., "F3RF2UL" (forward three, right, forward two, turn
+    // around left). The moves are F<count>, L, R, UL, UR, and, with tile
+    // edge movements, DLL<count>, DLR<count>, DRL<count>, and DRR<count>.
+    // Returns the number of moves executed, which is less than the number
+    // of moves in the path if the next one would have crashed.
+    int executePath(const std::string& path);
+
+    // ----- Pipelined requests ----- //
+
+    // Sends any command that has a response (e.g., "wallFront" or
+    // "readSensor front") without waiting for it, and returns an ID for
+    // collecting the response later. Sending several requests before
+    // collecting any of them saves a round trip per request, e.g.:
+    //
+    //     int front = interface.request("wallFront");
+    //     int left = interface.request("wallLeft");
+    //     bool wallFront = interface.collectBool(front);
+    //     bool wallLeft = interface.collectBool(left);
+    int request(const std::string& command);
+
+    // Waits for the response to a request, which can only be collected once
+    std::string collect(int id);
+    bool collectBool(int id);
+    int collectInt(int id);
+    double collectDouble(int id);
+
+    // ----- Asynchronous movements ----- //
+
+    // Starts any of the movements above (e.g., "moveForward 3") without
+    // waiting for it, and returns a token for it. Movements still happen one
+    // after another, in order, but everything else is answered right away
+    // while they're in progress, so the algorithm can plan its next move
+    // while the mouse is moving.
+    int moveAsync(const std::string& movement);
+
+    // Waits until a movement is done
+    void waitMove(int token);
+
+    // Whether or not a movement is done, without waiting for it. Once this
+    // returns true, the token is used up, so don't also wait on it.
+    bool moveDone(int token);
+
     // ----- Omniscience methods ----- //
 
     int currentXTile();
@@ -139,4 +193,17 @@ public:
 private:
     std::string boolToString(bool value);
 
+    // Reads the next untagged response, setting aside any tagged responses
+    // (e.g., to asynchronous movements) that arrive before it
+    std::string readResponse();
+
+    // Keeps a tagged response (a line of the form "#<id> <response>") until
+    // it's collected
+    void setAsideTaggedResponse(const std::string& line);
+
+    // The ID of the next request, and the responses that have been read but
+    // not yet collected
+    int m_nextRequestId = 1;
+    std::map<int, std::string> m_responses;
+
 };
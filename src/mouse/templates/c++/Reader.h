@@ -3,13 +3,19 @@
 #include <cstdlib>
 #include <string>
 
+// These can only be used in Interface methods, since tagged responses are
+// set aside by Interface::readResponse()
+
 #define READ()\
-std::string input;\
-std::cin >> input;\
-if (input.at(0) == '!') {\
+std::string input = readResponse();\
+if (!input.empty() && input.at(0) == '!') {\
     throw;\
 }
 
+// Responses are read a line at a time, so this is the same as READ(), but
+// says that the response may contain spaces
+#define READ_LINE() READ()
+
 #define READ_AND_RETURN_BOOL() {\
     READ();\
     return input == "true";\
@@ -29,3 +35,8 @@ if (input.at(0) == '!') {\
     READ();\
     return atoi(input.c_str());\
 }
+
+#define READ_AND_RETURN_LONG_LONG() {\
+    READ();\
+    return atoll(input.c_str());\
+}
@@ -1,19 +1,54 @@
 #include "BufferInterface.h"
 
+#include <algorithm>
+
 #include "RGB.h"
 #include "SimUtilities.h"
 
 namespace mms {
 
+const int BufferInterface::CHUNK_SIZE = 8;
+
 BufferInterface::BufferInterface(
         QPair<int, int> mazeSize,
-        QVector<TriangleGraphic>* graphicCpuBuffer,
-        QVector<TriangleTexture>* textureCpuBuffer) :
+        RenderBuffer<TriangleGraphic>* graphicCpuBuffer,
+        RenderBuffer<TriangleTexture>* textureCpuBuffer) :
         m_mazeSize(mazeSize),
         m_graphicCpuBuffer(graphicCpuBuffer),
         m_textureCpuBuffer(textureCpuBuffer) {
 }
 
+QVector<MazeChunk> BufferInterface::getChunks(QPair<int, int> mazeSize) {
+    QVector<MazeChunk> chunks;
+    int firstTileIndex = 0;
+    for (int x = 0; x < mazeSize.first; x += CHUNK_SIZE) {
+        for (int y = 0; y < mazeSize.second; y += CHUNK_SIZE) {
+            MazeChunk chunk;
+            chunk.x = x;
+            chunk.y = y;
+            chunk.width = std::min(CHUNK_SIZE, mazeSize.first - x);
+            chunk.height = std::min(CHUNK_SIZE, mazeSize.second - y);
+            chunk.firstTileIndex = firstTileIndex;
+            firstTileIndex += chunk.width * chunk.height;
+            chunks.append(chunk);
+        }
+    }
+    return chunks;
+}
+
+QVector<QPair<int, int>> BufferInterface::getTilesInBufferOrder(QPair<int, int> mazeSize) {
+    QVector<QPair<int, int>> tiles;
+    tiles.reserve(mazeSize.first * mazeSize.second);
+    for (const MazeChunk& chunk : getChunks(mazeSize)) {
+        for (int x = chunk.x; x < chunk.x + chunk.width; x += 1) {
+            for (int y = chunk.y; y < chunk.y + chunk.height; y += 1) {
+                tiles.append({x, y});
+            }
+        }
+    }
+    return tiles;
+}
+
 void BufferInterface::initTileGraphicText(
         const Distance& wallLength,
         const Distance& wallWidth,
@@ -34,11 +69,13 @@ QPair<int, int> BufferInterface::getTileGraphicTextMaxSize() {
     return m_tileGraphicTextCache.getTileGraphicTextMaxSize();
 }
 
-void BufferInterface::insertIntoGraphicCpuBuffer(const Polygon& polygon, Color color, double alpha) {
-    QVector<TriangleGraphic> tgs = SimUtilities::polygonToTriangleGraphics(polygon, color, alpha);
-    for (int i = 0; i < tgs.size(); i += 1) {
-        m_graphicCpuBuffer->push_back(tgs.at(i));
-    }
+void BufferInterface::insertIntoGraphicCpuBuffer(
+        const Polygon& polygon,
+        Color color,
+        double alpha,
+        GraphicLayer layer) {
+    SimUtilities::appendTriangleGraphics(
+        polygon, color, alpha, m_graphicCpuBuffer, layer);
 }
 
 void BufferInterface::insertIntoTextureCpuBuffer() {
@@ -57,42 +94,60 @@ void BufferInterface::insertIntoTextureCpuBuffer() {
         {0.0, 0.0, 0.0, 1.0},
         {0.0, 0.0, 0.0, 0.0},
     };
-    m_textureCpuBuffer->push_back(t1);
-    m_textureCpuBuffer->push_back(t2);
+    m_textureCpuBuffer->append(t1);
+    m_textureCpuBuffer->append(t2);
 }
 
 void BufferInterface::updateTileGraphicBaseColor(int x, int y, Color color) {
     int index = getTileGraphicBaseStartingIndex(x, y);
     RGB rgb = COLOR_TO_RGB().value(color);
+    quint8 r = packColorValue(rgb.r);
+    quint8 g = packColorValue(rgb.g);
+    quint8 b = packColorValue(rgb.b);
     for (int i = 0; i < 2; i += 1) {
-        TriangleGraphic* triangleGraphic = &(*m_graphicCpuBuffer)[index + i];
-        triangleGraphic->p1.rgb = rgb;
-        triangleGraphic->p2.rgb = rgb;
-        triangleGraphic->p3.rgb = rgb;
+        TriangleGraphic* triangleGraphic = m_graphicCpuBuffer->write(index + i);
+        for (VertexGraphic* vertex : {
+            &triangleGraphic->p1,
+            &triangleGraphic->p2,
+            &triangleGraphic->p3,
+        }) {
+            vertex->r = r;
+            vertex->g = g;
+            vertex->b = b;
+        }
     }
 }
 
 void BufferInterface::updateTileGraphicWallColor(int x, int y, Direction direction, Color color, double alpha) {
     int index = getTileGraphicWallStartingIndex(x, y, direction);
     RGB rgb = COLOR_TO_RGB().value(color);
+    quint8 r = packColorValue(rgb.r);
+    quint8 g = packColorValue(rgb.g);
+    quint8 b = packColorValue(rgb.b);
+    quint8 a = packColorValue(alpha);
     for (int i = 0; i < 2; i += 1) {
-        TriangleGraphic* triangleGraphic = &(*m_graphicCpuBuffer)[index + i];
-        triangleGraphic->p1.rgb = rgb;
-        triangleGraphic->p2.rgb = rgb;
-        triangleGraphic->p3.rgb = rgb;
-        triangleGraphic->p1.a = alpha;
-        triangleGraphic->p2.a = alpha;
-        triangleGraphic->p3.a = alpha;
+        TriangleGraphic* triangleGraphic = m_graphicCpuBuffer->write(index + i);
+        for (VertexGraphic* vertex : {
+            &triangleGraphic->p1,
+            &triangleGraphic->p2,
+            &triangleGraphic->p3,
+        }) {
+            vertex->r = r;
+            vertex->g = g;
+            vertex->b = b;
+            vertex->a = a;
+        }
     }
 }
 
 void BufferInterface::updateTileGraphicFog(int x, int y, double alpha) {
     int index = getTileGraphicFogStartingIndex(x, y);
+    quint8 a = packColorValue(alpha);
     for (int i = 0; i < 2; i += 1) {
-        TriangleGraphic* triangleGraphic = &(*m_graphicCpuBuffer)[index + i];
-        triangleGraphic->p1.a = alpha;
-        triangleGraphic->p2.a = alpha;
-        triangleGraphic->p3.a = alpha;
+        TriangleGraphic* triangleGraphic = m_graphicCpuBuffer->write(index + i);
+        triangleGraphic->p1.a = a;
+        triangleGraphic->p2.a = a;
+        triangleGraphic->p3.a = a;
     }
 }
 
@@ -113,8 +168,8 @@ void BufferInterface::updateTileGraphicText(int x, int y, int numRows, int numCo
         m_tileGraphicTextCache.getTileGraphicTextPosition(x, y, numRows, numCols, row, col);
 
     int triangleTextureIndex = getTileGraphicTextStartingIndex(x, y, row, col);
-    TriangleTexture* t1 = &(*m_textureCpuBuffer)[triangleTextureIndex];
-    TriangleTexture* t2 = &(*m_textureCpuBuffer)[triangleTextureIndex + 1];
+    TriangleTexture* t1 = m_textureCpuBuffer->write(triangleTextureIndex);
+    TriangleTexture* t2 = m_textureCpuBuffer->write(triangleTextureIndex + 1);
 
     t1->p1.x = LL_UR.first.getX().getMeters();
     t1->p1.y = LL_UR.first.getY().getMeters();
@@ -137,6 +192,22 @@ void BufferInterface::updateTileGraphicText(int x, int y, int numRows, int numCo
     t2->p3.u = fontImageCharacterPosition.second;
 }
 
+int BufferInterface::getTileIndex(int x, int y) {
+    // This must agree with the order of getTilesInBufferOrder: all chunk
+    // columns to the left are full height, and all chunks below in the same
+    // column are full height, so we can skip over them without iterating
+    int chunkX = x / CHUNK_SIZE;
+    int chunkY = y / CHUNK_SIZE;
+    int chunkWidth = std::min(CHUNK_SIZE, m_mazeSize.first - chunkX * CHUNK_SIZE);
+    int chunkHeight = std::min(CHUNK_SIZE, m_mazeSize.second - chunkY * CHUNK_SIZE);
+    return (
+        CHUNK_SIZE * chunkX * m_mazeSize.second +
+        chunkWidth * CHUNK_SIZE * chunkY +
+        chunkHeight * (x % CHUNK_SIZE) +
+        (y % CHUNK_SIZE)
+    );
+}
+
 int BufferInterface::trianglesPerTile() {
     // This value must be predetermined, and was done so as follows:
     // Base polygon:      2 (2 triangles x 1 polygon  per tile)
@@ -149,25 +220,25 @@ int BufferInterface::trianglesPerTile() {
 }
 
 int BufferInterface::getTileGraphicBaseStartingIndex(int x, int y) {
-    return  0 + trianglesPerTile() * (m_mazeSize.second * x + y);
+    return  0 + trianglesPerTile() * getTileIndex(x, y);
 }
 
 int BufferInterface::getTileGraphicWallStartingIndex(int x, int y, Direction direction) {
-    return  2 + trianglesPerTile() * (m_mazeSize.second * x + y) + (2 * DIRECTIONS().indexOf(direction));
+    return  2 + trianglesPerTile() * getTileIndex(x, y) + (2 * DIRECTIONS().indexOf(direction));
 }
 
 int BufferInterface::getTileGraphicCornerStartingIndex(int x, int y, int cornerNumber) {
-    return 10 + trianglesPerTile() * (m_mazeSize.second * x + y) + (2 * cornerNumber);
+    return 10 + trianglesPerTile() * getTileIndex(x, y) + (2 * cornerNumber);
 }
 
 int BufferInterface::getTileGraphicFogStartingIndex(int x, int y) {
-    return 18 + trianglesPerTile() * (m_mazeSize.second * x + y);
+    return 18 + trianglesPerTile() * getTileIndex(x, y);
 }
 
 int BufferInterface::getTileGraphicTextStartingIndex(int x, int y, int row, int col) {
     QPair<int, int> maxRowsAndCols = getTileGraphicTextMaxSize();
     int triangleTexturesPerTile = 2 * maxRowsAndCols.first * maxRowsAndCols.second;
-    return triangleTexturesPerTile * (m_mazeSize.second * x + y) + 2 * (row * maxRowsAndCols.second + col);
+    return triangleTexturesPerTile * getTileIndex(x, y) + 2 * (row * maxRowsAndCols.second + col);
 }
 
 } // namespace mms
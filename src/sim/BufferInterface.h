@@ -6,7 +6,10 @@
 
 #include "Color.h"
 #include "Direction.h"
+#include "GraphicLayer.h"
+#include "MazeChunk.h"
 #include "Polygon.h"
+#include "RenderBuffer.h"
 #include "TileGraphicTextCache.h"
 #include "TileTextAlignment.h"
 #include "TriangleGraphic.h"
@@ -20,8 +23,20 @@ public:
 
     BufferInterface(
         QPair<int, int> mazeSize,
-        QVector<TriangleGraphic>* graphicCpuBuffer,
-        QVector<TriangleTexture>* textureCpuBuffer);
+        RenderBuffer<TriangleGraphic>* graphicCpuBuffer,
+        RenderBuffer<TriangleTexture>* textureCpuBuffer);
+
+    // Tiles are stored in square chunks of CHUNK_SIZE x CHUNK_SIZE tiles (or
+    // smaller, along the top and right edges of the maze), so that the map
+    // can skip drawing chunks that aren't visible
+    static const int CHUNK_SIZE;
+
+    // Returns the chunks of a maze, in the order that they're buffered
+    static QVector<MazeChunk> getChunks(QPair<int, int> mazeSize);
+
+    // Returns the (x, y) positions of the tiles of a maze, in the order that
+    // they must be inserted into the buffers
+    static QVector<QPair<int, int>> getTilesInBufferOrder(QPair<int, int> mazeSize);
 
     // Initializes and caches all possible tile text positions. We need this
     // extra initialization function since the max size is from the algorithm.
@@ -36,7 +51,11 @@ public:
     QPair<int, int> getTileGraphicTextMaxSize();
 
     // Fills the graphic cpu buffer and texture cpu buffer
-    void insertIntoGraphicCpuBuffer(const Polygon& polygon, Color color, double alpha);
+    void insertIntoGraphicCpuBuffer(
+        const Polygon& polygon,
+        Color color,
+        double alpha,
+        GraphicLayer layer);
     void insertIntoTextureCpuBuffer();
 
     // These methods are inexpensive, and may be called many times
@@ -51,12 +70,15 @@ private:
     QPair<int, int> m_mazeSize;
 
     // CPU-side buffers
-    QVector<TriangleGraphic>* m_graphicCpuBuffer;
-    QVector<TriangleTexture>* m_textureCpuBuffer;
+    RenderBuffer<TriangleGraphic>* m_graphicCpuBuffer;
+    RenderBuffer<TriangleTexture>* m_textureCpuBuffer;
 
     // A cache for tile graphic text information
     TileGraphicTextCache m_tileGraphicTextCache;
 
+    // Retrieve the position of a tile in the buffers, in tiles
+    int getTileIndex(int x, int y);
+
     // Retrieve the indices into the graphic cpu buffer,
     // for each specific type of Tile triangle
     int trianglesPerTile();
@@ -0,0 +1,22 @@
+#include "CatchUpPolicy.h"
+
+#include "ContainerUtilities.h"
+
+namespace mms {
+
+const QMap<CatchUpPolicy, QString>& CATCH_UP_POLICY_TO_STRING() {
+    static const QMap<CatchUpPolicy, QString> map = {
+        {CatchUpPolicy::BURST, "BURST"},
+        {CatchUpPolicy::SKIP, "SKIP"},
+        {CatchUpPolicy::SLOW_DOWN, "SLOW_DOWN"},
+    };
+    return map;
+}
+
+const QMap<QString, CatchUpPolicy>& STRING_TO_CATCH_UP_POLICY() {
+    static const QMap<QString, CatchUpPolicy> map =
+        ContainerUtilities::inverse(CATCH_UP_POLICY_TO_STRING());
+    return map;
+}
+
+} // namespace mms
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <QDebug>
+#include <QMap>
+#include <QString>
+
+#include "ContainerUtilities.h"
+
+namespace mms {
+
+// What the model does, in real-time mode, after it misses a deadline:
+// BURST runs every missed tick right away, SKIP drops the missed ticks but
+// stays on the original schedule, and SLOW_DOWN starts a new schedule from
+// the time it woke up (so the sim falls behind real time)
+enum class CatchUpPolicy {
+    BURST,
+    SKIP,
+    SLOW_DOWN,
+};
+
+const QMap<CatchUpPolicy, QString>& CATCH_UP_POLICY_TO_STRING();
+const QMap<QString, CatchUpPolicy>& STRING_TO_CATCH_UP_POLICY();
+
+inline QDebug operator<<(QDebug stream, CatchUpPolicy catchUpPolicy) {
+    stream.noquote() << CATCH_UP_POLICY_TO_STRING().value(catchUpPolicy);
+    return stream;
+}
+
+} // namespace mms
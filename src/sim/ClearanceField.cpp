@@ -0,0 +1,138 @@
+#include "ClearanceField.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Maze.h"
+#include "Param.h"
+
+namespace mms {
+
+ClearanceField::ClearanceField() :
+        m_originX(0.0),
+        m_originY(0.0),
+        m_resolution(1.0),
+        m_width(0),
+        m_height(0) {
+}
+
+ClearanceField::ClearanceField(const Maze& maze) : ClearanceField() {
+
+    if (maze.getWidth() == 0 || maze.getHeight() == 0) {
+        return;
+    }
+
+    double halfWallWidth = P()->wallWidth() / 2.0;
+    double tileLength = P()->wallLength() + P()->wallWidth();
+
+    // The grid covers the maze out to the far sides of its outer walls
+    m_originX = -halfWallWidth;
+    m_originY = -halfWallWidth;
+    m_resolution = P()->clearanceFieldResolution();
+    m_width = static_cast<int>(std::ceil(
+        (maze.getWidth() * tileLength + 2.0 * halfWallWidth) / m_resolution)) + 1;
+    m_height = static_cast<int>(std::ceil(
+        (maze.getHeight() * tileLength + 2.0 * halfWallWidth) / m_resolution)) + 1;
+    m_clearances.resize(m_width * m_height);
+
+    // The signed distance from a point to an axis-aligned box
+    auto getSignedDistance = [](
+            double x, double y,
+            double minX, double minY,
+            double maxX, double maxY) {
+        double dx = std::max(minX - x, x - maxX);
+        double dy = std::max(minY - y, y - maxY);
+        if (dx <= 0.0 && dy <= 0.0) {
+            return std::max(dx, dy);
+        }
+        return std::hypot(std::max(dx, 0.0), std::max(dy, 0.0));
+    };
+
+    // Only the posts and walls of the tile that a sample is in are checked.
+    // Any other wall either meets one of those posts, where it's no closer
+    // than the post itself, or is at least a tile length away, which is
+    // farther than the nearest of the four posts can be.
+    float* clearance = m_clearances.data();
+    for (int j = 0; j < m_height; j += 1) {
+        double y = m_originY + j * m_resolution;
+        int tileY = std::min(
+            std::max(static_cast<int>(std::floor(y / tileLength)), 0),
+            maze.getHeight() - 1);
+        double bottom = tileY * tileLength;
+        double top = bottom + tileLength;
+        for (int i = 0; i < m_width; i += 1) {
+            double x = m_originX + i * m_resolution;
+            int tileX = std::min(
+                std::max(static_cast<int>(std::floor(x / tileLength)), 0),
+                maze.getWidth() - 1);
+            double left = tileX * tileLength;
+            double right = left + tileLength;
+            const Tile* tile = maze.getTile(tileX, tileY);
+
+            // The walls span the posts at either end, like in
+            // CollisionUtilities, which doesn't change the distance
+            double distance = std::numeric_limits<double>::max();
+            for (double postX : {left, right}) {
+                for (double postY : {bottom, top}) {
+                    distance = std::min(distance, getSignedDistance(
+                        x, y,
+                        postX - halfWallWidth, postY - halfWallWidth,
+                        postX + halfWallWidth, postY + halfWallWidth));
+                }
+            }
+            if (tile->isWall(Direction::NORTH)) {
+                distance = std::min(distance, getSignedDistance(
+                    x, y,
+                    left - halfWallWidth, top - halfWallWidth,
+                    right + halfWallWidth, top + halfWallWidth));
+            }
+            if (tile->isWall(Direction::EAST)) {
+                distance = std::min(distance, getSignedDistance(
+                    x, y,
+                    right - halfWallWidth, bottom - halfWallWidth,
+                    right + halfWallWidth, top + halfWallWidth));
+            }
+            if (tile->isWall(Direction::SOUTH)) {
+                distance = std::min(distance, getSignedDistance(
+                    x, y,
+                    left - halfWallWidth, bottom - halfWallWidth,
+                    right + halfWallWidth, bottom + halfWallWidth));
+            }
+            if (tile->isWall(Direction::WEST)) {
+                distance = std::min(distance, getSignedDistance(
+                    x, y,
+                    left - halfWallWidth, bottom - halfWallWidth,
+                    left + halfWallWidth, top + halfWallWidth));
+            }
+            *clearance = static_cast<float>(distance);
+            clearance += 1;
+        }
+    }
+}
+
+double ClearanceField::getClearance(double x, double y) const {
+
+    // NOTE: This runs for each vertex of the mouse on every tick of the
+    // model, so it works with plain doubles rather than the unit classes
+
+    if (m_clearances.isEmpty()) {
+        return 0.0;
+    }
+
+    // Bilinearly interpolate between the four surrounding samples
+    double u = std::min(std::max((x - m_originX) / m_resolution, 0.0), m_width - 1.0);
+    double v = std::min(std::max((y - m_originY) / m_resolution, 0.0), m_height - 1.0);
+    int i = std::min(static_cast<int>(u), m_width - 2);
+    int j = std::min(static_cast<int>(v), m_height - 2);
+    double fu = u - i;
+    double fv = v - j;
+    const float* below = m_clearances.constData() + j * m_width + i;
+    const float* above = below + m_width;
+    return (
+        (1.0 - fv) * ((1.0 - fu) * below[0] + fu * below[1]) +
+        fv * ((1.0 - fu) * above[0] + fu * above[1])
+    );
+}
+
+} // namespace mms
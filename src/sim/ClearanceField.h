@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QVector>
+
+namespace mms {
+
+class Maze;
+
+// A signed distance field of the walls and posts of a maze, sampled on a
+// regular grid (see the clearance-field-resolution param). It's computed once
+// per maze, so that the clearance of any point can then be looked up in
+// constant time, no matter how many walls are nearby.
+class ClearanceField {
+
+public:
+
+    // An empty field, whose clearance is zero everywhere
+    ClearanceField();
+    explicit ClearanceField(const Maze& maze);
+
+    // Returns the distance, in meters, from the point to the nearest wall or
+    // post of the maze, interpolated between the samples of the grid. The
+    // distance is negative if the point is inside of a wall or post. Points
+    // off of the grid get the clearance of the nearest point on its edge.
+    double getClearance(double x, double y) const;
+
+private:
+
+    // The position of the first sample, the spacing of the samples, and the
+    // number of samples along each axis, all in meters
+    double m_originX;
+    double m_originY;
+    double m_resolution;
+    int m_width;
+    int m_height;
+
+    // Row-major, i.e., the sample at (i, j) is at index j * m_width + i
+    QVector<float> m_clearances;
+
+};
+
+} // namespace mms
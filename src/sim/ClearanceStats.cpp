@@ -0,0 +1,123 @@
+#include "ClearanceStats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace mms {
+
+const double ClearanceStats::BIN_WIDTH = 0.0001;
+const double ClearanceStats::MIN_BINNED_CLEARANCE = -0.02;
+const int ClearanceStats::NUMBER_OF_BINS = 1200;
+const int ClearanceStats::MAX_SEGMENTS = 1024;
+
+ClearanceStats::ClearanceStats() {
+    m_run.clear();
+    m_segment.clear();
+}
+
+void ClearanceStats::add(
+        double clearance,
+        QPair<int, int> tile,
+        const Duration& time) {
+
+    // NOTE: This runs on every tick of the model
+
+    if (0 < m_segment.count && tile != m_currentSegment.tile) {
+        addFinishedSegment(finishSegment());
+        m_segment.clear();
+    }
+    if (m_segment.count == 0) {
+        m_currentSegment.tile = tile;
+        m_currentSegment.start = time;
+    }
+    m_currentSegment.end = time;
+    m_run.add(clearance);
+    m_segment.add(clearance);
+}
+
+int ClearanceStats::getCount() const {
+    return m_run.count;
+}
+
+double ClearanceStats::getMin() const {
+    if (m_run.count == 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return m_run.min;
+}
+
+double ClearanceStats::getPercentile(double fraction) const {
+    return m_run.getPercentile(fraction);
+}
+
+QVector<ClearanceSegment> ClearanceStats::getSegments() const {
+    QVector<ClearanceSegment> segments = m_finishedSegments;
+    if (0 < m_segment.count) {
+        segments.append(finishSegment());
+    }
+    return segments;
+}
+
+void ClearanceStats::addFinishedSegment(const ClearanceSegment& segment) {
+
+    // NOTE: This only runs when the mouse enters a new tile
+
+    if (m_finishedSegments.size() < MAX_SEGMENTS) {
+        m_finishedSegments.append(segment);
+        return;
+    }
+    auto loosest = std::max_element(
+        m_finishedSegments.begin(),
+        m_finishedSegments.end(),
+        [](const ClearanceSegment& a, const ClearanceSegment& b) {
+            return a.minClearance < b.minClearance;
+        });
+    if (segment.minClearance < loosest->minClearance) {
+        m_finishedSegments.erase(loosest);
+        m_finishedSegments.append(segment);
+    }
+}
+
+ClearanceSegment ClearanceStats::finishSegment() const {
+    ClearanceSegment segment = m_currentSegment;
+    segment.minClearance = m_segment.min;
+    segment.p5Clearance = m_segment.getPercentile(0.05);
+    return segment;
+}
+
+void ClearanceStats::Histogram::add(double clearance) {
+    int bin = static_cast<int>(std::floor(
+        (clearance - MIN_BINNED_CLEARANCE) / BIN_WIDTH));
+    bins[std::min(std::max(bin, 0), NUMBER_OF_BINS - 1)] += 1;
+    min = (count == 0 ? clearance : std::min(min, clearance));
+    count += 1;
+}
+
+void ClearanceStats::Histogram::clear() {
+    bins.fill(0, NUMBER_OF_BINS);
+    count = 0;
+    min = 0.0;
+}
+
+double ClearanceStats::Histogram::getPercentile(double fraction) const {
+
+    if (count == 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    // The smallest clearance such that at least the fraction of all of them
+    // are no greater than it, taken as the middle of its bin
+    int rank = std::max(1, static_cast<int>(std::ceil(fraction * count)));
+    int seen = 0;
+    for (int bin = 0; bin < NUMBER_OF_BINS; bin += 1) {
+        seen += bins.at(bin);
+        if (rank <= seen) {
+            double middle = MIN_BINNED_CLEARANCE + (bin + 0.5) * BIN_WIDTH;
+            return std::max(min, middle);
+        }
+    }
+    return MIN_BINNED_CLEARANCE + NUMBER_OF_BINS * BIN_WIDTH;
+}
+
+} // namespace mms
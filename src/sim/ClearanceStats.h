@@ -0,0 +1,78 @@
+#pragma once
+
+#include <QPair>
+#include <QVector>
+
+#include "units/Duration.h"
+
+namespace mms {
+
+// The clearance over one segment of a run, i.e., one uninterrupted stretch
+// of time spent in a single tile, in meters
+struct ClearanceSegment {
+    QPair<int, int> tile = {0, 0};
+    Duration start = Duration::Seconds(0);
+    Duration end = Duration::Seconds(0);
+    double minClearance = 0.0;
+    double p5Clearance = 0.0;
+};
+
+// Tracks how close the mouse came to the walls and posts of the maze, both
+// over the whole run and over each segment of it. The clearances are counted
+// in bins rather than kept, so that adding one takes constant time; in
+// exchange, percentiles are only accurate to within BIN_WIDTH. Only the
+// MAX_SEGMENTS tightest segments are kept, so that the memory doesn't grow
+// with the length of the run either.
+class ClearanceStats {
+
+public:
+
+    ClearanceStats();
+
+    // Records the clearance of a tick that ended with the mouse in the tile
+    void add(double clearance, QPair<int, int> tile, const Duration& time);
+
+    // The number of clearances recorded so far
+    int getCount() const;
+
+    // Both are NaN if nothing has been recorded yet
+    double getMin() const;
+    double getPercentile(double fraction) const;
+
+    // The tightest segments so far, in the order that they happened,
+    // including the one that's still in progress
+    QVector<ClearanceSegment> getSegments() const;
+
+private:
+
+    // The range of the bins, in meters; anything outside of the range is
+    // counted in the first or last bin
+    static const double BIN_WIDTH;
+    static const double MIN_BINNED_CLEARANCE;
+    static const int NUMBER_OF_BINS;
+
+    // Once this many segments have finished, each one that finishes replaces
+    // the one with the largest min clearance, if it's any smaller
+    static const int MAX_SEGMENTS;
+
+    // The counts of a set of clearances
+    struct Histogram {
+        QVector<int> bins;
+        int count = 0;
+        double min = 0.0;
+        void add(double clearance);
+        void clear();
+        double getPercentile(double fraction) const;
+    };
+
+    Histogram m_run;
+    Histogram m_segment;
+    ClearanceSegment m_currentSegment;
+    QVector<ClearanceSegment> m_finishedSegments;
+
+    void addFinishedSegment(const ClearanceSegment& segment);
+    ClearanceSegment finishSegment() const;
+
+};
+
+} // namespace mms
@@ -0,0 +1,248 @@
+#include "CollisionUtilities.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "Assert.h"
+#include "Param.h"
+
+namespace mms {
+
+const double CollisionUtilities::MAX_ROTATION_STEP = 0.0005;
+
+double CollisionUtilities::getTimeOfImpact(
+        const Polygon& polygon,
+        const Coordinate& startTranslation,
+        const Angle& startRotation,
+        const Coordinate& endTranslation,
+        const Angle& endRotation,
+        const Maze& maze) {
+
+    // NOTE: This runs on every tick of the model, so it works with plain
+    // doubles rather than the unit classes
+
+    // The vertices, relative to the center of rotation
+    double cx = startTranslation.getX().getMeters();
+    double cy = startTranslation.getY().getMeters();
+    QVector<QPointF> offsets;
+    double radius = 0.0;
+    for (const Coordinate& vertex : polygon.getVertices()) {
+        QPointF offset(vertex.getX().getMeters() - cx, vertex.getY().getMeters() - cy);
+        offsets.append(offset);
+        radius = std::max(radius, std::hypot(offset.x(), offset.y()));
+    }
+    ASSERT_LE(3, offsets.size());
+
+    double dx = endTranslation.getX().getMeters() - cx;
+    double dy = endTranslation.getY().getMeters() - cy;
+    double dr = (endRotation - startRotation).getRadiansUnbounded();
+
+    // A rotating polygon doesn't sweep a polygon, so the motion is split into
+    // steps over which the rotation is small, and each step is swept as a
+    // pure translation of the polygon as of the start of the step. To make
+    // up for the rotation that's ignored, the obstacles are grown by the
+    // most that any vertex can move due to rotation during a step. That way
+    // a collision may be reported a fraction of a millimeter early, but
+    // never late, and a wall can never be passed through.
+    int numSteps = std::max(1, static_cast<int>(std::ceil(
+        std::abs(dr) * radius / MAX_ROTATION_STEP)));
+    double padding = (dr == 0.0 ? 0.0 : std::abs(dr) * radius / numSteps);
+
+    // Only the obstacles near the motion can possibly be hit
+    Box region = {
+        std::min(0.0, dx) + cx - radius - padding,
+        std::min(0.0, dy) + cy - radius - padding,
+        std::max(0.0, dx) + cx + radius + padding,
+        std::max(0.0, dy) + cy + radius + padding,
+    };
+    QVector<Box> obstacles = getObstacles(region, maze);
+    if (obstacles.isEmpty()) {
+        return -1.0;
+    }
+    for (Box& box : obstacles) {
+        box.minX -= padding;
+        box.minY -= padding;
+        box.maxX += padding;
+        box.maxY += padding;
+    }
+
+    QPointF stepTranslation(dx / numSteps, dy / numSteps);
+    QVector<QPointF> vertices(offsets.size());
+    QVector<QPointF> normals(offsets.size());
+    for (int step = 0; step < numSteps; step += 1) {
+
+        // Position the polygon as of the start of the step
+        double fraction = static_cast<double>(step) / numSteps;
+        double cos = std::cos(dr * fraction);
+        double sin = std::sin(dr * fraction);
+        for (int i = 0; i < offsets.size(); i += 1) {
+            const QPointF& offset = offsets.at(i);
+            vertices[i] = QPointF(
+                cx + dx * fraction + offset.x() * cos - offset.y() * sin,
+                cy + dy * fraction + offset.x() * sin + offset.y() * cos);
+        }
+        for (int i = 0; i < vertices.size(); i += 1) {
+            QPointF edge = vertices.at((i + 1) % vertices.size()) - vertices.at(i);
+            normals[i] = QPointF(-edge.y(), edge.x());
+        }
+
+        // The first obstacle hit during the step, if any, is where we stop
+        double earliest = std::numeric_limits<double>::max();
+        for (const Box& box : obstacles) {
+            double time = getTimeOfImpact(vertices, normals, stepTranslation, box);
+            if (0.0 <= time) {
+                earliest = std::min(earliest, time);
+            }
+        }
+        if (earliest <= 1.0) {
+            return (step + earliest) / numSteps;
+        }
+    }
+
+    return -1.0;
+}
+
+QVector<CollisionUtilities::Box> CollisionUtilities::getObstacles(
+        const Box& region,
+        const Maze& maze) {
+
+    double halfWallWidth = P()->wallWidth() / 2.0;
+    double tileLength = P()->wallLength() + P()->wallWidth();
+
+    // The tiles whose walls or posts may overlap the region; anything
+    // outside of the maze is the model's concern, not ours
+    int minX = std::max(0, static_cast<int>(std::floor((region.minX - halfWallWidth) / tileLength)));
+    int minY = std::max(0, static_cast<int>(std::floor((region.minY - halfWallWidth) / tileLength)));
+    int maxX = std::min(maze.getWidth() - 1, static_cast<int>(std::floor((region.maxX + halfWallWidth) / tileLength)));
+    int maxY = std::min(maze.getHeight() - 1, static_cast<int>(std::floor((region.maxY + halfWallWidth) / tileLength)));
+
+    auto overlaps = [&region](const Box& box) {
+        return (
+            box.minX <= region.maxX && region.minX <= box.maxX &&
+            box.minY <= region.maxY && region.minY <= box.maxY
+        );
+    };
+
+    QVector<Box> obstacles;
+
+    // The posts are at the corners of every tile, whether or not any walls
+    // meet there
+    for (int x = minX; x <= maxX + 1; x += 1) {
+        for (int y = minY; y <= maxY + 1; y += 1) {
+            Box post = {
+                x * tileLength - halfWallWidth,
+                y * tileLength - halfWallWidth,
+                x * tileLength + halfWallWidth,
+                y * tileLength + halfWallWidth,
+            };
+            if (overlaps(post)) {
+                obstacles.append(post);
+            }
+        }
+    }
+
+    // Each wall spans the posts at either end, which doesn't change what's
+    // hit. Walls between two tiles in the region are seen from both sides,
+    // so only the south and west walls are taken from each tile, plus the
+    // north and east walls of the tiles on the edges of the region.
+    auto addWall = [&](double x0, double y0, double x1, double y1) {
+        Box wall = {x0, y0, x1, y1};
+        if (overlaps(wall)) {
+            obstacles.append(wall);
+        }
+    };
+    for (int x = minX; x <= maxX; x += 1) {
+        for (int y = minY; y <= maxY; y += 1) {
+            const Tile* tile = maze.getTile(x, y);
+            double left = x * tileLength;
+            double bottom = y * tileLength;
+            double right = left + tileLength;
+            double top = bottom + tileLength;
+            if (tile->isWall(Direction::SOUTH)) {
+                addWall(
+                    left - halfWallWidth, bottom - halfWallWidth,
+                    right + halfWallWidth, bottom + halfWallWidth);
+            }
+            if (tile->isWall(Direction::WEST)) {
+                addWall(
+                    left - halfWallWidth, bottom - halfWallWidth,
+                    left + halfWallWidth, top + halfWallWidth);
+            }
+            if (y == maxY && tile->isWall(Direction::NORTH)) {
+                addWall(
+                    left - halfWallWidth, top - halfWallWidth,
+                    right + halfWallWidth, top + halfWallWidth);
+            }
+            if (x == maxX && tile->isWall(Direction::EAST)) {
+                addWall(
+                    right - halfWallWidth, bottom - halfWallWidth,
+                    right + halfWallWidth, top + halfWallWidth);
+            }
+        }
+    }
+
+    return obstacles;
+}
+
+double CollisionUtilities::getTimeOfImpact(
+        const QVector<QPointF>& vertices,
+        const QVector<QPointF>& normals,
+        const QPointF& translation,
+        const Box& box) {
+
+    // By the separating axis theorem, two convex polygons overlap exactly
+    // when their projections overlap on every axis normal to an edge of
+    // either of them. As the polygon moves, each axis gives an interval of
+    // time during which the projections overlap, and the polygons first
+    // touch at the start of the intersection of all of the intervals.
+    double enter = 0.0;
+    double exit = 1.0;
+
+    auto clip = [&](const QPointF& axis) {
+        double polygonMin = std::numeric_limits<double>::max();
+        double polygonMax = std::numeric_limits<double>::lowest();
+        for (const QPointF& vertex : vertices) {
+            double projection = QPointF::dotProduct(vertex, axis);
+            polygonMin = std::min(polygonMin, projection);
+            polygonMax = std::max(polygonMax, projection);
+        }
+        double boxMin = std::numeric_limits<double>::max();
+        double boxMax = std::numeric_limits<double>::lowest();
+        for (const QPointF& corner : {
+            QPointF(box.minX, box.minY),
+            QPointF(box.minX, box.maxY),
+            QPointF(box.maxX, box.minY),
+            QPointF(box.maxX, box.maxY),
+        }) {
+            double projection = QPointF::dotProduct(corner, axis);
+            boxMin = std::min(boxMin, projection);
+            boxMax = std::max(boxMax, projection);
+        }
+        double speed = QPointF::dotProduct(translation, axis);
+        if (speed == 0.0) {
+            // Never overlapping on this axis means never touching at all
+            if (polygonMax < boxMin || boxMax < polygonMin) {
+                exit = -1.0;
+            }
+            return;
+        }
+        double first = (boxMin - polygonMax) / speed;
+        double second = (boxMax - polygonMin) / speed;
+        enter = std::max(enter, std::min(first, second));
+        exit = std::min(exit, std::max(first, second));
+    };
+
+    clip(QPointF(1.0, 0.0));
+    clip(QPointF(0.0, 1.0));
+    for (const QPointF& normal : normals) {
+        if (exit < enter) {
+            break;
+        }
+        clip(normal);
+    }
+
+    return (enter <= exit ? enter : -1.0);
+}
+
+} // namespace mms
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <QPointF>
+#include <QVector>
+
+#include "Maze.h"
+#include "Polygon.h"
+#include "units/Angle.h"
+#include "units/Coordinate.h"
+
+namespace mms {
+
+class CollisionUtilities {
+
+public:
+
+    // The CollisionUtilities class is not constructible
+    CollisionUtilities() = delete;
+
+    // Sweeps the polygon, which must be convex and positioned as of the
+    // start of the motion, as the pose it's attached to moves linearly from
+    // the start translation and rotation to the end translation and rotation
+    // (rotating around the translation). Returns the fraction of the motion,
+    // in [0.0, 1.0], at which the polygon first touches a wall or post of the
+    // maze, or a negative value if it never does. Unlike checking for overlap
+    // at the end of the motion, this can't miss a wall that was passed
+    // through entirely, no matter how long the motion is.
+    static double getTimeOfImpact(
+        const Polygon& polygon,
+        const Coordinate& startTranslation,
+        const Angle& startRotation,
+        const Coordinate& endTranslation,
+        const Angle& endRotation,
+        const Maze& maze);
+
+private:
+
+    // An axis-aligned rectangle, in meters
+    struct Box {
+        double minX;
+        double minY;
+        double maxX;
+        double maxY;
+    };
+
+    // The most that a vertex may move due to rotation alone during a single
+    // step of the sweep, in meters; see getTimeOfImpact
+    static const double MAX_ROTATION_STEP;
+
+    // Returns the walls and posts of the maze that overlap the region
+    static QVector<Box> getObstacles(const Box& region, const Maze& maze);
+
+    // Returns the fraction of the translation, in [0.0, 1.0], at which the
+    // polygon first touches the box, or a negative value if it never does
+    static double getTimeOfImpact(
+        const QVector<QPointF>& vertices,
+        const QVector<QPointF>& normals,
+        const QPointF& translation,
+        const Box& box);
+
+};
+
+} // namespace mms
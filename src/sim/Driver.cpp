@@ -1,13 +1,19 @@
 #include "Driver.h"
 
 #include <QApplication>
+#include <QCommandLineParser>
+#include <QDebug>
 
 #include "FontImage.h"
 #include "Logging.h"
+#include "ResultsStore.h"
 #include "Screen.h"
 #include "Settings.h"
 #include "SimTime.h"
+#include "SweepRunner.h"
+#include "SweepWorker.h"
 #include "Model.h"
+#include "TelemetryViewer.h"
 #include "Window.h"
 
 namespace mms {
@@ -20,6 +26,38 @@ int Driver::drive(int argc, char* argv[]) {
     // Initialize Qt
     QApplication app(argc, argv);
 
+    // Parse the command line options
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption viewerOption(
+        "viewer",
+        "Watch the telemetry stream published on <socket> by another sim, "
+        "instead of running one.",
+        "socket");
+    parser.addOption(viewerOption);
+    QCommandLineOption sweepOption(
+        "sweep",
+        "Run the parameter sweep described by <spec>, a JSON file, without "
+        "a window, and write its results.",
+        "spec");
+    parser.addOption(sweepOption);
+    QCommandLineOption sweepWorkerOption(
+        "sweep-worker",
+        "Run the sweep jobs read from stdin (used by --sweep).");
+    parser.addOption(sweepWorkerOption);
+    QCommandLineOption compareOption(
+        "compare",
+        "Compare two algorithms (each a name, or name@hash for a single "
+        "version) on a set of mazes, using the runs stored in <database>.",
+        "database");
+    parser.addOption(compareOption);
+    parser.addPositionalArgument(
+        "algos and mazes",
+        "With --compare: algorithm A, algorithm B, and then any maze files "
+        "or directories (every maze that both were run on, by default).",
+        "[algoA algoB [mazes...]]");
+    parser.process(app);
+
     // Initialize the Time object
     SimTime::init();
 
@@ -38,6 +76,44 @@ int Driver::drive(int argc, char* argv[]) {
     // Initialize the FontImage object
     FontImage::init(P()->tileTextFontImage());
 
+    // In viewer mode, just show the stream of another sim
+    if (parser.isSet(viewerOption)) {
+        TelemetryViewer viewer(parser.value(viewerOption));
+        viewer.resize(P()->defaultWindowWidth(), P()->defaultWindowHeight());
+        viewer.show();
+        return app.exec();
+    }
+
+    // Comparisons just print a table of stored results
+    if (parser.isSet(compareOption)) {
+        QStringList arguments = parser.positionalArguments();
+        if (arguments.size() < 2) {
+            qWarning().noquote() << "--compare needs two algorithms";
+            return 1;
+        }
+        return ResultsStore::compare(
+            parser.value(compareOption),
+            arguments.at(0),
+            arguments.at(1),
+            arguments.mid(2)
+        );
+    }
+
+    // In sweep mode, run the jobs of a sweep across several worker processes
+    if (parser.isSet(sweepOption)) {
+        SweepRunner runner;
+        QObject::connect(&runner, &SweepRunner::finished, &app, &QApplication::exit);
+        if (!runner.start(parser.value(sweepOption))) {
+            return 1;
+        }
+        return app.exec();
+    }
+    if (parser.isSet(sweepWorkerOption)) {
+        SweepWorker worker;
+        worker.start();
+        return app.exec();
+    }
+
     // Create the main window
     Window window;
     window.show();
@@ -50,7 +50,23 @@ Polygon GeometryUtilities::createCirclePolygon(
             Angle::Radians(i * 2 * M_PI / numberOfEdges)) + position
         );
     }
-    return Polygon(vertices);
+    return Polygon(vertices, PolygonShape::CONVEX);
+}
+
+Polygon GeometryUtilities::createRayPolygon(
+    const Coordinate& start,
+    const Coordinate& end
+) {
+    static const Distance halfWidth = Distance::Meters(0.001);
+    Coordinate offset = Coordinate::Polar(
+        halfWidth,
+        (end - start).getTheta() + Angle::Degrees(90));
+    return Polygon({
+        start + offset,
+        end + offset,
+        end - offset,
+        start - offset,
+    }, PolygonShape::CONVEX);
 }
 
 Area GeometryUtilities::crossProduct(const Coordinate& Z, const Coordinate& A, const Coordinate& B) {
@@ -110,7 +126,7 @@ Polygon GeometryUtilities::convexHull(const QVector<Polygon>& polygons) {
 
     hull.resize(k);
 
-    return Polygon(hull);
+    return Polygon(hull, PolygonShape::CONVEX);
 }
 
 Coordinate GeometryUtilities::castRay(
@@ -25,6 +25,10 @@ public:
     // Creates a circle polygon
     static Polygon createCirclePolygon(const Coordinate& position, const Distance& radius, int numberOfEdges);
 
+    // Creates a thin rectangle along the segment from start to end, so that
+    // a single ray (which has no area) can be drawn
+    static Polygon createRayPolygon(const Coordinate& start, const Coordinate& end);
+
     // Returns the cross product of the vectors ZA and ZB
     static Area crossProduct(const Coordinate& Z, const Coordinate& A, const Coordinate& B);
 
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <QtGlobal>
+
+namespace mms {
+
+// Tags each vertex of the maze with the layer it belongs to, so that the
+// polygon shader can show or hide whole layers based on a few uniforms,
+// without rewriting any buffers. The values are baked into the shader
+// source in Map.cpp, so keep the two in sync.
+enum class GraphicLayer : quint8 {
+    // Always drawn as-is (tile corners, the mouse, etc.)
+    NONE = 0,
+    // The base of a tile, drawn with the algorithm's color for the tile
+    TILE_COLOR = 1,
+    // A wall polygon where the maze has no wall
+    WALL_ABSENT = 2,
+    // A wall polygon where the maze has a wall
+    WALL_PRESENT = 3,
+    // The fog over a tile
+    TILE_FOG = 4,
+};
+
+} // namespace mms
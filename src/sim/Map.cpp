@@ -1,17 +1,31 @@
 #include "Map.h"
 
 #include <QPair>
+#include <QPointF>
+#include <QSize>
+#include <QVector4D>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
 
 #include "Assert.h"
+#include "Color.h"
 #include "FontImage.h"
 #include "Layout.h"
 #include "Logging.h"
 #include "Param.h"
+#include "RGB.h"
 #include "Screen.h"
 #include "TransformationMatrix.h"
+#include "VertexGraphic.h"
 
 namespace mms {
 
+const double Map::MIN_TILE_PIXELS_FOR_TEXT = 16.0;
+const int Map::MAZE_TEXTURE_PIXELS_PER_TILE = 8;
+
 Map::Map(QWidget* parent) :
     QOpenGLWidget(parent),
     m_maze(nullptr),
@@ -21,7 +35,16 @@ Map::Map(QWidget* parent) :
     m_windowHeight(0),
     m_layoutType(LayoutType::FULL),
     m_zoomedMapScale(0.1),
-    m_rotateZoomedMap(false) {
+    m_rotateZoomedMap(false),
+    m_polygonVBOMazeSize(0),
+    m_polygonVBOMouseCapacity(0),
+    m_textureVBOSize(0),
+    m_viewChanged(true),
+    m_trailVBOCapacity(0),
+    m_trailUploadedSize(0),
+    m_trailBufferChanged(false),
+    m_mazeTexture(nullptr),
+    m_mazeTextureDirty(true) {
     ASSERT_RUNS_JUST_ONCE();
 }
 
@@ -31,11 +54,12 @@ void Map::setMaze(const Maze* maze) {
     m_view = nullptr;
 }
 
-void Map::setView(const MazeView* view) {
+void Map::setView(MazeView* view) {
     if (view != nullptr) {
         ASSERT_FA(m_maze == nullptr);
     }
     m_view = view;
+    m_viewChanged = true;
 }
 
 void Map::setMouseGraphic(const MouseGraphic* mouseGraphic) {
@@ -46,6 +70,11 @@ void Map::setMouseGraphic(const MouseGraphic* mouseGraphic) {
     m_mouseGraphic = mouseGraphic;
 }
 
+void Map::setTrailBuffer(QSharedPointer<const TrailRingBuffer> trailBuffer) {
+    m_trailBuffer = trailBuffer;
+    m_trailBufferChanged = true;
+}
+
 void Map::setLayoutType(LayoutType layoutType) {
     m_layoutType = layoutType;
 }
@@ -115,6 +144,8 @@ void Map::initializeGL() {
     // Initialize the polygon and texture programs
     initPolygonProgram();
     initTextureProgram();
+    initTrail();
+    initMazeTexture();
 }
 
 void Map::paintGL() {
@@ -129,16 +160,17 @@ void Map::paintGL() {
     Angle currentMouseRotation;
     QVector<TriangleGraphic> mouseBuffer;
     if (m_mouseGraphic != nullptr) {
-        auto currentPosition = m_mouseGraphic->getCurrentMousePosition();
-        currentMouseTranslation = currentPosition.first;
-        currentMouseRotation = currentPosition.second;
-        mouseBuffer = m_mouseGraphic->draw(
-            currentMouseTranslation,
-            currentMouseRotation);
+        // Grab a single snapshot so that the mouse, its sensor views, and
+        // the zoomed map all agree on where the mouse is
+        MouseSnapshot snapshot = m_mouseGraphic->getCurrentSnapshot();
+        currentMouseTranslation = snapshot.translation;
+        currentMouseRotation = snapshot.rotation;
+        mouseBuffer = m_mouseGraphic->draw(snapshot);
     }
 
-    // Re-populate both vertex buffer objects
+    // Re-populate the vertex buffer objects
     repopulateVertexBufferObjects(mouseBuffer);
+    repopulateTrailVertexBufferObject();
 
     // Clear the screen
     glClear(GL_COLOR_BUFFER_BIT);
@@ -149,6 +181,29 @@ void Map::paintGL() {
     // Determine the starting index of the mouse
     int mouseTrianglesStartingIndex = m_view->getGraphicCpuBuffer()->size();
 
+    // Toggling a layer only changes these uniforms, never the buffers
+    const MazeGraphic* mazeGraphic = m_view->getMazeGraphic();
+    m_polygonProgram.bind();
+    m_polygonProgram.setUniformValue(
+        "wallTruthVisible", mazeGraphic->getWallTruthVisible());
+    m_polygonProgram.setUniformValue(
+        "tileColorsVisible", mazeGraphic->getTileColorsVisible());
+    m_polygonProgram.setUniformValue(
+        "tileFogVisible", mazeGraphic->getTileFogVisible());
+    QVector<bool> layers = {
+        mazeGraphic->getWallTruthVisible(),
+        mazeGraphic->getTileColorsVisible(),
+        mazeGraphic->getTileFogVisible(),
+    };
+    if (layers != m_mazeTextureLayers) {
+        m_mazeTextureLayers = layers;
+        m_mazeTextureDirty = true;
+    }
+
+    // Each tile has the same number of triangles in each buffer, which lets
+    // us draw (and cull) the tiles chunk-by-chunk
+    int numTiles = m_maze->getWidth() * m_maze->getHeight();
+
     // Draw the tiles
     drawMap(
         m_layoutType,
@@ -156,20 +211,29 @@ void Map::paintGL() {
         currentMouseRotation,
         &m_polygonProgram,
         &m_polygonVAO,
+        GL_TRIANGLES,
         0,
-        3 * m_view->getGraphicCpuBuffer()->size()
+        3 * m_view->getGraphicCpuBuffer()->size(),
+        3 * m_view->getGraphicCpuBuffer()->size() / numTiles
     );
 
     // Overlay the tile text
-    drawMap(
-        m_layoutType,
-        currentMouseTranslation,
-        currentMouseRotation,
-        &m_textureProgram,
-        &m_textureVAO,
-        0,
-        3 * m_view->getTextureCpuBuffer()->size()
-    );
+    if (mazeGraphic->getTileTextVisible()) {
+        drawMap(
+            m_layoutType,
+            currentMouseTranslation,
+            currentMouseRotation,
+            &m_textureProgram,
+            &m_textureVAO,
+            GL_TRIANGLES,
+            0,
+            3 * m_view->getTextureCpuBuffer()->size(),
+            3 * m_view->getTextureCpuBuffer()->size() / numTiles
+        );
+    }
+
+    // Draw the trail beneath the mouse
+    drawTrail(m_layoutType, currentMouseTranslation, currentMouseRotation);
 
     // Draw the mouse
     drawMap(
@@ -178,8 +242,10 @@ void Map::paintGL() {
         currentMouseRotation,
         &m_polygonProgram,
         &m_polygonVAO,
+        GL_TRIANGLES,
         3 * m_view->getGraphicCpuBuffer()->size(),
-        3 * mouseBuffer.size()
+        3 * mouseBuffer.size(),
+        0
     );
 
     // Disable scissoring so that the glClear can take effect, and so that
@@ -198,12 +264,33 @@ void Map::initPolygonProgram() {
         QOpenGLShader::Vertex,
         R"(
             uniform mat4 transformationMatrix;
+            uniform bool wallTruthVisible;
+            uniform bool tileColorsVisible;
+            uniform bool tileFogVisible;
+            uniform vec4 tileBaseColor;
+            uniform vec4 tileWallColor;
             attribute vec2 coordinate;
             attribute vec4 inColor;
+            attribute float inLayer;
             varying vec4 outColor;
             void main(void) {
                 gl_Position = transformationMatrix * vec4(coordinate, 0.0, 1.0);
-                outColor = inColor;
+                // The layer values are those of GraphicLayer
+                if (inLayer == 1.0 && !tileColorsVisible) {
+                    outColor = tileBaseColor;
+                }
+                else if (inLayer == 2.0 && wallTruthVisible) {
+                    outColor = vec4(0.0);
+                }
+                else if (inLayer == 3.0 && wallTruthVisible) {
+                    outColor = tileWallColor;
+                }
+                else if (inLayer == 4.0 && !tileFogVisible) {
+                    outColor = vec4(0.0);
+                }
+                else {
+                    outColor = inColor;
+                }
             }
         )"
     );
@@ -226,27 +313,122 @@ void Map::initPolygonProgram() {
     m_polygonVBO.bind();
     m_polygonVBO.setUsagePattern(QOpenGLBuffer::DynamicDraw);
 
+    setPolygonAttributeBuffers();
+
+    // The colors used when the true walls are visible, or when the tile
+    // colors are hidden, never change, so we only have to set them once. Note
+    // that a wall color equal to the base color means transparent walls.
+    Color baseColor = STRING_TO_COLOR().value(P()->tileBaseColor());
+    Color wallColor = STRING_TO_COLOR().value(P()->tileWallColor());
+    RGB tileBaseColor = COLOR_TO_RGB().value(baseColor);
+    RGB tileWallColor = COLOR_TO_RGB().value(wallColor);
+    m_polygonProgram.setUniformValue(
+        "tileBaseColor",
+        QVector4D(tileBaseColor.r, tileBaseColor.g, tileBaseColor.b, 1.0));
+    m_polygonProgram.setUniformValue(
+        "tileWallColor",
+        QVector4D(
+            tileWallColor.r,
+            tileWallColor.g,
+            tileWallColor.b,
+            wallColor == baseColor ? 0.0 : 1.0));
+
+    m_polygonVBO.release();
+    m_polygonVAO.release();
+    m_polygonProgram.release();
+}
+
+void Map::initTrail() {
+
+    // The trail uses the polygon program, but has its own buffer
+    m_polygonProgram.bind();
+
+    m_trailVAO.create();
+    m_trailVAO.bind();
+
+    m_trailVBO.create();
+    m_trailVBO.bind();
+    m_trailVBO.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+
+    setPolygonAttributeBuffers();
+
+    m_trailVBO.release();
+    m_trailVAO.release();
+    m_polygonProgram.release();
+}
+
+void Map::initMazeTexture() {
+
+    // The maze texture is drawn by the texture program, from its own buffer
+    // of two triangles; the texture itself is created when it's first drawn
+    m_textureProgram.bind();
+
+    m_mazeTextureVAO.create();
+    m_mazeTextureVAO.bind();
+
+    m_mazeTextureVBO.create();
+    m_mazeTextureVBO.bind();
+    m_mazeTextureVBO.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+
+    m_textureProgram.enableAttributeArray("coordinate");
+    m_textureProgram.setAttributeBuffer(
+        "coordinate", // name
+        GL_FLOAT, // type
+        offsetof(VertexTexture, x), // offset (bytes)
+        2, // tupleSize (number of elements in the attribute array)
+        sizeof(VertexTexture) // stride (bytes between vertices)
+    );
+
+    m_textureProgram.enableAttributeArray("inTextureCoordinate");
+    m_textureProgram.setAttributeBuffer(
+        "inTextureCoordinate", // name
+        GL_FLOAT, // type
+        offsetof(VertexTexture, u), // offset (bytes)
+        2, // tupleSize (number of elements in the attribute array)
+        sizeof(VertexTexture) // stride (bytes between vertices)
+    );
+
+    m_mazeTextureVBO.release();
+    m_mazeTextureVAO.release();
+    m_textureProgram.release();
+}
+
+void Map::setPolygonAttributeBuffers() {
+
+    // NOTE: This sets up whichever vertex array object is bound, to read
+    // VertexGraphic values from whichever vertex buffer object is bound
+
     m_polygonProgram.enableAttributeArray("coordinate");
     m_polygonProgram.setAttributeBuffer(
         "coordinate", // name
-        GL_DOUBLE, // type
-        0, // offset (bytes)
+        GL_FLOAT, // type
+        offsetof(VertexGraphic, x), // offset (bytes)
         2, // tupleSize (number of elements in the attribute array)
-        6 * sizeof(double) // stride (bytes between vertices)
+        sizeof(VertexGraphic) // stride (bytes between vertices)
     );
 
+    // The color values are packed as unsigned bytes, so we have to ask GL to
+    // normalize them to [0.0, 1.0] explicitly
     m_polygonProgram.enableAttributeArray("inColor");
-    m_polygonProgram.setAttributeBuffer(
-        "inColor", // name
-        GL_DOUBLE, // type
-        2 * sizeof(double), // offset (bytes)
-        4, // tupleSize (number of elements in the attribute array)
-        6 * sizeof(double) // stride (bytes between vertices)
+    glVertexAttribPointer(
+        m_polygonProgram.attributeLocation("inColor"), // index
+        4, // size (number of elements in the attribute array)
+        GL_UNSIGNED_BYTE, // type
+        GL_TRUE, // normalized
+        sizeof(VertexGraphic), // stride (bytes between vertices)
+        reinterpret_cast<const void*>(offsetof(VertexGraphic, r)) // offset
     );
 
-    m_polygonVBO.release();
-    m_polygonVAO.release();
-    m_polygonProgram.release();
+    // The layer is also a byte, but should be read as-is
+    m_polygonProgram.enableAttributeArray("inLayer");
+    glVertexAttribPointer(
+        m_polygonProgram.attributeLocation("inLayer"), // index
+        1, // size (number of elements in the attribute array)
+        GL_UNSIGNED_BYTE, // type
+        GL_FALSE, // normalized
+        sizeof(VertexGraphic), // stride (bytes between vertices)
+        reinterpret_cast<const void*>(offsetof(VertexGraphic, layer)) // offset
+    );
 }
 
 void Map::initTextureProgram() {
@@ -287,19 +469,19 @@ void Map::initTextureProgram() {
     m_textureProgram.enableAttributeArray("coordinate");
     m_textureProgram.setAttributeBuffer(
         "coordinate", // name
-        GL_DOUBLE, // type
-        0, // offset (bytes)
+        GL_FLOAT, // type
+        offsetof(VertexTexture, x), // offset (bytes)
         2, // tupleSize (number of elements in the attribute array)
-        4 * sizeof(double) // stride (bytes between vertices)
+        sizeof(VertexTexture) // stride (bytes between vertices)
     );
 
     m_textureProgram.enableAttributeArray("inTextureCoordinate");
     m_textureProgram.setAttributeBuffer(
         "inTextureCoordinate", // name
-        GL_DOUBLE, // type
-        2 * sizeof(double), // offset (bytes)
+        GL_FLOAT, // type
+        offsetof(VertexTexture, u), // offset (bytes)
         2, // tupleSize (number of elements in the attribute array)
-        4 * sizeof(double) // stride (bytes between vertices)
+        sizeof(VertexTexture) // stride (bytes between vertices)
     );
 
     // Load the bitmap texture into the texture atlas
@@ -313,35 +495,277 @@ void Map::initTextureProgram() {
 
 void Map::repopulateVertexBufferObjects(const QVector<TriangleGraphic>& mouseBuffer) {
 
-    // Overwrite the polygon vertex buffer object data
+    RenderBuffer<TriangleGraphic>* mazeBuffer = m_view->getGraphicCpuBuffer();
+    RenderBuffer<TriangleTexture>* textureBuffer = m_view->getTextureCpuBuffer();
+
+    // The polygon vertex buffer object holds the maze, followed by the mouse.
+    // It's only reallocated (and then uploaded in full) if the view changed
+    // or if something no longer fits; otherwise, only the part of the maze
+    // that changed since the last frame is uploaded.
     m_polygonVBO.bind();
-    m_polygonVBO.allocate(sizeof(TriangleGraphic) * (
-        m_view->getGraphicCpuBuffer()->size() +
-        mouseBuffer.size()
-    ));
+    if (
+        m_viewChanged ||
+        mazeBuffer->size() != m_polygonVBOMazeSize ||
+        m_polygonVBOMouseCapacity < mouseBuffer.size()
+    ) {
+        m_polygonVBOMazeSize = mazeBuffer->size();
+        m_polygonVBOMouseCapacity = mouseBuffer.size();
+        m_polygonVBO.allocate(sizeof(TriangleGraphic) * (
+            m_polygonVBOMazeSize +
+            m_polygonVBOMouseCapacity
+        ));
+        mazeBuffer->markAllDirty();
+    }
     // Write the maze
-    m_polygonVBO.write(
-        0,
-        &(m_view->getGraphicCpuBuffer()->front()),
-        sizeof(TriangleGraphic) * m_view->getGraphicCpuBuffer()->size()
-    );
+    QPair<int, int> dirtyRange = mazeBuffer->takeDirtyRange();
+    if (dirtyRange.first < dirtyRange.second) {
+        m_polygonVBO.write(
+            sizeof(TriangleGraphic) * dirtyRange.first,
+            mazeBuffer->data() + dirtyRange.first,
+            sizeof(TriangleGraphic) * (dirtyRange.second - dirtyRange.first)
+        );
+        m_mazeTextureDirty = true;
+    }
     // Write the mouse
     if (!mouseBuffer.isEmpty()) {
         m_polygonVBO.write(
-            sizeof(TriangleGraphic) * m_view->getGraphicCpuBuffer()->size(),
+            sizeof(TriangleGraphic) * m_polygonVBOMazeSize,
             &(mouseBuffer.front()),
             sizeof(TriangleGraphic) * mouseBuffer.size()
         );
     }
     m_polygonVBO.release();
 
-    // Overwrite the texture vertex buffer object data
+    // Likewise for the texture vertex buffer object
     m_textureVBO.bind();
-    m_textureVBO.allocate(
-        &(m_view->getTextureCpuBuffer()->front()),
-        sizeof(TriangleTexture) * m_view->getTextureCpuBuffer()->size()
-    );
+    if (m_viewChanged || textureBuffer->size() != m_textureVBOSize) {
+        m_textureVBOSize = textureBuffer->size();
+        m_textureVBO.allocate(sizeof(TriangleTexture) * m_textureVBOSize);
+        textureBuffer->markAllDirty();
+    }
+    dirtyRange = textureBuffer->takeDirtyRange();
+    if (dirtyRange.first < dirtyRange.second) {
+        m_textureVBO.write(
+            sizeof(TriangleTexture) * dirtyRange.first,
+            textureBuffer->data() + dirtyRange.first,
+            sizeof(TriangleTexture) * (dirtyRange.second - dirtyRange.first)
+        );
+    }
     m_textureVBO.release();
+
+    m_viewChanged = false;
+}
+
+void Map::repopulateTrailVertexBufferObject() {
+
+    if (m_trailBuffer == nullptr) {
+        return;
+    }
+
+    // Point i of the trail lives at index i % capacity of the ring, and
+    // whatever is at index 0 is also kept at index capacity, so that a trail
+    // that wraps around the ring can be drawn as two strips without a gap
+    int capacity = m_trailBuffer->getCapacity();
+    m_trailVBO.bind();
+    if (m_trailBufferChanged || m_trailVBOCapacity != capacity) {
+        m_trailVBOCapacity = capacity;
+        m_trailVBO.allocate(sizeof(VertexGraphic) * (capacity + 1));
+        m_trailUploadedSize = 0;
+        m_trailBufferChanged = false;
+    }
+
+    // Only convert and upload the points pushed since the last frame,
+    // skipping any that the model has already overwritten
+    qint64 size = m_trailBuffer->size();
+    qint64 begin = std::max(m_trailUploadedSize, m_trailBuffer->getFirstIndex(size));
+    QVector<VertexGraphic> vertices;
+    vertices.reserve(size - begin);
+    double maxSpeed = P()->trailMaxSpeed();
+    for (qint64 i = begin; i < size; i += 1) {
+        TrailPoint point = m_trailBuffer->at(i);
+        // Blue when slow, through green, to red at the max speed
+        double fraction = qBound(0.0, point.speed / maxSpeed, 1.0);
+        VertexGraphic vertex;
+        vertex.x = point.x;
+        vertex.y = point.y;
+        vertex.r = packColorValue(2.0 * fraction - 1.0);
+        vertex.g = packColorValue(1.0 - std::abs(2.0 * fraction - 1.0));
+        vertex.b = packColorValue(1.0 - 2.0 * fraction);
+        vertex.a = packColorValue(1.0);
+        vertex.layer = GraphicLayer::NONE;
+        vertices.append(vertex);
+    }
+    int offset = 0;
+    while (begin + offset < size) {
+        int index = (begin + offset) % capacity;
+        int count = static_cast<int>(std::min(
+            size - begin - offset,
+            static_cast<qint64>(capacity - index)));
+        m_trailVBO.write(
+            sizeof(VertexGraphic) * index,
+            vertices.constData() + offset,
+            sizeof(VertexGraphic) * count
+        );
+        if (index == 0) {
+            m_trailVBO.write(
+                sizeof(VertexGraphic) * capacity,
+                vertices.constData() + offset,
+                sizeof(VertexGraphic)
+            );
+        }
+        offset += count;
+    }
+    m_trailUploadedSize = size;
+    m_trailVBO.release();
+}
+
+void Map::renderMazeTexture() {
+
+    // The texture covers the maze out to the far sides of its outer walls
+    double halfWallWidth = P()->wallWidth() / 2.0;
+    double tileLength = P()->wallLength() + P()->wallWidth();
+    float left = static_cast<float>(-halfWallWidth);
+    float bottom = static_cast<float>(-halfWallWidth);
+    float right = static_cast<float>(m_maze->getWidth() * tileLength + halfWallWidth);
+    float top = static_cast<float>(m_maze->getHeight() * tileLength + halfWallWidth);
+
+    // Only reallocate the texture if the size of the maze changed
+    GLint maxTextureSize = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxTextureSize);
+    QSize size(
+        std::min(
+            static_cast<int>(std::ceil(
+                (right - left) / tileLength * MAZE_TEXTURE_PIXELS_PER_TILE)),
+            static_cast<int>(maxTextureSize)),
+        std::min(
+            static_cast<int>(std::ceil(
+                (top - bottom) / tileLength * MAZE_TEXTURE_PIXELS_PER_TILE)),
+            static_cast<int>(maxTextureSize))
+    );
+    if (m_mazeTexture == nullptr || m_mazeTexture->size() != size) {
+        delete m_mazeTexture;
+        m_mazeTexture = new QOpenGLFramebufferObject(size);
+        // Walls are thinner than a pixel of the texture, so blend rather
+        // than pick the nearest pixel
+        glBindTexture(GL_TEXTURE_2D, m_mazeTexture->texture());
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glBindTexture(GL_TEXTURE_2D, 0);
+    }
+    QVector<VertexTexture> quad = {
+        {left, bottom, 0.0, 0.0},
+        {right, bottom, 1.0, 0.0},
+        {right, top, 1.0, 1.0},
+        {left, bottom, 0.0, 0.0},
+        {right, top, 1.0, 1.0},
+        {left, top, 0.0, 1.0},
+    };
+    m_mazeTextureVBO.bind();
+    m_mazeTextureVBO.allocate(
+        quad.constData(), sizeof(VertexTexture) * quad.size());
+    m_mazeTextureVBO.release();
+
+    // Render the tiles into the texture, over the same black background as
+    // the map, and then switch back to the widget's framebuffer
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    GLboolean scissorEnabled = glIsEnabled(GL_SCISSOR_TEST);
+    glDisable(GL_SCISSOR_TEST);
+    m_mazeTexture->bind();
+    glViewport(0, 0, size.width(), size.height());
+    glClear(GL_COLOR_BUFFER_BIT);
+    QMatrix4x4 transformationMatrix;
+    transformationMatrix.ortho(left, right, bottom, top, -1.0, 1.0);
+    m_polygonProgram.bind();
+    m_polygonProgram.setUniformValue("transformationMatrix", transformationMatrix);
+    m_polygonVAO.bind();
+    glDrawArrays(GL_TRIANGLES, 0, 3 * m_polygonVBOMazeSize);
+    m_polygonVAO.release();
+    glBindFramebuffer(GL_FRAMEBUFFER, defaultFramebufferObject());
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+    if (scissorEnabled) {
+        glEnable(GL_SCISSOR_TEST);
+    }
+
+    m_mazeTextureDirty = false;
+}
+
+void Map::drawMazeTexture(const QMatrix4x4& transformationMatrix) {
+
+    if (m_mazeTextureDirty) {
+        renderMazeTexture();
+    }
+
+    m_textureProgram.bind();
+    m_textureProgram.setUniformValue("transformationMatrix", transformationMatrix);
+    m_textureProgram.setUniformValue("texture", 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, m_mazeTexture->texture());
+    m_mazeTextureVAO.bind();
+
+    // The tiles were already blended over the background when the texture
+    // was rendered, so the texture replaces whatever is beneath it
+    glDisable(GL_BLEND);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+    glEnable(GL_BLEND);
+
+    m_mazeTextureVAO.release();
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // The caller is still drawing with the polygon program
+    m_polygonProgram.bind();
+}
+
+void Map::drawTrail(
+        LayoutType type,
+        const Coordinate& currentMouseTranslation,
+        const Angle& currentMouseRotation) {
+
+    if (m_trailBuffer == nullptr || m_trailUploadedSize < 2) {
+        return;
+    }
+
+    // Draw only what's been uploaded, even if the model has since pushed more
+    int capacity = m_trailVBOCapacity;
+    int first = m_trailBuffer->getFirstIndex(m_trailUploadedSize) % capacity;
+    int last = (m_trailUploadedSize - 1) % capacity;
+    if (first <= last) {
+        drawMap(
+            type,
+            currentMouseTranslation,
+            currentMouseRotation,
+            &m_polygonProgram,
+            &m_trailVAO,
+            GL_LINE_STRIP,
+            first,
+            last - first + 1,
+            0
+        );
+    }
+    else {
+        drawMap(
+            type,
+            currentMouseTranslation,
+            currentMouseRotation,
+            &m_polygonProgram,
+            &m_trailVAO,
+            GL_LINE_STRIP,
+            first,
+            capacity - first + 1,
+            0
+        );
+        drawMap(
+            type,
+            currentMouseTranslation,
+            currentMouseRotation,
+            &m_polygonProgram,
+            &m_trailVAO,
+            GL_LINE_STRIP,
+            0,
+            last + 1,
+            0
+        );
+    }
 }
 
 void Map::drawMap(
@@ -350,8 +774,10 @@ void Map::drawMap(
         const Angle& currentMouseRotation,
         QOpenGLShaderProgram* program,
         QOpenGLVertexArrayObject* vao,
+        GLenum mode,
         int vboStartingIndex,
-        int count) {
+        int count,
+        int verticesPerTile) {
 
     // Get the physical size of the maze (in meters)
     double physicalMazeWidth = P()->wallWidth() + m_maze->getWidth() * (P()->wallWidth() + P()->wallLength());
@@ -393,7 +819,15 @@ void Map::drawMap(
 
         glScissor(fullMapPosition.first, fullMapPosition.second, fullMapSize.first, fullMapSize.second);
         program->setUniformValue("transformationMatrix", transformationMatrix);
-        glDrawArrays(GL_TRIANGLES, vboStartingIndex, count);
+        drawArrays(
+            program,
+            transformationMatrix,
+            fullMapPosition,
+            fullMapSize,
+            mode,
+            vboStartingIndex,
+            count,
+            verticesPerTile);
 
     }
 
@@ -425,7 +859,15 @@ void Map::drawMap(
 
         glScissor(zoomedMapPosition.first, zoomedMapPosition.second, zoomedMapSize.first, zoomedMapSize.second);
         program->setUniformValue("transformationMatrix", transformationMatrix2);
-        glDrawArrays(GL_TRIANGLES, vboStartingIndex, count);
+        drawArrays(
+            program,
+            transformationMatrix2,
+            zoomedMapPosition,
+            zoomedMapSize,
+            mode,
+            vboStartingIndex,
+            count,
+            verticesPerTile);
     }
 
     // If it's the texture program, we should additionally unbind the texture
@@ -437,4 +879,91 @@ void Map::drawMap(
     vao->release();
 }
 
+void Map::drawArrays(
+        QOpenGLShaderProgram* program,
+        const QMatrix4x4& transformationMatrix,
+        QPair<int, int> mapPosition,
+        QPair<int, int> mapSize,
+        GLenum mode,
+        int vboStartingIndex,
+        int count,
+        int verticesPerTile) {
+
+    // If the vertices aren't tiles (e.g., the mouse), or if we can't map
+    // the window back to the maze, just draw everything
+    bool invertible = false;
+    QMatrix4x4 inverse = transformationMatrix.inverted(&invertible);
+    if (verticesPerTile == 0 || !invertible) {
+        glDrawArrays(mode, vboStartingIndex, count);
+        return;
+    }
+
+    // Tile text is illegible when the tiles are small on screen, so skip it
+    double tileLength = P()->wallLength() + P()->wallWidth();
+    QVector4D metersToPixels = transformationMatrix.column(0);
+    double pixelsPerTile = tileLength * std::hypot(
+        metersToPixels.x() * m_windowWidth / 2.0,
+        metersToPixels.y() * m_windowHeight / 2.0);
+    if (program == &m_textureProgram && pixelsPerTile < MIN_TILE_PIXELS_FOR_TEXT) {
+        return;
+    }
+
+    // Likewise, when the tiles are no bigger on screen than they are in the
+    // pre-baked maze texture, it's cheaper to draw that than every triangle
+    if (program == &m_polygonProgram && pixelsPerTile <= MAZE_TEXTURE_PIXELS_PER_TILE) {
+        drawMazeTexture(transformationMatrix);
+        return;
+    }
+
+    // Find the region of the maze, in meters, that's visible within the map
+    // by mapping each corner of the map back through the transformation
+    double minX = std::numeric_limits<double>::max();
+    double minY = std::numeric_limits<double>::max();
+    double maxX = std::numeric_limits<double>::lowest();
+    double maxY = std::numeric_limits<double>::lowest();
+    for (int i = 0; i < 2; i += 1) {
+        for (int j = 0; j < 2; j += 1) {
+            QPointF corner = inverse.map(QPointF(
+                2.0 * (mapPosition.first + i * mapSize.first) / m_windowWidth - 1.0,
+                2.0 * (mapPosition.second + j * mapSize.second) / m_windowHeight - 1.0
+            ));
+            minX = std::min(minX, corner.x());
+            minY = std::min(minY, corner.y());
+            maxX = std::max(maxX, corner.x());
+            maxY = std::max(maxY, corner.y());
+        }
+    }
+
+    // Draw only the chunks that overlap the visible region, merging chunks
+    // that are adjacent in the buffer into a single draw call
+    double halfWallWidth = P()->wallWidth() / 2.0;
+    int runStart = 0;
+    int runCount = 0;
+    for (const MazeChunk& chunk : m_view->getChunks()) {
+        bool visible = (
+            chunk.x * tileLength - halfWallWidth <= maxX &&
+            chunk.y * tileLength - halfWallWidth <= maxY &&
+            minX <= (chunk.x + chunk.width) * tileLength + halfWallWidth &&
+            minY <= (chunk.y + chunk.height) * tileLength + halfWallWidth
+        );
+        if (!visible) {
+            continue;
+        }
+        int start = vboStartingIndex + verticesPerTile * chunk.firstTileIndex;
+        int chunkCount = verticesPerTile * chunk.width * chunk.height;
+        if (0 < runCount && runStart + runCount == start) {
+            runCount += chunkCount;
+            continue;
+        }
+        if (0 < runCount) {
+            glDrawArrays(mode, runStart, runCount);
+        }
+        runStart = start;
+        runCount = chunkCount;
+    }
+    if (0 < runCount) {
+        glDrawArrays(mode, runStart, runCount);
+    }
+}
+
 } // namespace mms
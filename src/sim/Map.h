@@ -1,18 +1,22 @@
 #pragma once
 
+#include <QMatrix4x4>
 #include <QOpenGLBuffer> 
 #include <QOpenGLDebugLogger>
+#include <QOpenGLFramebufferObject>
 #include <QOpenGLFunctions>
 #include <QOpenGLShaderProgram> 
 #include <QOpenGLTexture> 
 #include <QOpenGLVertexArrayObject> 
 #include <QOpenGLWidget>
+#include <QSharedPointer>
 #include <QVector>
 
 #include "LayoutType.h"
 #include "Maze.h"
 #include "MazeView.h"
 #include "MouseGraphic.h"
+#include "TrailRingBuffer.h"
 #include "TriangleGraphic.h"
 
 namespace mms {
@@ -29,8 +33,9 @@ public:
     Map(QWidget* parent = 0);
 
     void setMaze(const Maze* maze);
-    void setView(const MazeView* view);
+    void setView(MazeView* view);
     void setMouseGraphic(const MouseGraphic* mouseGraphic);
+    void setTrailBuffer(QSharedPointer<const TrailRingBuffer> trailBuffer);
 
     void setLayoutType(LayoutType layoutType);
     void setZoomedMapScale(double zoomedMapScale);
@@ -55,8 +60,9 @@ private:
 
     // No ownership here - only pointers
     const Maze* m_maze;
-    const MazeView* m_view;
+    MazeView* m_view;
     const MouseGraphic* m_mouseGraphic;
+    QSharedPointer<const TrailRingBuffer> m_trailBuffer;
 
     // The map's window size, in pixels
     int m_windowWidth;
@@ -67,6 +73,9 @@ private:
     double m_zoomedMapScale;
     bool m_rotateZoomedMap;
 
+    // Below this size, tile text is illegible and isn't drawn
+    static const double MIN_TILE_PIXELS_FOR_TEXT;
+
     // Polygon program variables
     QOpenGLShaderProgram m_polygonProgram;
     QOpenGLVertexArrayObject m_polygonVAO;
@@ -78,21 +87,74 @@ private:
     QOpenGLVertexArrayObject m_textureVAO;
     QOpenGLBuffer m_textureVBO;
 
+    // What the vertex buffer objects have room for, in triangles, and
+    // whether or not they have to be uploaded in full because the view
+    // changed; otherwise only the ranges that changed are uploaded
+    int m_polygonVBOMazeSize;
+    int m_polygonVBOMouseCapacity;
+    int m_textureVBOSize;
+    bool m_viewChanged;
+
+    // The trail is drawn by the polygon program, as a line strip, from its
+    // own vertex buffer object. That buffer is a ring with the same capacity
+    // as the trail buffer (plus one vertex, see below), and each frame only
+    // the points pushed since the last frame are uploaded to it.
+    QOpenGLVertexArrayObject m_trailVAO;
+    QOpenGLBuffer m_trailVBO;
+    int m_trailVBOCapacity;
+    qint64 m_trailUploadedSize;
+    bool m_trailBufferChanged;
+
+    // At or below this many pixels per tile, the tiles are drawn as a single
+    // quad textured with a pre-baked image of the maze, which has this many
+    // pixels per tile. The image is only re-rendered when it's dirty, i.e.,
+    // when part of the maze buffer was uploaded or a layer was toggled.
+    static const int MAZE_TEXTURE_PIXELS_PER_TILE;
+    QOpenGLFramebufferObject* m_mazeTexture;
+    QOpenGLVertexArrayObject m_mazeTextureVAO;
+    QOpenGLBuffer m_mazeTextureVBO;
+    QVector<bool> m_mazeTextureLayers;
+    bool m_mazeTextureDirty;
+
     // Initialize the graphics
     void initPolygonProgram();
     void initTextureProgram();
+    void initTrail();
+    void initMazeTexture();
+    void setPolygonAttributeBuffers();
 
     // Drawing helper methods
     void repopulateVertexBufferObjects(
         const QVector<TriangleGraphic>& mouseBuffer);
+    void repopulateTrailVertexBufferObject();
+    void renderMazeTexture();
+    void drawMazeTexture(const QMatrix4x4& transformationMatrix);
+    void drawTrail(
+        LayoutType type,
+        const Coordinate& currentMouseTranslation,
+        const Angle& currentMouseRotation);
     void drawMap(
         LayoutType type,
         const Coordinate& currentMouseTranslation,
         const Angle& currentMouseRotation,
         QOpenGLShaderProgram* program,
         QOpenGLVertexArrayObject* vao,
+        GLenum mode,
+        int vboStartingIndex,
+        int count,
+        int verticesPerTile);
+
+    // Draws the vertices, or only those in chunks that are visible within the
+    // map if verticesPerTile is nonzero (i.e., if the vertices are tiles)
+    void drawArrays(
+        QOpenGLShaderProgram* program,
+        const QMatrix4x4& transformationMatrix,
+        QPair<int, int> mapPosition,
+        QPair<int, int> mapSize,
+        GLenum mode,
         int vboStartingIndex,
-        int count);
+        int count,
+        int verticesPerTile);
 };
 
 } // namespace mms
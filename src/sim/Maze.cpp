@@ -45,6 +45,10 @@ Maze* Maze::fromAlgo(const QByteArray& bytes) {
     return new Maze(basicMaze);
 }
 
+Maze* Maze::fromBasicMaze(const BasicMaze& basicMaze) {
+    return new Maze(basicMaze);
+}
+
 Maze::Maze(BasicMaze basicMaze) {
 
     // Validate the maze
@@ -95,6 +99,9 @@ Maze::Maze(BasicMaze basicMaze) {
 
     // Load the maze given by the maze generation algorithm
     m_maze = initializeFromBasicMaze(basicMaze);
+
+    // Precompute the clearances, which need the tiles
+    m_clearanceField = ClearanceField(*this);
 }
 
 int Maze::getWidth() const {
@@ -151,6 +158,10 @@ Direction Maze::getOptimalStartingDirection() const {
     return Direction::NORTH;
 }
 
+const ClearanceField& Maze::getClearanceField() const {
+    return m_clearanceField;
+}
+
 QVector<QVector<Tile>> Maze::initializeFromBasicMaze(const BasicMaze& basicMaze) {
     // TODO: MACK - assert valid here
     QVector<QVector<Tile>> maze;
@@ -4,6 +4,7 @@
 #include <QVector>
 
 #include "BasicMaze.h"
+#include "ClearanceField.h"
 #include "Direction.h"
 #include "Tile.h"
 
@@ -15,6 +16,7 @@ public:
 
     static Maze* fromFile(const QString& path);
     static Maze* fromAlgo(const QByteArray& bytes);
+    static Maze* fromBasicMaze(const BasicMaze& basicMaze);
     
     int getWidth() const;
     int getHeight() const;
@@ -27,6 +29,9 @@ public:
     bool isCenterTile(int x, int y) const;
     Direction getOptimalStartingDirection() const;
 
+    // Computed once, when the maze is constructed
+    const ClearanceField& getClearanceField() const;
+
 private:
 
     // Private constructor forces clients to construct
@@ -39,6 +44,7 @@ private:
     // Cache results to these functions
     bool m_isValidMaze;
     bool m_isOfficialMaze;
+    ClearanceField m_clearanceField;
 
     // Initializes all of the tiles of the basic maze
     static QVector<QVector<Tile>> initializeFromBasicMaze(const BasicMaze& basicMaze);
@@ -0,0 +1,16 @@
+#pragma once
+
+namespace mms {
+
+// A rectangular block of tiles whose triangles are contiguous in the graphic
+// and texture cpu buffers, so that the block can be culled as a whole and
+// drawn with a single draw call
+struct MazeChunk {
+    int x;              // x position of the lower left tile
+    int y;              // y position of the lower left tile
+    int width;          // width, in tiles
+    int height;         // height, in tiles
+    int firstTileIndex; // position of the first tile in the buffers, in tiles
+};
+
+} // namespace mms
@@ -0,0 +1,90 @@
+#include "MazeFilesModel.h"
+
+#include <QFileInfo>
+
+namespace mms {
+
+MazeFilesModel::MazeFilesModel(QObject* parent) :
+    QAbstractTableModel(parent),
+    m_thumbnailer(new MazeThumbnailer(48, this)),
+    m_thumbnails(512),
+    m_placeholder(m_thumbnailer->getSize(), m_thumbnailer->getSize()) {
+    m_placeholder.fill(Qt::transparent);
+    connect(
+        m_thumbnailer, &MazeThumbnailer::thumbnailReady,
+        this, &MazeFilesModel::onThumbnailReady
+    );
+}
+
+void MazeFilesModel::setPaths(const QStringList& paths) {
+    beginResetModel();
+    m_thumbnailer->cancelPending();
+    m_paths = paths;
+    m_names.clear();
+    m_rows.clear();
+    for (int i = 0; i < m_paths.size(); i += 1) {
+        m_names.append(QFileInfo(m_paths.at(i)).fileName());
+        m_rows.insert(m_paths.at(i), i);
+    }
+    endResetModel();
+}
+
+QString MazeFilesModel::getPath(int row) const {
+    return m_paths.value(row);
+}
+
+int MazeFilesModel::getThumbnailSize() const {
+    return m_thumbnailer->getSize();
+}
+
+int MazeFilesModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : m_paths.size();
+}
+
+int MazeFilesModel::columnCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : 2;
+}
+
+QVariant MazeFilesModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || m_paths.size() <= index.row()) {
+        return QVariant();
+    }
+    if (role == Qt::DisplayRole || role == Qt::ToolTipRole) {
+        return index.column() == 0
+            ? m_names.at(index.row())
+            : m_paths.at(index.row());
+    }
+    if (role == Qt::DecorationRole && index.column() == 0) {
+        const QString& path = m_paths.at(index.row());
+        QPixmap* thumbnail = m_thumbnails.object(path);
+        if (thumbnail != nullptr) {
+            return *thumbnail;
+        }
+        // Show a blank placeholder until the thumbnail arrives
+        m_thumbnailer->request(path);
+        return m_placeholder;
+    }
+    return QVariant();
+}
+
+QVariant MazeFilesModel::headerData(
+        int section,
+        Qt::Orientation orientation,
+        int role) const {
+    if (orientation == Qt::Horizontal && role == Qt::DisplayRole) {
+        return section == 0 ? QString("File Name") : QString("File Path");
+    }
+    return QAbstractTableModel::headerData(section, orientation, role);
+}
+
+void MazeFilesModel::onThumbnailReady(const QString& path, const QImage& thumbnail) {
+    if (!m_rows.contains(path)) {
+        return;
+    }
+    // Cache a null pixmap for unreadable files too, so we don't keep retrying
+    m_thumbnails.insert(path, new QPixmap(QPixmap::fromImage(thumbnail)));
+    QModelIndex index = this->index(m_rows.value(path), 0);
+    emit dataChanged(index, index, {Qt::DecorationRole});
+}
+
+} // namespace mms
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <QAbstractTableModel>
+#include <QCache>
+#include <QHash>
+#include <QImage>
+#include <QModelIndex>
+#include <QPixmap>
+#include <QString>
+#include <QStringList>
+#include <QVariant>
+
+#include "MazeThumbnailer.h"
+
+namespace mms {
+
+// The list of known maze files, as shown in the maze files tab. Views only
+// ask for the rows they're showing, so thumbnails are only ever generated
+// (asynchronously) for mazes that actually scroll into view.
+class MazeFilesModel : public QAbstractTableModel {
+
+    Q_OBJECT
+
+public:
+
+    MazeFilesModel(QObject* parent = 0);
+
+    // Replaces all of the rows of the model
+    void setPaths(const QStringList& paths);
+    QString getPath(int row) const;
+
+    // The size, in pixels, of the thumbnails in the first column
+    int getThumbnailSize() const;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const;
+    QVariant headerData(
+        int section,
+        Qt::Orientation orientation,
+        int role = Qt::DisplayRole) const;
+
+private:
+
+    QStringList m_paths;
+    QStringList m_names;
+    QHash<QString, int> m_rows;
+
+    // Not owned by value, so that const data() can still request thumbnails
+    MazeThumbnailer* m_thumbnailer;
+
+    // Recently shown thumbnails, bounded so that browsing through thousands
+    // of mazes doesn't hold on to thousands of pixmaps
+    mutable QCache<QString, QPixmap> m_thumbnails;
+
+    // The blank pixmap shown until a thumbnail arrives, shared by every row
+    QPixmap m_placeholder;
+
+    void onThumbnailReady(const QString& path, const QImage& thumbnail);
+
+};
+
+} // namespace mms
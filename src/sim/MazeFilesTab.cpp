@@ -1,20 +1,24 @@
 #include "MazeFilesTab.h"
 
 #include <QFileDialog>
-#include <QFileInfo>
 #include <QHBoxLayout>
 #include <QHeaderView>
+#include <QItemSelectionModel>
 #include <QPushButton>
-#include <QTableWidget>
 #include <QVBoxLayout>
 
+#include "Assert.h"
 #include "MazeFileType.h"
 #include "Resources.h"
 #include "SettingsMazeFiles.h"
 
 namespace mms {
 
-MazeFilesTab::MazeFilesTab() : m_table(new QTableWidget()) {
+MazeFilesTab::MazeFilesTab() :
+    m_model(new MazeFilesModel(this)),
+    m_proxy(new QSortFilterProxyModel(this)),
+    m_table(new QTableView()),
+    m_loader(new MazeLoader(this)) {
 
     // Set up the layout
     QVBoxLayout* layout = new QVBoxLayout();
@@ -30,35 +34,59 @@ MazeFilesTab::MazeFilesTab() : m_table(new QTableWidget()) {
     // Create the remove button
     QPushButton* removeButton = new QPushButton("Remove Selected File");
     connect(removeButton, &QPushButton::clicked, this, &MazeFilesTab::remove);
-    connect(m_table, &QTableWidget::itemSelectionChanged, this, [=](){
-        // TODO: upforgrabs
-        // We should disable the remove button for the builtin mazes
-        removeButton->setEnabled(0 < m_table->selectedItems().size());
-    });
     removeButton->setEnabled(false);
     buttonsLayout->addWidget(removeButton);
 
-    // Initialize the table
+    // Initialize the table. Note that all rows have the same fixed height and
+    // the columns aren't sized to their contents, which lets the view lay out
+    // and paint only the rows that are actually visible.
+    m_proxy->setSourceModel(m_model);
+    m_table->setModel(m_proxy);
     m_table->horizontalHeader()->setHighlightSections(false);
+    m_table->horizontalHeader()->setStretchLastSection(true);
+    m_table->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    m_table->verticalHeader()->setDefaultSectionSize(m_model->getThumbnailSize() + 4);
+    m_table->setIconSize(QSize(m_model->getThumbnailSize(), m_model->getThumbnailSize()));
+    m_table->setColumnWidth(0, 2 * m_model->getThumbnailSize() + 150);
     m_table->setAutoScroll(false);
     m_table->setEditTriggers(QAbstractItemView::NoEditTriggers);
     m_table->setHorizontalScrollMode(QAbstractItemView::ScrollPerPixel);
+    m_table->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
     m_table->setSelectionBehavior(QAbstractItemView::SelectRows);
     m_table->setSelectionMode(QAbstractItemView::SingleSelection);
     m_table->setSortingEnabled(true);
-    connect(m_table, &QTableWidget::itemSelectionChanged, this, [=](){
-        const auto& selected = m_table->selectedItems();
-        if (0 < selected.size()) {
-            QString path = m_table->item(m_table->currentRow(), 1)->text();
-            emit mazeFileChanged(path);
+    m_table->sortByColumn(0, Qt::AscendingOrder);
+    connect(
+        m_table->selectionModel(), &QItemSelectionModel::selectionChanged,
+        this, [=](){
+            QString path = getSelectedPath();
+            // TODO: upforgrabs
+            // We should disable the remove button for the builtin mazes
+            removeButton->setEnabled(!path.isEmpty());
+            if (path.isEmpty()) {
+                return;
+            }
+            // Any load that's still in flight is for a maze that the user
+            // has already moved away from, so it's superseded by this one
+            m_loader->load(path);
         }
-    });
+    );
+    connect(m_loader, &MazeLoader::mazeLoaded, this, &MazeFilesTab::mazeChanged);
+    connect(m_loader, &MazeLoader::mazeLoadFailed, this, &MazeFilesTab::mazeLoadFailed);
     layout->addWidget(m_table);
 
     // Adds the entries to the table
     refresh();
 }
 
+QString MazeFilesTab::getSelectedPath() const {
+    QModelIndexList selected = m_table->selectionModel()->selectedRows();
+    if (selected.isEmpty()) {
+        return QString();
+    }
+    return m_model->getPath(m_proxy->mapToSource(selected.first()).row());
+}
+
 void MazeFilesTab::import() {
     QStringList suffixes;
     for (const QString& suffix : MAZE_FILE_TYPE_TO_SUFFIX()) {
@@ -80,28 +108,18 @@ void MazeFilesTab::import() {
 }
 
 void MazeFilesTab::remove() {
-    const auto& selected = m_table->selectedItems();
-    ASSERT_LT(0, selected.size());
-    QString path = m_table->item(m_table->currentRow(), 1)->text();
+    QString path = getSelectedPath();
+    ASSERT_FA(path.isEmpty());
+    m_loader->cancel();
     SettingsMazeFiles::removeMazeFile(path);
     refresh();
 }
 
 void MazeFilesTab::refresh() {
-    m_table->clear();
-    m_table->setColumnCount(2);
-    m_table->setHorizontalHeaderLabels({"File Name", "File Path"});
     QStringList mazeFiles;
     mazeFiles += Resources::getMazes();
     mazeFiles += SettingsMazeFiles::getSettingsMazeFiles();
-    m_table->setRowCount(mazeFiles.size());
-    for (int i = 0; i < mazeFiles.size(); i += 1) {
-        QString path = mazeFiles.at(i);
-        QString name = QFileInfo(path).fileName();
-        m_table->setItem(i, 0, new QTableWidgetItem(name));
-        m_table->setItem(i, 1, new QTableWidgetItem(path));
-    }
-    m_table->resizeColumnsToContents();
+    m_model->setPaths(mazeFiles);
 }
 
 } // namespace mms
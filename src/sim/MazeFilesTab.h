@@ -1,8 +1,13 @@
 #pragma once
 
-#include <QTableWidget>
+#include <QSortFilterProxyModel>
+#include <QTableView>
 #include <QWidget>
 
+#include "Maze.h"
+#include "MazeFilesModel.h"
+#include "MazeLoader.h"
+
 namespace mms {
 
 class MazeFilesTab : public QWidget {
@@ -15,11 +20,22 @@ public:
 
 signals:
 
-    void mazeFileChanged(const QString& path);
+    // Emitted once the selected maze file has been loaded in the background;
+    // the receiver takes ownership of the maze
+    void mazeChanged(Maze* maze);
+
+    // Emitted instead if the selected maze file couldn't be loaded
+    void mazeLoadFailed(const QString& path);
 
 private:
 
-    QTableWidget* m_table;
+    MazeFilesModel* m_model;
+    QSortFilterProxyModel* m_proxy;
+    QTableView* m_table;
+    MazeLoader* m_loader;
+
+    QString getSelectedPath() const;
+
     void import();
     void remove();
     void refresh();
@@ -1,6 +1,9 @@
 #include "MazeGraphic.h"
 
+#include <QStringList>
+
 #include "Assert.h"
+#include "Param.h"
 
 namespace mms {
 
@@ -11,17 +14,18 @@ MazeGraphic::MazeGraphic(
         bool tileColorsVisible,
         bool tileFogVisible,
         bool tileTextVisible,
-        bool autopopulateTextWithDistance) {
+        bool autopopulateTextWithDistance) :
+    m_telemetryPublisher(nullptr),
+    m_wallTruthVisible(wallTruthVisible),
+    m_tileColorsVisible(tileColorsVisible),
+    m_tileFogVisible(tileFogVisible),
+    m_tileTextVisible(tileTextVisible) {
     for (int x = 0; x < maze->getWidth(); x += 1) {
         QVector<TileGraphic> column;
         for (int y = 0; y < maze->getHeight(); y += 1) {
             column.push_back(TileGraphic(
                 maze->getTile(x, y),
                 bufferInterface,
-                wallTruthVisible,
-                tileColorsVisible,
-                tileFogVisible,
-                tileTextVisible,
                 autopopulateTextWithDistance));
         }
         m_tileGraphics.push_back(column);
@@ -30,79 +34,190 @@ MazeGraphic::MazeGraphic(
     ASSERT_EQ(getHeight(), maze->getHeight());
 }
 
+void MazeGraphic::reset() {
+    for (int x = 0; x < getWidth(); x += 1) {
+        for (int y = 0; y < getHeight(); y += 1) {
+            m_tileGraphics[x][y].reset();
+        }
+    }
+    m_deltaLog.clear();
+    m_checkpoint.clear();
+}
+
+QString MazeGraphic::getDeclaredState() const {
+    QMap<int, Delta> state = getFoldedState();
+    QStringList records = {QString::number(state.size())};
+    for (const Delta& delta : state) {
+        switch (delta.kind) {
+            case DeltaKind::WALL:
+                records.append(QString("wall %1 %2 %3 %4").arg(delta.x).arg(delta.y)
+                    .arg(DIRECTION_TO_CHAR().value(delta.direction)).arg(delta.value));
+                break;
+            case DeltaKind::COLOR:
+                records.append(QString("color %1 %2 %3").arg(delta.x).arg(delta.y)
+                    .arg(delta.value));
+                break;
+            case DeltaKind::TEXT:
+                records.append(QString("text %1 %2 %3").arg(delta.x).arg(delta.y)
+                    .arg(delta.value));
+                break;
+        }
+    }
+    return records.join(" ");
+}
+
+QVector<QPair<int, int>> MazeGraphic::getTilesWithColor() const {
+    QVector<QPair<int, int>> tiles;
+    for (const Delta& delta : getFoldedState()) {
+        if (delta.kind == DeltaKind::COLOR) {
+            tiles.append({delta.x, delta.y});
+        }
+    }
+    return tiles;
+}
+
+QVector<QPair<int, int>> MazeGraphic::getTilesWithText() const {
+    QVector<QPair<int, int>> tiles;
+    for (const Delta& delta : getFoldedState()) {
+        if (delta.kind == DeltaKind::TEXT) {
+            tiles.append({delta.x, delta.y});
+        }
+    }
+    return tiles;
+}
+
 void MazeGraphic::setTileColor(int x, int y, Color color) {
     ASSERT_TR(withinMaze(x, y));
     m_tileGraphics[x][y].setColor(color);
+    appendDelta(DeltaKind::COLOR, x, y, Direction::NORTH,
+        color == STRING_TO_COLOR().value(P()->tileBaseColor())
+        ? QString() : QString(QChar(COLOR_TO_CHAR().value(color))));
+    if (m_telemetryPublisher != nullptr) {
+        m_telemetryPublisher->publishTileColor(x, y, color);
+    }
 }
 
 void MazeGraphic::declareWall(int x, int y, Direction direction, bool isWall) {
     ASSERT_TR(withinMaze(x, y));
     m_tileGraphics[x][y].declareWall(direction, isWall);
+    appendDelta(DeltaKind::WALL, x, y, direction, isWall ? "1" : "0");
+    if (m_telemetryPublisher != nullptr) {
+        m_telemetryPublisher->publishTileWall(x, y, direction, isWall);
+    }
 }
 
 void MazeGraphic::undeclareWall(int x, int y, Direction direction) {
     ASSERT_TR(withinMaze(x, y));
     m_tileGraphics[x][y].undeclareWall(direction);
+    appendDelta(DeltaKind::WALL, x, y, direction, QString());
+    if (m_telemetryPublisher != nullptr) {
+        m_telemetryPublisher->publishTileWallUndeclared(x, y, direction);
+    }
 }
 
 void MazeGraphic::setTileFogginess(int x, int y, bool foggy) {
     ASSERT_TR(withinMaze(x, y));
     m_tileGraphics[x][y].setFogginess(foggy);
+    if (m_telemetryPublisher != nullptr) {
+        m_telemetryPublisher->publishTileFog(x, y, foggy);
+    }
 }
 
 void MazeGraphic::setTileText(int x, int y, const QString& text) {
     ASSERT_TR(withinMaze(x, y));
     m_tileGraphics[x][y].setText(text);
+    appendDelta(DeltaKind::TEXT, x, y, Direction::NORTH, text);
+    if (m_telemetryPublisher != nullptr) {
+        m_telemetryPublisher->publishTileText(x, y, text);
+    }
+}
+
+void MazeGraphic::setTelemetryPublisher(TelemetryPublisher* publisher) {
+    m_telemetryPublisher = publisher;
 }
 
 void MazeGraphic::setWallTruthVisible(bool visible) {
-    for (int x = 0; x < getWidth(); x += 1) {
-        for (int y = 0; y < getHeight(); y += 1) {
-            m_tileGraphics[x][y].setWallTruthVisible(visible);
-        }
-    }
+    m_wallTruthVisible = visible;
 }
 
 void MazeGraphic::setTileColorsVisible(bool visible) {
-    for (int x = 0; x < getWidth(); x += 1) {
-        for (int y = 0; y < getHeight(); y += 1) {
-            m_tileGraphics[x][y].setTileColorsVisible(visible);
-        }
-    }
+    m_tileColorsVisible = visible;
 }
 
 void MazeGraphic::setTileFogVisible(bool visible) {
-    for (int x = 0; x < getWidth(); x += 1) {
-        for (int y = 0; y < getHeight(); y += 1) {
-            m_tileGraphics[x][y].setTileFogVisible(visible);
-        }
-    }
+    m_tileFogVisible = visible;
 }
 
 void MazeGraphic::setTileTextVisible(bool visible) {
-    for (int x = 0; x < getWidth(); x += 1) {
-        for (int y = 0; y < getHeight(); y += 1) {
-            m_tileGraphics[x][y].setTileTextVisible(visible);
-        }
-    }
+    m_tileTextVisible = visible;
+}
+
+bool MazeGraphic::getWallTruthVisible() const {
+    return m_wallTruthVisible;
+}
+
+bool MazeGraphic::getTileColorsVisible() const {
+    return m_tileColorsVisible;
+}
+
+bool MazeGraphic::getTileFogVisible() const {
+    return m_tileFogVisible;
+}
+
+bool MazeGraphic::getTileTextVisible() const {
+    return m_tileTextVisible;
 }
 
 void MazeGraphic::drawPolygons() const {
     // Fill the GRAPHIC_CPU_BUFFER
-    for (int x = 0; x < m_tileGraphics.size(); x += 1) {
-        for (int y = 0; y < m_tileGraphics.at(x).size(); y += 1) {
-            m_tileGraphics.at(x).at(y).drawPolygons();
-        }
+    for (const QPair<int, int>& tile :
+            BufferInterface::getTilesInBufferOrder({getWidth(), getHeight()})) {
+        m_tileGraphics.at(tile.first).at(tile.second).drawPolygons();
     }
 }
 
 void MazeGraphic::drawTextures() {
     // Fill the TEXTURE_CPU_BUFFER
-    for (int x = 0; x < m_tileGraphics.size(); x += 1) {
-        for (int y = 0; y < m_tileGraphics.at(x).size(); y += 1) {
-            m_tileGraphics[x][y].drawTextures();
+    for (const QPair<int, int>& tile :
+            BufferInterface::getTilesInBufferOrder({getWidth(), getHeight()})) {
+        m_tileGraphics[tile.first][tile.second].drawTextures();
+    }
+}
+
+void MazeGraphic::appendDelta(
+        DeltaKind kind, int x, int y, Direction direction, const QString& value) {
+    m_deltaLog.append({kind, x, y, direction, value});
+
+    // There can only be six deltas per tile in the checkpoint (four walls,
+    // a color, and text), so this bounds the log to about that many
+    if (6 * getWidth() * getHeight() < m_deltaLog.size()) {
+        for (const Delta& delta : m_deltaLog) {
+            foldDelta(delta, &m_checkpoint);
         }
+        m_deltaLog.clear();
+    }
+}
+
+void MazeGraphic::foldDelta(const Delta& delta, QMap<int, Delta>* state) const {
+    // Ordered by kind, then tile, then direction
+    int key = static_cast<int>(delta.kind);
+    key = key * getWidth() + delta.x;
+    key = key * getHeight() + delta.y;
+    key = key * 4 + static_cast<int>(delta.direction);
+    if (delta.value.isEmpty()) {
+        state->remove(key);
+    }
+    else {
+        state->insert(key, delta);
+    }
+}
+
+QMap<int, MazeGraphic::Delta> MazeGraphic::getFoldedState() const {
+    QMap<int, Delta> state = m_checkpoint;
+    for (const Delta& delta : m_deltaLog) {
+        foldDelta(delta, &state);
     }
+    return state;
 }
 
 int MazeGraphic::getWidth() const {
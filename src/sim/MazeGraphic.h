@@ -1,10 +1,15 @@
 #pragma once
 
+#include <QMap>
+#include <QPair>
+#include <QString>
 #include <QVector>
 
 #include "BufferInterface.h"
 #include "Color.h"
+#include "Direction.h"
 #include "Maze.h"
+#include "TelemetryPublisher.h"
 #include "TileGraphic.h"
 
 namespace mms {
@@ -28,10 +33,34 @@ public:
     void setTileFogginess(int x, int y, bool foggy);
     void setTileText(int x, int y, const QString& text);
 
+    // Restores every tile to its initial state, in place. This isn't sent to
+    // the telemetry publisher, whose subscribers are reset with each new run.
+    void reset();
+
+    // The declared walls, colors, and text since the last reset, as a single
+    // line: the number of records, followed by the records themselves, each
+    // of which is one of "wall <x> <y> <direction> <isWall>", "color <x> <y>
+    // <color>", or "text <x> <y> <text>". Cleared colors and text, and
+    // undeclared walls, are left out.
+    QString getDeclaredState() const;
+
+    // The tiles whose color or text has been set (and not cleared)
+    QVector<QPair<int, int>> getTilesWithColor() const;
+    QVector<QPair<int, int>> getTilesWithText() const;
+
+    // Mirrors all subsequent tile changes to the publisher, if not null
+    void setTelemetryPublisher(TelemetryPublisher* publisher);
+
+    // Layer visibility is applied by the shaders at draw time, so these are
+    // cheap and never touch the buffers
     void setWallTruthVisible(bool visible);
     void setTileColorsVisible(bool visible);
     void setTileFogVisible(bool visible);
     void setTileTextVisible(bool visible);
+    bool getWallTruthVisible() const;
+    bool getTileColorsVisible() const;
+    bool getTileFogVisible() const;
+    bool getTileTextVisible() const;
 
     // TODO: MACK - rename these
     // TODO: MACK - why is only one of these const?
@@ -40,7 +69,39 @@ public:
 
 private:
 
+    // A change to the declared state of a tile, where an empty value means
+    // that it was cleared (or, for walls, undeclared)
+    enum class DeltaKind {
+        WALL,
+        COLOR,
+        TEXT,
+    };
+    struct Delta {
+        DeltaKind kind;
+        int x;
+        int y;
+        Direction direction;
+        QString value;
+    };
+
+    // Every change to the declared state since the last reset is appended
+    // to the log, so that it outlives the algorithm that declared it. Once
+    // the log is long, it's folded into the checkpoint, which holds at most
+    // one delta per tile (or wall), so that long runs use bounded memory.
+    QVector<Delta> m_deltaLog;
+    QMap<int, Delta> m_checkpoint;
+    void appendDelta(DeltaKind kind, int x, int y, Direction direction, const QString& value);
+    void foldDelta(const Delta& delta, QMap<int, Delta>* state) const;
+    QMap<int, Delta> getFoldedState() const;
+
     QVector<QVector<TileGraphic>> m_tileGraphics;
+    TelemetryPublisher* m_telemetryPublisher;
+
+    // Togglable options
+    bool m_wallTruthVisible;
+    bool m_tileColorsVisible;
+    bool m_tileFogVisible;
+    bool m_tileTextVisible;
 
     int getWidth() const;
     int getHeight() const;
@@ -0,0 +1,76 @@
+#include "MazeLoader.h"
+
+#include <QRunnable>
+
+namespace mms {
+
+class MazeLoadTask : public QRunnable {
+
+public:
+
+    MazeLoadTask(MazeLoader* loader, int generation, const QString& path) :
+        m_loader(loader),
+        m_generation(generation),
+        m_path(path) {
+    }
+
+    void run() {
+        // Don't bother parsing the file if we've already been superseded
+        if (m_generation != m_loader->m_generation.load()) {
+            return;
+        }
+        Maze* maze = Maze::fromFile(m_path);
+        emit m_loader->loadFinished(m_generation, m_path, maze);
+    }
+
+private:
+
+    MazeLoader* m_loader;
+    int m_generation;
+    QString m_path;
+
+};
+
+MazeLoader::MazeLoader(QObject* parent) :
+    QObject(parent),
+    m_generation(0) {
+
+    // One load at a time is plenty, since only the latest one is kept
+    m_pool.setMaxThreadCount(1);
+
+    // Needed for passing mazes through queued connections
+    qRegisterMetaType<Maze*>("Maze*");
+
+    connect(
+        this, &MazeLoader::loadFinished,
+        this, [=](int generation, const QString& path, Maze* maze){
+            if (generation != m_generation.load()) {
+                delete maze;
+                return;
+            }
+            if (maze == nullptr) {
+                emit mazeLoadFailed(path);
+                return;
+            }
+            emit mazeLoaded(maze);
+        },
+        Qt::QueuedConnection
+    );
+}
+
+MazeLoader::~MazeLoader() {
+    cancel();
+    m_pool.waitForDone();
+}
+
+void MazeLoader::load(const QString& path) {
+    cancel();
+    m_pool.start(new MazeLoadTask(this, m_generation.load(), path));
+}
+
+void MazeLoader::cancel() {
+    m_pool.clear();
+    m_generation.fetchAndAddOrdered(1);
+}
+
+} // namespace mms
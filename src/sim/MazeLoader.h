@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QAtomicInt>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+
+#include "Maze.h"
+
+namespace mms {
+
+// Loads maze files off of the UI thread. Only the most recent request
+// matters: starting a new load (or calling cancel) supersedes any load that
+// is queued or in progress, and the result of a superseded load is dropped.
+class MazeLoader : public QObject {
+
+    Q_OBJECT
+
+public:
+
+    MazeLoader(QObject* parent = 0);
+    ~MazeLoader();
+
+    // Starts loading the maze file at path
+    void load(const QString& path);
+
+    // Abandons the current load, if any
+    void cancel();
+
+signals:
+
+    // Emitted on the loader's thread once the most recent load succeeds; the
+    // receiver takes ownership of the maze
+    void mazeLoaded(Maze* maze);
+
+    // Emitted on the loader's thread if the most recent load fails
+    void mazeLoadFailed(const QString& path);
+
+    // Used internally to hop from the worker thread back to our thread
+    void loadFinished(int generation, const QString& path, Maze* maze);
+
+private:
+
+    QThreadPool m_pool;
+
+    // Incremented for every load or cancel, so that results of older
+    // requests can be recognized and thrown away
+    QAtomicInt m_generation;
+
+    // The task that runs on the pool; defined in the source file
+    friend class MazeLoadTask;
+
+};
+
+} // namespace mms
@@ -0,0 +1,183 @@
+#include "MazeThumbnailer.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFileInfo>
+#include <QPainter>
+#include <QRunnable>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <exception>
+
+#include "Color.h"
+#include "MazeFileUtilities.h"
+#include "Param.h"
+
+namespace mms {
+
+class MazeThumbnailTask : public QRunnable {
+
+public:
+
+    MazeThumbnailTask(MazeThumbnailer* thumbnailer, const QString& path) :
+        m_thumbnailer(thumbnailer),
+        m_path(path) {
+    }
+
+    void run() {
+        emit m_thumbnailer->thumbnailReady(
+            m_path,
+            m_thumbnailer->generate(m_path));
+    }
+
+private:
+
+    MazeThumbnailer* m_thumbnailer;
+    QString m_path;
+
+};
+
+MazeThumbnailer::MazeThumbnailer(int size, QObject* parent) :
+    QObject(parent),
+    m_size(size),
+    m_nextPriority(0) {
+
+    // Look up the colors now, so that the workers don't have to touch params
+    RGB base = COLOR_TO_RGB().value(STRING_TO_COLOR().value(P()->tileBaseColor()));
+    RGB wall = COLOR_TO_RGB().value(STRING_TO_COLOR().value(P()->tileWallColor()));
+    m_baseColor = QColor::fromRgbF(base.r, base.g, base.b);
+    m_wallColor = QColor::fromRgbF(wall.r, wall.g, wall.b);
+
+    // Forget about a path once its thumbnail has been delivered; the receiver
+    // lives on this object's thread, so this is always queued
+    connect(
+        this, &MazeThumbnailer::thumbnailReady,
+        this, [=](const QString& path, const QImage& thumbnail){
+            Q_UNUSED(thumbnail);
+            m_pending.remove(path);
+        }
+    );
+}
+
+MazeThumbnailer::~MazeThumbnailer() {
+    // The tasks hold a pointer to us, so make sure they're all gone
+    m_pool.clear();
+    m_pool.waitForDone();
+}
+
+int MazeThumbnailer::getSize() const {
+    return m_size;
+}
+
+void MazeThumbnailer::request(const QString& path) {
+    if (m_pending.contains(path)) {
+        return;
+    }
+    m_pending.insert(path);
+    m_pool.start(new MazeThumbnailTask(this, path), m_nextPriority);
+    m_nextPriority += 1;
+}
+
+void MazeThumbnailer::cancelPending() {
+    m_pool.clear();
+    m_pending.clear();
+    m_nextPriority = 0;
+}
+
+QImage MazeThumbnailer::generate(const QString& path) const {
+
+    // First, try the disk cache
+    QString cachePath = getCachePath(path);
+    QImage thumbnail;
+    if (!cachePath.isEmpty() && thumbnail.load(cachePath)) {
+        return thumbnail;
+    }
+
+    // Otherwise, parse the file and rasterize the walls
+    BasicMaze maze;
+    try {
+        maze = MazeFileUtilities::load(path);
+    }
+    catch (const std::exception&) {
+        return QImage();
+    }
+    thumbnail = render(maze);
+
+    // Write the thumbnail back to the cache; failure here is harmless
+    if (!cachePath.isEmpty()) {
+        QDir().mkpath(QFileInfo(cachePath).absolutePath());
+        thumbnail.save(cachePath, "PNG");
+    }
+    return thumbnail;
+}
+
+QString MazeThumbnailer::getCachePath(const QString& path) const {
+    QString directory = QStandardPaths::writableLocation(
+        QStandardPaths::CacheLocation);
+    if (directory.isEmpty()) {
+        return QString();
+    }
+    QFileInfo info(path);
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(info.absoluteFilePath().toUtf8());
+    hash.addData(QByteArray::number(info.size()));
+    hash.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+    hash.addData(QByteArray::number(m_size));
+    hash.addData(m_baseColor.name().toUtf8());
+    hash.addData(m_wallColor.name().toUtf8());
+    return directory + "/thumbnails/" + hash.result().toHex() + ".png";
+}
+
+QImage MazeThumbnailer::render(const BasicMaze& maze) const {
+
+    QImage image(m_size, m_size, QImage::Format_RGB32);
+    image.fill(Qt::black);
+
+    int width = maze.size();
+    int height = (0 < width ? maze.at(0).size() : 0);
+    if (width == 0 || height == 0) {
+        return image;
+    }
+
+    // Keep the tiles square, and center the maze in the image
+    double tileLength = static_cast<double>(m_size) / std::max(width, height);
+    double left = (m_size - tileLength * width) / 2.0;
+    double bottom = m_size - (m_size - tileLength * height) / 2.0;
+
+    QPainter painter(&image);
+    painter.fillRect(
+        QRectF(left, bottom - tileLength * height, tileLength * width, tileLength * height),
+        m_baseColor);
+    painter.setPen(QPen(m_wallColor, std::max(1.0, tileLength / 8.0)));
+
+    // Note that the maze's y axis points up, whereas the image's points down.
+    // Each wall is shared by two tiles, so only draw the north and east walls
+    // (plus the south and west walls along the boundary).
+    for (int x = 0; x < width; x += 1) {
+        for (int y = 0; y < height; y += 1) {
+            const BasicTile& tile = maze.at(x).at(y);
+            double x0 = left + tileLength * x;
+            double x1 = x0 + tileLength;
+            double y0 = bottom - tileLength * y;
+            double y1 = y0 - tileLength;
+            if (tile.value(Direction::NORTH)) {
+                painter.drawLine(QPointF(x0, y1), QPointF(x1, y1));
+            }
+            if (tile.value(Direction::EAST)) {
+                painter.drawLine(QPointF(x1, y0), QPointF(x1, y1));
+            }
+            if (y == 0 && tile.value(Direction::SOUTH)) {
+                painter.drawLine(QPointF(x0, y0), QPointF(x1, y0));
+            }
+            if (x == 0 && tile.value(Direction::WEST)) {
+                painter.drawLine(QPointF(x0, y0), QPointF(x0, y1));
+            }
+        }
+    }
+
+    return image;
+}
+
+} // namespace mms
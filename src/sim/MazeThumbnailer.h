@@ -0,0 +1,63 @@
+#pragma once
+
+#include <QColor>
+#include <QImage>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QThreadPool>
+
+#include "BasicMaze.h"
+
+namespace mms {
+
+// Rasterizes small previews of maze files on a background thread pool.
+// Thumbnails are drawn straight from the parsed walls (no OpenGL) and are
+// cached on disk, keyed by the file's path, size, and modification time.
+class MazeThumbnailer : public QObject {
+
+    Q_OBJECT
+
+public:
+
+    MazeThumbnailer(int size, QObject* parent = 0);
+    ~MazeThumbnailer();
+
+    // The width and height, in pixels, of each thumbnail
+    int getSize() const;
+
+    // Starts generating the thumbnail for path, unless it's already in the
+    // works. Newer requests are serviced first, so that the rows currently on
+    // screen don't wait behind rows that were scrolled past.
+    void request(const QString& path);
+
+    // Drops all requests that haven't started yet
+    void cancelPending();
+
+signals:
+
+    // Emitted, possibly from a worker thread, once a thumbnail is ready; the
+    // image is null if the maze file couldn't be read
+    void thumbnailReady(const QString& path, const QImage& thumbnail);
+
+private:
+
+    int m_size;
+    QColor m_baseColor;
+    QColor m_wallColor;
+
+    QThreadPool m_pool;
+    QSet<QString> m_pending;
+    int m_nextPriority;
+
+    // Loads the thumbnail from the disk cache, or renders and caches it
+    QImage generate(const QString& path) const;
+    QString getCachePath(const QString& path) const;
+    QImage render(const BasicMaze& maze) const;
+
+    // The task that runs on the pool; defined in the source file
+    friend class MazeThumbnailTask;
+
+};
+
+} // namespace mms
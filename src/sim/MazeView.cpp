@@ -6,6 +6,9 @@
 
 namespace mms {
 
+const int MazeView::DEFAULT_TEXT_ROWS = 2;
+const int MazeView::DEFAULT_TEXT_COLS = 4;
+
 MazeView::MazeView(
         const Maze* maze,
         bool wallTruthVisible,
@@ -13,6 +16,8 @@ MazeView::MazeView(
         bool tileFogVisible,
         bool tileTextVisible,
         bool autopopulateTextWithDistance) :
+        m_chunks(BufferInterface::getChunks(
+            {maze->getWidth(), maze->getHeight()})),
         m_bufferInterface(
             {maze->getWidth(), maze->getHeight()},
             &m_graphicCpuBuffer,
@@ -27,7 +32,7 @@ MazeView::MazeView(
             autopopulateTextWithDistance) {
 
     // Establish the coordinates for the tile text characters
-    initText(2, 4);
+    initText(DEFAULT_TEXT_ROWS, DEFAULT_TEXT_COLS);
 
     // Populate the data vectors with wall polygons and tile distance text.
     m_mazeGraphic.drawPolygons();
@@ -38,20 +43,37 @@ MazeGraphic* MazeView::getMazeGraphic() {
     return &m_mazeGraphic;
 }
 
+const MazeGraphic* MazeView::getMazeGraphic() const {
+    return &m_mazeGraphic;
+}
+
 void MazeView::initTileGraphicText(int numRows, int numCols) {
     initText(numRows, numCols);
 }
 
-const QVector<TriangleGraphic>* MazeView::getGraphicCpuBuffer() const {
+void MazeView::reset() {
+    m_mazeGraphic.reset();
+    if (m_textRowsAndCols != QPair<int, int>(DEFAULT_TEXT_ROWS, DEFAULT_TEXT_COLS)) {
+        initText(DEFAULT_TEXT_ROWS, DEFAULT_TEXT_COLS);
+    }
+}
+
+RenderBuffer<TriangleGraphic>* MazeView::getGraphicCpuBuffer() {
     return &m_graphicCpuBuffer;
 }
 
-const QVector<TriangleTexture>* MazeView::getTextureCpuBuffer() const {
+RenderBuffer<TriangleTexture>* MazeView::getTextureCpuBuffer() {
     return &m_textureCpuBuffer;
 }
 
+const QVector<MazeChunk>& MazeView::getChunks() const {
+    return m_chunks;
+}
+
 void MazeView::initText(int numRows, int numCols) {
 
+    m_textRowsAndCols = {numRows, numCols};
+
     // Initialze the tile text in the buffer class,
     // do caching for speed improvement
     m_bufferInterface.initTileGraphicText(
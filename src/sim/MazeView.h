@@ -1,10 +1,13 @@
 #pragma once
 
+#include <QPair>
 #include <QVector>
 
 #include "BufferInterface.h"
 #include "Maze.h"
+#include "MazeChunk.h"
 #include "MazeGraphic.h"
+#include "RenderBuffer.h"
 #include "TriangleGraphic.h"
 #include "TriangleTexture.h"
 
@@ -23,15 +26,31 @@ public:
         bool autopopulateTextWithDistance);
 
     MazeGraphic* getMazeGraphic();
+    const MazeGraphic* getMazeGraphic() const;
     void initTileGraphicText(int numRows, int numCols);
-    const QVector<TriangleGraphic>* getGraphicCpuBuffer() const;
-    const QVector<TriangleTexture>* getTextureCpuBuffer() const;
+
+    // Restores the view to how it was when it was created (except for the
+    // visibility of each layer), reusing the existing buffers
+    void reset();
+
+    // The map reads the buffers, and takes their dirty ranges when it
+    // uploads them, which is why these aren't const
+    RenderBuffer<TriangleGraphic>* getGraphicCpuBuffer();
+    RenderBuffer<TriangleTexture>* getTextureCpuBuffer();
+    const QVector<MazeChunk>& getChunks() const;
 
 private:
 
+    // The tile text dimensions, unless the algorithm changes them
+    static const int DEFAULT_TEXT_ROWS;
+    static const int DEFAULT_TEXT_COLS;
+
     // These vectors contain the triangles that will actually be drawn
-    QVector<TriangleGraphic> m_graphicCpuBuffer;
-    QVector<TriangleTexture> m_textureCpuBuffer;
+    RenderBuffer<TriangleGraphic> m_graphicCpuBuffer;
+    RenderBuffer<TriangleTexture> m_textureCpuBuffer;
+
+    // The blocks of tiles in the above vectors, used for culling
+    QVector<MazeChunk> m_chunks;
 
     // The buffer interface provides abstractions which the MazeGraphic
     // uses to populate the vector of TriangleGraphic objects
@@ -41,6 +60,9 @@ private:
     // it provides a high-level API for modifying their contents
     MazeGraphic m_mazeGraphic;
 
+    // The current tile text dimensions
+    QPair<int, int> m_textRowsAndCols;
+
     // Helper method for initializing TileGraphic text
     void initText(int numRows, int numCols);
 
@@ -2,7 +2,11 @@
 
 #include <QPair>
 
+#include <algorithm>
+#include <limits>
+
 #include "Assert.h"
+#include "CollisionUtilities.h"
 #include "GeometryUtilities.h"
 #include "Logging.h"
 #include "Param.h"
@@ -13,33 +17,152 @@
 namespace mms {
 
 Model::Model() :
+    m_dt(P()->simTimeStep()),
     m_shutdownRequested(false),
     m_maze(nullptr),
     m_mouse(nullptr),
     m_stats(nullptr),
     m_paused(false),
-    m_simSpeed(1.0) {
+    m_simSpeed(1.0),
+    m_hasCompletionDeadline(false),
+    m_collisionDetectionEnabled(false) {
     ASSERT_RUNS_JUST_ONCE();
 }
 
 void Model::start() {
 
+    if (P()->realTimeMode()) {
+        startRealTime();
+        return;
+    }
+
     double prev = SimUtilities::getHighResTimestamp();
     double acc = 0.0;
     while (!m_shutdownRequested) {
         double now = SimUtilities::getHighResTimestamp();
         acc += (now - prev) * m_simSpeed;
         prev = now;
-        while (acc >= DT) {
-            update(DT);
-            acc -= DT;
-            // TODO: MACK - check for collisions ...
-            // std::thread collisionDetector(&Model::checkCollision, this);
+        while (acc >= m_dt) {
+            update(m_dt);
+            acc -= m_dt;
         }
-        SimUtilities::sleep(Duration::Seconds(DT / 2.0));
+        SimUtilities::sleep(Duration::Seconds(m_dt / 2.0));
     };
 }
 
+void Model::startRealTime() {
+
+    CatchUpPolicy catchUpPolicy =
+        STRING_TO_CATCH_UP_POLICY().value(P()->catchUpPolicy());
+    bool pinned = (
+        0 <= P()->realTimeCpu() &&
+        SimUtilities::pinCurrentThread(P()->realTimeCpu())
+    );
+    bool fifo = SimUtilities::setCurrentThreadRealTimePriority(
+        P()->realTimePriority());
+    qInfo().noquote().nospace()
+        << "Running the model in real-time mode ("
+        << (pinned ? QString("pinned to CPU %1").arg(P()->realTimeCpu()) : "not pinned")
+        << ", " << (fifo ? "SCHED_FIFO" : "default scheduling")
+        << ", catch-up policy " << catchUpPolicy << ")";
+
+    m_mutex.lock();
+    m_schedulingStats = SchedulingStats();
+    m_schedulingStats.realTime = true;
+    m_schedulingStats.catchUpPolicy = catchUpPolicy;
+    m_schedulingStats.pinned = pinned;
+    m_schedulingStats.fifo = fifo;
+    m_mutex.unlock();
+
+    double deadline = SimUtilities::getMonotonicTimestamp();
+    while (!m_shutdownRequested) {
+
+        // With a sim speed of zero, there's no schedule to keep
+        double simSpeed = m_simSpeed;
+        if (simSpeed <= 0.0) {
+            SimUtilities::sleep(Duration::Seconds(m_dt));
+            deadline = SimUtilities::getMonotonicTimestamp();
+            continue;
+        }
+
+        // Each tick has a deadline in real time, and a deadline is missed
+        // once we're late by a whole tick
+        double period = m_dt / simSpeed;
+        deadline += period;
+        SimUtilities::sleepUntil(deadline);
+        double now = SimUtilities::getMonotonicTimestamp();
+        double lateness = std::max(0.0, now - deadline);
+        qint64 missed = static_cast<qint64>(lateness / period);
+
+        int ticks = 1;
+        if (0 < missed) {
+            switch (catchUpPolicy) {
+                case CatchUpPolicy::BURST:
+                    ticks += missed;
+                    deadline += missed * period;
+                    break;
+                case CatchUpPolicy::SKIP:
+                    deadline += missed * period;
+                    break;
+                case CatchUpPolicy::SLOW_DOWN:
+                    deadline = now;
+                    break;
+            }
+        }
+        for (int i = 0; i < ticks; i += 1) {
+            update(m_dt);
+        }
+
+        m_mutex.lock();
+        double latenessUs = lateness * 1000000.0;
+        m_schedulingStats.wakeups += 1;
+        m_schedulingStats.missedDeadlines += missed;
+        if (0 < missed) {
+            switch (catchUpPolicy) {
+                case CatchUpPolicy::BURST:
+                    m_schedulingStats.burstTicks += missed;
+                    break;
+                case CatchUpPolicy::SKIP:
+                    m_schedulingStats.skippedTicks += missed;
+                    break;
+                case CatchUpPolicy::SLOW_DOWN:
+                    m_schedulingStats.rescheduled += 1;
+                    break;
+            }
+        }
+        m_schedulingStats.maxLatenessUs =
+            std::max(m_schedulingStats.maxLatenessUs, latenessUs);
+        m_schedulingStats.sumLatenessUs += latenessUs;
+        m_schedulingStats.sumSquaredLatenessUs += latenessUs * latenessUs;
+        m_mutex.unlock();
+    }
+}
+
+void Model::logSchedulingStats(const SchedulingStats& stats) const {
+    QString catchUp;
+    switch (stats.catchUpPolicy) {
+        case CatchUpPolicy::BURST:
+            catchUp = QString("%1 ticks run in bursts").arg(stats.burstTicks);
+            break;
+        case CatchUpPolicy::SKIP:
+            catchUp = QString("%1 ticks skipped").arg(stats.skippedTicks);
+            break;
+        case CatchUpPolicy::SLOW_DOWN:
+            catchUp = QString("rescheduled %1 times").arg(stats.rescheduled);
+            break;
+    }
+    qInfo().noquote() << QString(
+        "Real-time scheduling: %1 wakeups, %2 missed deadlines (%3, %4); "
+        "lateness mean %5 us, max %6 us, jitter %7 us"
+    ).arg(stats.wakeups)
+     .arg(stats.missedDeadlines)
+     .arg(CATCH_UP_POLICY_TO_STRING().value(stats.catchUpPolicy))
+     .arg(catchUp)
+     .arg(stats.meanLatenessUs(), 0, 'f', 1)
+     .arg(stats.maxLatenessUs, 0, 'f', 1)
+     .arg(stats.jitterUs(), 0, 'f', 1);
+}
+
 void Model::shutdown() {
     m_shutdownRequested = true;
 }
@@ -58,11 +181,53 @@ void Model::update(double dt) {
     // Calculate the amount of sim time that should pass during this iteration
     Duration elapsedSimTimeForThisIteration = Duration::Seconds(dt);
 
+    // If a deadline falls within this iteration, advance to exactly the
+    // deadline, run whatever is waiting on it (e.g., finish a movement), and
+    // then advance the rest of the way; if there are several, they're
+    // handled in order
+    while (true) {
+        Duration now = SimTime::get()->elapsedSimTime();
+        Duration end = now + elapsedSimTimeForThisIteration;
+        bool completionDue = (
+            m_hasCompletionDeadline &&
+            now < m_completionDeadline &&
+            m_completionDeadline < end
+        );
+        bool alarmDue = (
+            m_alarmAction &&
+            now < m_alarmDeadline &&
+            m_alarmDeadline < end
+        );
+        if (!completionDue && !alarmDue) {
+            break;
+        }
+        bool completionFirst = (
+            completionDue &&
+            !(alarmDue && m_alarmDeadline < m_completionDeadline)
+        );
+        Duration untilDeadline =
+            (completionFirst ? m_completionDeadline : m_alarmDeadline) - now;
+        SimTime::get()->incrementElapsedSimTime(untilDeadline);
+        updateMouse(untilDeadline);
+        if (completionFirst) {
+            runCompletion();
+        }
+        else {
+            runAlarm();
+        }
+        elapsedSimTimeForThisIteration =
+            elapsedSimTimeForThisIteration - untilDeadline;
+    }
+
     // Update the sim time
     SimTime::get()->incrementElapsedSimTime(elapsedSimTimeForThisIteration);
 
     // Update the position of the mouse
-    m_mouse->update(elapsedSimTimeForThisIteration);
+    updateMouse(elapsedSimTimeForThisIteration);
+
+    // Record the sensor, encoder, and gyro values, and the path
+    sample();
+    trace();
 
     // Retrieve the current discretized location of the mouse
     QPair<int, int> location = m_mouse->getCurrentDiscretizedTranslation();
@@ -72,10 +237,20 @@ void Model::update(double dt) {
     // continue here to make sure that we join with the other thread.
     if (!m_maze->withinMaze(location.first, location.second)) {
         m_mouse->setCrashed();
+        publishRunStats();
+
+        // Whatever's waiting on this tick (e.g., a delay that ends exactly
+        // at the end of it) still has to finish, or the algorithm would
+        // never get its response
+        checkCompletion();
+        checkAlarm();
         m_mutex.unlock();
         return;
     }
 
+    // Record how close the mouse is to the walls
+    measureClearance(location);
+
     // Retrieve the tile at current location
     const Tile* tileAtLocation = m_maze->getTile(location.first, location.second);
 
@@ -111,14 +286,26 @@ void Model::update(double dt) {
         }
     }
 
+    publishRunStats();
+
+    // Finish the movement that's in progress, if it's done
+    checkCompletion();
+    checkAlarm();
+
     // Release the mutex
     m_mutex.unlock();
 }
 
 void Model::setMaze(const Maze* maze) {
     m_mutex.lock();
+    m_completionCondition = nullptr;
+    m_completionAction = nullptr;
+    m_hasCompletionDeadline = false;
+    m_alarmAction = nullptr;
+    m_collisionDetectionEnabled = false;
     delete m_stats;
     m_stats = nullptr;
+    m_runStats = RunStats();
     m_mouse = nullptr;
     m_maze = maze;
     m_mutex.unlock();
@@ -131,7 +318,44 @@ void Model::setMouse(Mouse* mouse) {
     ASSERT_TR(m_stats == nullptr);
     m_mouse = mouse;
     m_stats = new MouseStats();
+    m_collisionDetectionEnabled = false;
     SimTime::get()->reset();
+    publishRunStats();
+
+    // Keep the configuration, but start counting from scratch
+    SchedulingStats schedulingStats;
+    schedulingStats.realTime = m_schedulingStats.realTime;
+    schedulingStats.catchUpPolicy = m_schedulingStats.catchUpPolicy;
+    schedulingStats.pinned = m_schedulingStats.pinned;
+    schedulingStats.fifo = m_schedulingStats.fifo;
+    m_schedulingStats = schedulingStats;
+
+    // Start new histories, leaving the old ones to any readers that still
+    // hold them
+    qint64 capacity = static_cast<qint64>(P()->sampleHistorySeconds() / m_dt);
+    m_sensorNames = m_mouse->getSensorNames();
+    m_wheelNames = m_mouse->getWheelNames();
+    m_sampleBuffers.clear();
+    for (const QString& name : m_sensorNames) {
+        m_sampleBuffers.append(QSharedPointer<SampleRingBuffer>(
+            new SampleRingBuffer(QString("Sensor: %1").arg(name), capacity)));
+    }
+    for (const QString& name : m_wheelNames) {
+        m_sampleBuffers.append(QSharedPointer<SampleRingBuffer>(
+            new SampleRingBuffer(QString("Encoder: %1").arg(name), capacity)));
+    }
+    m_sampleBuffers.append(QSharedPointer<SampleRingBuffer>(
+        new SampleRingBuffer("Gyro (deg/s)", capacity)));
+    m_trailBuffer = QSharedPointer<TrailRingBuffer>(
+        new TrailRingBuffer(P()->trailLength()));
+    m_trailTranslation = m_mouse->getCurrentTranslation();
+    m_trailTime = SimTime::get()->elapsedSimTime();
+    m_trailBuffer->push({
+        static_cast<float>(m_trailTranslation.getX().getMeters()),
+        static_cast<float>(m_trailTranslation.getY().getMeters()),
+        0.0f,
+    });
+
     m_mutex.unlock();
 }
 
@@ -143,10 +367,21 @@ void Model::removeMouse() {
     ASSERT_FA(m_maze == nullptr);
     ASSERT_FA(m_mouse == nullptr);
     ASSERT_FA(m_stats == nullptr);
+    m_completionCondition = nullptr;
+    m_completionAction = nullptr;
+    m_hasCompletionDeadline = false;
+    m_alarmAction = nullptr;
+    m_collisionDetectionEnabled = false;
     delete m_stats;
     m_stats = nullptr;
     m_mouse = nullptr;
+    SchedulingStats schedulingStats = m_schedulingStats;
     m_mutex.unlock();
+
+    // Report how well the run kept to its schedule
+    if (schedulingStats.realTime) {
+        logSchedulingStats(schedulingStats);
+    }
 }
 
 MouseStats Model::getMouseStats() const {
@@ -159,6 +394,41 @@ MouseStats Model::getMouseStats() const {
     return stats;
 }
 
+RunStats Model::getRunStats() const {
+    m_mutex.lock();
+    RunStats stats = m_runStats;
+    m_mutex.unlock();
+    return stats;
+}
+
+SchedulingStats Model::getSchedulingStats() const {
+    m_mutex.lock();
+    SchedulingStats stats = m_schedulingStats;
+    m_mutex.unlock();
+    return stats;
+}
+
+QVector<QSharedPointer<const SampleRingBuffer>> Model::getSampleBuffers() const {
+    m_mutex.lock();
+    QVector<QSharedPointer<const SampleRingBuffer>> buffers;
+    for (const QSharedPointer<SampleRingBuffer>& buffer : m_sampleBuffers) {
+        buffers.append(buffer);
+    }
+    m_mutex.unlock();
+    return buffers;
+}
+
+double Model::getSecondsPerSample() {
+    return P()->simTimeStep();
+}
+
+QSharedPointer<const TrailRingBuffer> Model::getTrailBuffer() const {
+    m_mutex.lock();
+    QSharedPointer<const TrailRingBuffer> buffer = m_trailBuffer;
+    m_mutex.unlock();
+    return buffer;
+}
+
 void Model::setPaused(bool paused) {
     m_paused = paused;
 }
@@ -167,66 +437,229 @@ void Model::setSimSpeed(double factor) {
     m_simSpeed = factor;
 }
 
-void Model::checkCollision() {
+void Model::setCollisionDetectionEnabled(bool enabled) {
+    m_mutex.lock();
+    m_collisionDetectionEnabled = enabled;
+    m_mutex.unlock();
+}
 
-    // If collision detectino isn't enabled, let this thread exit
-    // if (!P()->collisionDetectionEnabled()) {
-    //     return;
-    // }
+void Model::setCompletion(
+        std::function<bool()> condition,
+        std::function<void()> action) {
+    m_mutex.lock();
+    ASSERT_FA(m_completionCondition);
+    m_completionCondition = condition;
+    m_completionAction = action;
+    m_mutex.unlock();
+}
 
-    // TODO: MACK
-    // If the interface type is DISCRETE, let this thread exit
-    if (true) {
+void Model::setCompletionAt(
+        const Duration& deadline,
+        std::function<void()> action) {
+    m_mutex.lock();
+    ASSERT_FA(m_completionCondition);
+    m_completionCondition = [=](){
+        return !(SimTime::get()->elapsedSimTime() < deadline);
+    };
+    m_completionAction = action;
+    m_hasCompletionDeadline = true;
+    m_completionDeadline = deadline;
+    m_mutex.unlock();
+}
+
+void Model::chainCompletion(
+        std::function<bool()> condition,
+        std::function<void()> action) {
+
+    // NOTE: This runs with the mutex held
+
+    ASSERT_FA(m_completionCondition);
+    m_completionCondition = condition;
+    m_completionAction = action;
+}
+
+void Model::clearCompletion() {
+    m_mutex.lock();
+    m_completionCondition = nullptr;
+    m_completionAction = nullptr;
+    m_hasCompletionDeadline = false;
+    m_mutex.unlock();
+}
+
+void Model::setAlarm(
+        const Duration& deadline,
+        std::function<void()> action) {
+    m_mutex.lock();
+    ASSERT_FA(m_alarmAction);
+    m_alarmAction = action;
+    m_alarmDeadline = deadline;
+    m_mutex.unlock();
+}
+
+void Model::clearAlarm() {
+    m_mutex.lock();
+    m_alarmAction = nullptr;
+    m_mutex.unlock();
+}
+
+void Model::checkCompletion() {
+
+    // NOTE: This runs on every tick, with the mutex held
+
+    if (!m_completionCondition || !m_completionCondition()) {
         return;
     }
+    runCompletion();
+}
 
-    /*
-    while (true) {
+void Model::runCompletion() {
 
-        // In order to ensure we're sleeping the correct amount of time, we time
-        // the collision detection operation and take it into account when we sleep.
-        double start(mms::SimUtilities::getHighResTimestamp());
-
-        // We declare these statically since we only need one copy of them
-        static const Meters halfWallWidth = Meters(P()->wallWidth() / 2.0);
-        static const Meters tileLength = Meters(P()->wallLength() + P()->wallWidth());
-
-        // Retrieve the current collision polygon
-        QVector<Cartesian> currentCollisionPolygonVertices =
-            m_mouse->getCurrentCollisionPolygon(
-                m_mouse->getCurrentTranslation(), m_mouse->getCurrentRotation()).getVertices();
-
-        // Check for collisions
-        for (int i = 0; i < currentCollisionPolygonVertices.size(); i += 1) {
-            int j = (i + 1) % currentCollisionPolygonVertices.size();
-            Cartesian v1 = currentCollisionPolygonVertices.at(i);
-            Cartesian v2 = currentCollisionPolygonVertices.at(j);
-            // If a wall has come between the two vertices, then we have a collision
-            if (GeometryUtilities::castRay(v1, v2, *m_maze, halfWallWidth, tileLength) != v2) {
-                S()->setCrashed();
-                return; // If we've crashed, let this thread exit
-            }
-        }
+    // NOTE: This runs with the mutex held
 
-        // Get the duration of the collision detection, in seconds
-        double end(mms::SimUtilities::getHighResTimestamp());
-        double duration = end - start;
-
-        // Notify the use of a late collision detection
-        // TODO: MACK - make some variables for these long expressions
-        if (P()->printLateCollisionDetections() && duration > 1.0 / P()->collisionDetectionRate()) {
-            qWarning().noquote().nospace()
-                << "A collision detection was late by "
-                << (duration - 1.0/P()->collisionDetectionRate())
-                << " seconds, which is "
-                << (duration - 1.0/P()->collisionDetectionRate())/(1.0/P()->collisionDetectionRate()) * 100
-                << " percent late.";
-        }
+    std::function<void()> action = m_completionAction;
+    m_completionCondition = nullptr;
+    m_completionAction = nullptr;
+    m_hasCompletionDeadline = false;
+    if (action) {
+        action();
+    }
+}
 
-        // Sleep the appropriate amout of time, based on the collision detection duration
-        mms::SimUtilities::sleep(mms::Seconds(std::max(0.0, 1.0 / P()->collisionDetectionRate() - duration)));
+void Model::checkAlarm() {
+
+    // NOTE: This runs on every tick, with the mutex held
+
+    if (!m_alarmAction || SimTime::get()->elapsedSimTime() < m_alarmDeadline) {
+        return;
+    }
+    runAlarm();
+}
+
+void Model::runAlarm() {
+
+    // NOTE: This runs with the mutex held
+
+    std::function<void()> action = m_alarmAction;
+    m_alarmAction = nullptr;
+    action();
+}
+
+void Model::publishRunStats() {
+
+    // NOTE: This runs on every tick, with the mutex held
+
+    m_runStats.hasMouse = true;
+    m_runStats.tilesTraversed = m_stats->traversedTileLocations.size();
+    m_runStats.closestDistanceToCenter = m_stats->closestDistanceToCenter;
+    m_runStats.translation = m_mouse->getCurrentTranslation();
+    m_runStats.rotation = m_mouse->getCurrentRotation();
+    m_runStats.tile = m_mouse->getCurrentDiscretizedTranslation();
+    m_runStats.direction = m_mouse->getCurrentDiscretizedRotation();
+    m_runStats.elapsedSimTime = SimTime::get()->elapsedSimTime();
+    m_runStats.timeOfOriginDeparture = m_stats->timeOfOriginDeparture;
+    m_runStats.bestTimeToCenter = m_stats->bestTimeToCenter;
+    m_runStats.crashed = m_mouse->didCrash();
+    m_runStats.hasClearance = (0 < m_stats->clearance.getCount());
+    m_runStats.minClearance = m_stats->clearance.getMin();
+}
+
+void Model::sample() {
+
+    // NOTE: This runs on every tick, with the mutex held
+
+    int i = 0;
+    for (const QString& name : m_sensorNames) {
+        m_sampleBuffers.at(i)->push(m_mouse->readSensor(name));
+        i += 1;
+    }
+    for (const QString& name : m_wheelNames) {
+        m_sampleBuffers.at(i)->push(m_mouse->readWheelAbsoluteEncoder(name));
+        i += 1;
+    }
+    m_sampleBuffers.at(i)->push(m_mouse->readGyro().getDegreesPerSecond());
+}
+
+void Model::trace() {
+
+    // NOTE: This runs on every tick, with the mutex held, but only pushes a
+    // point once the mouse has moved far enough, so idle time is free
+
+    Coordinate translation = m_mouse->getCurrentTranslation();
+    double distance = (translation - m_trailTranslation).getRho().getMeters();
+    if (distance < P()->trailPointSpacing()) {
+        return;
+    }
+    Duration now = SimTime::get()->elapsedSimTime();
+    double seconds = (now - m_trailTime).getSeconds();
+    m_trailBuffer->push({
+        static_cast<float>(translation.getX().getMeters()),
+        static_cast<float>(translation.getY().getMeters()),
+        static_cast<float>(0.0 < seconds ? distance / seconds : 0.0),
+    });
+    m_trailTranslation = translation;
+    m_trailTime = now;
+}
+
+void Model::measureClearance(QPair<int, int> location) {
+
+    // NOTE: This runs on every tick, with the mutex held. It only looks up
+    // the vertices of the polygon, which is cheap, but means that a post
+    // that pokes in between two vertices isn't noticed.
+
+    // Once the mouse has crashed, it stays pressed against the wall, which
+    // would only skew the percentiles. The run stats are still those of the
+    // previous tick, so the tick during which it crashed still counts.
+    if (m_runStats.crashed) {
+        return;
+    }
+
+    const ClearanceField& field = m_maze->getClearanceField();
+    Polygon collisionPolygon = m_mouse->getCurrentCollisionPolygon(
+        m_mouse->getCurrentTranslation(),
+        m_mouse->getCurrentRotation());
+    double clearance = std::numeric_limits<double>::max();
+    for (const Coordinate& vertex : collisionPolygon.getVertices()) {
+        clearance = std::min(clearance, field.getClearance(
+            vertex.getX().getMeters(),
+            vertex.getY().getMeters()));
+    }
+    m_stats->clearance.add(
+        clearance,
+        location,
+        SimTime::get()->elapsedSimTime());
+    m_runStats.clearance = clearance;
+}
+
+void Model::updateMouse(const Duration& elapsed) {
+
+    if (!m_collisionDetectionEnabled || m_mouse->didCrash()) {
+        m_mouse->update(elapsed);
+        return;
+    }
+
+    Coordinate startTranslation = m_mouse->getCurrentTranslation();
+    Angle startRotation = m_mouse->getCurrentRotation();
+    Polygon collisionPolygon = m_mouse->getCurrentCollisionPolygon(
+        startTranslation,
+        startRotation);
+    m_mouse->update(elapsed);
+    Coordinate endTranslation = m_mouse->getCurrentTranslation();
+    Angle endRotation = m_mouse->getCurrentRotation();
+
+    double timeOfImpact = CollisionUtilities::getTimeOfImpact(
+        collisionPolygon,
+        startTranslation,
+        startRotation,
+        endTranslation,
+        endRotation,
+        *m_maze);
+    if (timeOfImpact < 0.0) {
+        return;
     }
-    */
+    m_mouse->teleport(
+        startTranslation + (endTranslation - startTranslation) * timeOfImpact,
+        startRotation + (endRotation - startRotation) * timeOfImpact);
+    m_mouse->setCrashed();
 }
 
 } // namespace mms
@@ -2,10 +2,21 @@
 
 #include <QObject>
 #include <QMutex>
+#include <QSharedPointer>
+#include <QStringList>
+#include <QVector>
+
+#include <functional>
 
 #include "Maze.h"
 #include "Mouse.h"
 #include "MouseStats.h"
+#include "RunStats.h"
+#include "SampleRingBuffer.h"
+#include "SchedulingStats.h"
+#include "TrailRingBuffer.h"
+#include "units/Coordinate.h"
+#include "units/Duration.h"
 
 namespace mms {
 
@@ -25,19 +36,80 @@ public:
 
     MouseStats getMouseStats() const;
 
+    // Cheap to call often, e.g., for showing live stats
+    RunStats getRunStats() const;
+
+    // How well the model thread has kept to its schedule during the current
+    // (or most recent) run; only tracked in real-time mode
+    SchedulingStats getSchedulingStats() const;
+
+    // Returns the per-tick histories of the sensors, encoders, and gyro of
+    // the current (or most recent) mouse; one sample is taken every tick
+    QVector<QSharedPointer<const SampleRingBuffer>> getSampleBuffers() const;
+    static double getSecondsPerSample();
+
+    // Returns the path of the current (or most recent) mouse, with a point
+    // every trail-point-spacing meters
+    QSharedPointer<const TrailRingBuffer> getTrailBuffer() const;
+
     void setPaused(bool paused);
     void setSimSpeed(double factor);
 
+    // Whether or not the mouse is stopped by (and crashes into) walls and
+    // posts. This only makes sense for the continuous interface, since the
+    // discrete interface works out its own crashes, so it's off by default
+    // and reset whenever the mouse changes.
+    void setCollisionDetectionEnabled(bool enabled);
+
+    // Registers a condition that's checked after every tick, on the model
+    // thread. Once it holds, the action runs right away (still on the model
+    // thread, before the next tick) and both are dropped. There can only be
+    // one of these at a time, since only one movement can be in progress.
+    void setCompletion(
+        std::function<bool()> condition,
+        std::function<void()> action);
+
+    // Like setCompletion, where the condition is that the sim time has
+    // reached the deadline. The tick during which the deadline passes is
+    // split at it, so that the action runs at exactly that sim time.
+    void setCompletionAt(
+        const Duration& deadline,
+        std::function<void()> action);
+
+    // Like setCompletion, but only to be called from within a completion
+    // action (which already holds the mutex), so that a motion can start
+    // right as the one before it completes, without a gap in between
+    void chainCompletion(
+        std::function<bool()> condition,
+        std::function<void()> action);
+    void clearCompletion();
+
+    // Runs the action (on the model thread) once the sim time reaches the
+    // deadline, splitting the tick like setCompletionAt does. Unlike a
+    // completion, this isn't tied to a movement, so it can be set while one
+    // is in progress. There can only be one of these at a time.
+    void setAlarm(
+        const Duration& deadline,
+        std::function<void()> action);
+    void clearAlarm();
+
 signals:
 
     void newTileLocationTraversed(int x, int y);
 
 private:
 
-    // A fixed timestep (in sim time)
-    static constexpr double DT = 0.001;
+    // A fixed timestep (in sim time), from the sim-time-step param
+    const double m_dt;
     void update(double dt);
 
+    // Like start(), but sleeps until an absolute deadline for each tick,
+    // optionally on a pinned, SCHED_FIFO thread, and follows the configured
+    // catch-up policy whenever it misses a deadline
+    void startRealTime();
+    SchedulingStats m_schedulingStats;
+    void logSchedulingStats(const SchedulingStats& stats) const;
+
     mutable QMutex m_mutex;
     bool m_shutdownRequested;
 
@@ -45,10 +117,48 @@ private:
     Mouse* m_mouse;
     MouseStats* m_stats;
 
+    // Published at the end of every tick
+    RunStats m_runStats;
+    void publishRunStats();
+
+    // Sampled on every tick; the names are cached so that we don't have to
+    // look them up each time
+    QStringList m_sensorNames;
+    QStringList m_wheelNames;
+    QVector<QSharedPointer<SampleRingBuffer>> m_sampleBuffers;
+    void sample();
+
+    // Extended whenever the mouse has moved far enough from the last point
+    QSharedPointer<TrailRingBuffer> m_trailBuffer;
+    Coordinate m_trailTranslation;
+    Duration m_trailTime;
+    void trace();
+
+    // Records the clearance of the collision polygon, on every tick that
+    // the mouse is in the maze
+    void measureClearance(QPair<int, int> location);
+
     bool m_paused;
     double m_simSpeed;
 
-    void checkCollision();
+    std::function<bool()> m_completionCondition;
+    std::function<void()> m_completionAction;
+    bool m_hasCompletionDeadline;
+    Duration m_completionDeadline;
+    void checkCompletion();
+    void runCompletion();
+
+    std::function<void()> m_alarmAction;
+    Duration m_alarmDeadline;
+    void checkAlarm();
+    void runAlarm();
+
+    // Updates the mouse. With collision detection enabled, the motion over
+    // the tick is swept against the maze, so that a fast mouse (or a long
+    // tick) can't pass through a wall; if it hits anything, the mouse is
+    // put exactly at the point of contact, and crashes.
+    bool m_collisionDetectionEnabled;
+    void updateMouse(const Duration& elapsed);
 };
 
 } // namespace mms
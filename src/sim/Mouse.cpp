@@ -1,6 +1,5 @@
 #include "Mouse.h"
 
-#include <QMutableMapIterator>
 #include <QPair>
 #include <QVector>
 #include <QtMath>
@@ -31,6 +30,8 @@ Mouse::Mouse(const Maze* maze) :
     m_startingDirection = m_startedDirection;
     m_initialRotation = DIRECTION_TO_ANGLE().value(m_startingDirection);
     m_currentRotation = m_initialRotation;
+    m_snapshot.translation = m_currentTranslation;
+    m_snapshot.rotation = m_currentRotation;
 }
 
 bool Mouse::reload(const QString& mouseFile) {
@@ -90,6 +91,9 @@ bool Mouse::reload(const QString& mouseFile) {
         sensor.getInitialViewPolygon().getTriangles();
     }
 
+    // Publish the initial sensor views
+    updateSensorsAndSnapshot();
+
     // Lastly, keep track of the mouse file we just successfully loaded
     m_mouseFile = mouseFile;
 
@@ -118,9 +122,23 @@ void Mouse::reset() {
     m_crashed = false;
 }
 
+void Mouse::resetToInitialState() {
+    m_mutex.lock();
+    for (auto it = m_wheels.begin(); it != m_wheels.end(); ++it) {
+        it.value().reset();
+    }
+    m_currentGyro = AngularVelocity::RadiansPerSecond(0);
+    m_mutex.unlock();
+    m_startingDirection = m_maze->getOptimalStartingDirection();
+    reset();
+}
+
 void Mouse::teleport(const Coordinate& translation, const Angle& rotation) {
+    m_mutex.lock();
     m_currentTranslation = translation;
     m_currentRotation = rotation;
+    m_mutex.unlock();
+    updateSensorsAndSnapshot();
 }
 
 Direction Mouse::getStartedDirection() const {
@@ -135,12 +153,18 @@ const Coordinate& Mouse::getInitialTranslation() const {
     return m_initialTranslation;
 }
 
-const Coordinate& Mouse::getCurrentTranslation() const {
-    return m_currentTranslation;
+Coordinate Mouse::getCurrentTranslation() const {
+    m_mutex.lock();
+    Coordinate translation = m_currentTranslation;
+    m_mutex.unlock();
+    return translation;
 }
 
-const Angle& Mouse::getCurrentRotation() const {
-    return m_currentRotation;
+Angle Mouse::getCurrentRotation() const {
+    m_mutex.lock();
+    Angle rotation = m_currentRotation;
+    m_mutex.unlock();
+    return rotation;
 }
 
 QPair<int, int> Mouse::getCurrentDiscretizedTranslation() const {
@@ -225,23 +249,11 @@ QVector<Polygon> Mouse::getCurrentSensorPolygons(
     return polygons;
 }
 
-QVector<Polygon> Mouse::getCurrentSensorViewPolygons(
-        const Coordinate& currentTranslation,
-        const Angle& currentRotation) const {
-    QVector<Polygon> polygons;
-    for (const Sensor& sensor : m_sensors) {
-        QPair<Coordinate, Angle> translationAndRotation =
-            getCurrentSensorPositionAndDirection(
-                sensor,
-                currentTranslation,
-                currentRotation);
-        polygons.push_back(sensor.getCurrentViewPolygon(
-            translationAndRotation.first,
-            translationAndRotation.second,
-            *m_maze
-        ));
-    }
-    return polygons;
+MouseSnapshot Mouse::getCurrentSnapshot() const {
+    m_mutex.lock();
+    MouseSnapshot snapshot = m_snapshot;
+    m_mutex.unlock();
+    return snapshot;
 }
 
 void Mouse::update(const Duration& elapsed) {
@@ -264,19 +276,17 @@ void Mouse::update(const Duration& elapsed) {
         WheelEffect effect = it.value().update(elapsed);
 
         // The effect of the forward component
-        sumDx += effect.forwardEffect * getCurrentRotation().getCos();
-        sumDy += effect.forwardEffect * getCurrentRotation().getSin();
+        sumDx += effect.forwardEffect * m_currentRotation.getCos();
+        sumDy += effect.forwardEffect * m_currentRotation.getSin();
 
         // The effect of the sideways component
-        sumDx += effect.sidewaysEffect * getCurrentRotation().getSin();
-        sumDy += effect.sidewaysEffect * getCurrentRotation().getCos() * -1;
+        sumDx += effect.sidewaysEffect * m_currentRotation.getSin();
+        sumDy += effect.sidewaysEffect * m_currentRotation.getCos() * -1;
 
         // The effect of the rotation component
         sumDr += effect.turnEffect;
     }
 
-    m_mutex.unlock();
-
     Speed aveDx = sumDx / m_wheels.size();
     Speed aveDy = sumDy / m_wheels.size();
     AngularVelocity aveDr = sumDr / m_wheels.size();
@@ -285,28 +295,24 @@ void Mouse::update(const Duration& elapsed) {
     m_currentRotation += aveDr * elapsed;
     m_currentTranslation += Coordinate::Cartesian(aveDx * elapsed, aveDy * elapsed);
 
+    m_mutex.unlock();
+
     // Update all of the sensor readings
-    /* TODO: MACK
-    QMutableMapIterator<QString, Sensor> sensorIterator(m_sensors);
-    while (sensorIterator.hasNext()) {
-        auto pair = sensorIterator.next();
-        QPair<Coordinate, Angle> translationAndRotation =
-            getCurrentSensorPositionAndDirection(
-                pair.value(),
-                m_currentTranslation,
-                m_currentRotation);
-        pair.value().updateReading(
-            translationAndRotation.first,
-            translationAndRotation.second,
-            *m_maze);
-    }
-    */
+    updateSensorsAndSnapshot();
 }
 
 bool Mouse::hasWheel(const QString& name) const {
     return m_wheels.contains(name);
 }
 
+QStringList Mouse::getWheelNames() const {
+    return m_wheels.keys();
+}
+
+QStringList Mouse::getSensorNames() const {
+    return m_sensors.keys();
+}
+
 const AngularVelocity& Mouse::getWheelMaxSpeed(const QString& name) {
     ASSERT_TR(m_wheels.contains(name));
     return m_wheels[name].getMaximumSpeed();
@@ -392,11 +398,18 @@ bool Mouse::hasSensor(const QString& name) const {
 
 double Mouse::readSensor(const QString& name) const {
     ASSERT_TR(hasSensor(name));
-    return m_sensors.value(name).read();
+    // Read from the snapshot, since the sensor itself may be mid-update
+    m_mutex.lock();
+    double reading = m_snapshot.sensorReadings.value(name);
+    m_mutex.unlock();
+    return reading;
 }
 
-const AngularVelocity& Mouse::readGyro() const {
-    return m_currentGyro;
+AngularVelocity Mouse::readGyro() const {
+    m_mutex.lock();
+    AngularVelocity gyro = m_currentGyro;
+    m_mutex.unlock();
+    return gyro;
 }
 
 Polygon Mouse::getCurrentPolygon(
@@ -425,6 +438,44 @@ QPair<Coordinate, Angle> Mouse::getCurrentSensorPositionAndDirection(
     };
 }
 
+void Mouse::updateSensorsAndSnapshot() {
+
+    m_sensorMutex.lock();
+
+    m_mutex.lock();
+    Coordinate translation = m_currentTranslation;
+    Angle rotation = m_currentRotation;
+    m_mutex.unlock();
+
+    // Cast the rays outside of m_mutex, since this is the expensive part
+    QVector<QVector<Coordinate>> sensorViews;
+    sensorViews.reserve(m_sensors.size());
+    QMap<QString, double> sensorReadings;
+    QMap<QString, Sensor>::iterator it;
+    for (it = m_sensors.begin(); it != m_sensors.end(); it += 1) {
+        QPair<Coordinate, Angle> translationAndRotation =
+            getCurrentSensorPositionAndDirection(
+                it.value(),
+                translation,
+                rotation);
+        it.value().updateReading(
+            translationAndRotation.first,
+            translationAndRotation.second,
+            *m_maze);
+        sensorViews.push_back(it.value().getCurrentView());
+        sensorReadings.insert(it.key(), it.value().read());
+    }
+
+    m_mutex.lock();
+    m_snapshot.translation = translation;
+    m_snapshot.rotation = rotation;
+    m_snapshot.sensorViews.swap(sensorViews);
+    m_snapshot.sensorReadings.swap(sensorReadings);
+    m_mutex.unlock();
+
+    m_sensorMutex.unlock();
+}
+
 void Mouse::setWheelSpeedsForMovement(double fractionOfMaxSpeed, double forwardFactor, double turnFactor) {
 
     // We can think about setting the wheels speeds for particular movements as
@@ -4,6 +4,7 @@
 #include <QMutex>
 #include <QPair>
 #include <QString>
+#include <QStringList>
 #include <QVector>
 
 #include "units/AngularVelocity.h"
@@ -13,6 +14,7 @@
 #include "Direction.h"
 #include "EncoderType.h"
 #include "Maze.h"
+#include "MouseSnapshot.h"
 #include "Polygon.h"
 #include "Sensor.h"
 #include "Wheel.h"
@@ -40,6 +42,10 @@ public:
     // account the desired starting direction, as set by the algorithm)
     void reset();
 
+    // Restores the mouse to the state it was in right after reload(), so
+    // that it can be reused for another run without reloading the file
+    void resetToInitialState();
+
     // Sets the current translation and rotation of the mouse
     void teleport(const Coordinate& translation, const Angle& rotation);
 
@@ -53,8 +59,8 @@ public:
     const Coordinate& getInitialTranslation() const;
 
     // Gets the current translation and rotation of the mouse
-    const Coordinate& getCurrentTranslation() const;
-    const Angle& getCurrentRotation() const;
+    Coordinate getCurrentTranslation() const;
+    Angle getCurrentRotation() const;
 
     // Gets the current discretized translation and rotation of the mouse
     QPair<int, int> getCurrentDiscretizedTranslation() const;
@@ -86,10 +92,10 @@ public:
         const Coordinate& currentTranslation,
         const Angle& currentRotation) const;
 
-    // Retrieve the polygons corresponding to the views of the sensors
-    QVector<Polygon> getCurrentSensorViewPolygons(
-        const Coordinate& currentTranslation,
-        const Angle& currentRotation) const;
+    // Returns the pose of the mouse and the views of its sensors, as of the
+    // most recent update; the sensor rays are cast once per update, so this
+    // is cheap to call from any thread
+    MouseSnapshot getCurrentSnapshot() const;
 
     // Instruct the mouse to update its own position
     // based on how much simulation time has elapsed
@@ -98,6 +104,10 @@ public:
     // Returns whether or not the mouse has a wheel by a particular name
     bool hasWheel(const QString& name) const;
 
+    // Returns the names of all of the wheels/sensors of the mouse
+    QStringList getWheelNames() const;
+    QStringList getSensorNames() const;
+
     // Returns the magnitde of the max angular velocity of the wheel;
     // intentionally not const to avoid making copies of Wheel objects.
     const AngularVelocity& getWheelMaxSpeed(const QString& name);
@@ -131,12 +141,12 @@ public:
     // Returns whether or not the mouse has a sensor by a particular name
     bool hasSensor(const QString& name) const;
 
-    // Read a sensor, and returns a value from 0.0
-    // (completely free) to 1.0 (completely blocked)
+    // Read a sensor; for area sensors, returns a value from 0.0 (completely
+    // free) to 1.0 (completely blocked), and see SensorType for the others
     double readSensor(const QString& name) const;
 
     // Returns the value of the gyroscope
-    const AngularVelocity& readGyro() const;
+    AngularVelocity readGyro() const;
 
 private:
 
@@ -182,15 +192,23 @@ private:
     CurveTurnFactorCalculator m_curveTurnFactorCalculator;
 
     // The gyro (rate of rotation), rotation, and translation
-    // of the mouse, which change throughout execution
+    // of the mouse, which change throughout execution; guarded by m_mutex
     AngularVelocity m_currentGyro;
     Coordinate m_currentTranslation;
     Angle m_currentRotation;
 
+    // The most recently published state of the mouse, guarded by m_mutex
+    MouseSnapshot m_snapshot;
+
     // Ensures that reads/updates happen atomically,
     // mutable so we can use it in const functions
     mutable QMutex m_mutex;
 
+    // Held for the whole of updateSensorsAndSnapshot, since the mouse may be
+    // reset from another thread while the model thread is updating it, and
+    // the sensors aren't safe to update from two threads at once
+    QMutex m_sensorMutex;
+
     // Helper function for polygon retrieval based on a given mouse translation and rotation
     Polygon getCurrentPolygon(
         const Polygon& initialPolygon,
@@ -203,6 +221,10 @@ private:
         const Coordinate& currentTranslation,
         const Angle& currentRotation) const;
 
+    // Re-casts the sensor rays for the current pose and publishes the
+    // results, along with the pose, as the current snapshot
+    void updateSensorsAndSnapshot();
+
     // Sets the wheel speed for a particular movement, based on the linear combo of the two factors
     void setWheelSpeedsForMovement(double fractionOfMaxSpeed, double forwardFactor, double turnFactor);
 
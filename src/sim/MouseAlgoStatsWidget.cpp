@@ -1,7 +1,6 @@
 #include "MouseAlgoStatsWidget.h"
 
 #include <QGridLayout>
-#include <QLabel>
 
 namespace mms {
 
@@ -17,6 +16,17 @@ void MouseAlgoStatsWidget::init(QStringList keys) {
         valueHolder->setMinimumWidth(80);
         layout->addWidget(labelHolder, i, 0);
         layout->addWidget(valueHolder, i, 1);
+        m_valueHolders.append(valueHolder);
+        m_values.append(QString());
+    }
+}
+
+void MouseAlgoStatsWidget::setValues(const QStringList& values) {
+    for (int i = 0; i < values.size() && i < m_valueHolders.size(); i += 1) {
+        if (values.at(i) != m_values.at(i)) {
+            m_values[i] = values.at(i);
+            m_valueHolders.at(i)->setText(values.at(i));
+        }
     }
 }
 
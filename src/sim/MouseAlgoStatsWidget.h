@@ -1,6 +1,8 @@
 #pragma once
 
+#include <QLabel>
 #include <QStringList>
+#include <QVector>
 #include <QWidget>
 
 namespace mms {
@@ -13,6 +15,15 @@ public:
 
     void init(QStringList keys);
 
+    // One value per key; only the labels whose text changed are updated,
+    // since setting a label's text can cause a relayout
+    void setValues(const QStringList& values);
+
+private:
+
+    QVector<QLabel*> m_valueHolders;
+    QStringList m_values;
+
 };
 
 } // namespace mms
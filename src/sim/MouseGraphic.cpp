@@ -1,5 +1,6 @@
 #include "MouseGraphic.h"
 
+#include "GeometryUtilities.h"
 #include "Param.h"
 #include "SimUtilities.h"
 
@@ -13,58 +14,58 @@ Coordinate MouseGraphic::getInitialMouseTranslation() const {
     return m_mouse->getInitialTranslation();
 }
 
-QPair<Coordinate, Angle> MouseGraphic::getCurrentMousePosition() const {
-    return {
-        m_mouse->getCurrentTranslation(),
-        m_mouse->getCurrentRotation(),
-    };
+MouseSnapshot MouseGraphic::getCurrentSnapshot() const {
+    return m_mouse->getCurrentSnapshot();
 }
 
-QVector<TriangleGraphic> MouseGraphic::draw(
-        const Coordinate& currentTranslation,
-        const Angle& currentRotation) const {
+QVector<TriangleGraphic> MouseGraphic::draw(const MouseSnapshot& snapshot) const {
+
+    const Coordinate& currentTranslation = snapshot.translation;
+    const Angle& currentRotation = snapshot.rotation;
 
     QVector<TriangleGraphic> buffer;
 
     // First, we draw the body
-    buffer.append(SimUtilities::polygonToTriangleGraphics(
+    SimUtilities::appendTriangleGraphics(
         m_mouse->getCurrentBodyPolygon(currentTranslation, currentRotation),
-        STRING_TO_COLOR().value(P()->mouseBodyColor()), 1.0));
+        STRING_TO_COLOR().value(P()->mouseBodyColor()), 1.0, &buffer);
 
     // Next, draw the center of mass
-    buffer.append(SimUtilities::polygonToTriangleGraphics(
+    SimUtilities::appendTriangleGraphics(
         m_mouse->getCurrentCenterOfMassPolygon(currentTranslation, currentRotation),
-        STRING_TO_COLOR().value(P()->mouseCenterOfMassColor()), 1.0));
+        STRING_TO_COLOR().value(P()->mouseCenterOfMassColor()), 1.0, &buffer);
 
     // Next, we draw the wheels
     for (const Polygon& wheelPolygon :
             m_mouse->getCurrentWheelPolygons(currentTranslation, currentRotation)) {
-        buffer.append(SimUtilities::polygonToTriangleGraphics(
+        SimUtilities::appendTriangleGraphics(
             wheelPolygon,
-            STRING_TO_COLOR().value(P()->mouseWheelColor()), 1.0));
+            STRING_TO_COLOR().value(P()->mouseWheelColor()), 1.0, &buffer);
     }
 
     // Next, we draw the sensors
     for (const Polygon& sensorPolygon :
             m_mouse->getCurrentSensorPolygons(currentTranslation, currentRotation)) {
-        buffer.append(SimUtilities::polygonToTriangleGraphics(
+        SimUtilities::appendTriangleGraphics(
             sensorPolygon,
-            STRING_TO_COLOR().value(P()->mouseSensorColor()), 1.0));
+            STRING_TO_COLOR().value(P()->mouseSensorColor()), 1.0, &buffer);
     }
 
-    // Lastly, we draw the sensor views
-    for (const Polygon& polygon :
-            m_mouse->getCurrentSensorViewPolygons(currentTranslation, currentRotation)) {
-        buffer.append(SimUtilities::polygonToTriangleGraphics(
-            polygon,
-            STRING_TO_COLOR().value(P()->mouseViewColor()), 1.0));
+    // Lastly, we draw the sensor views, using the rays that were already
+    // cast by the model thread rather than casting them again
+    for (const QVector<Coordinate>& view : snapshot.sensorViews) {
+        SimUtilities::appendTriangleGraphics(
+            view.size() == 2
+                ? GeometryUtilities::createRayPolygon(view.at(0), view.at(1))
+                : Polygon(view, PolygonShape::FAN),
+            STRING_TO_COLOR().value(P()->mouseViewColor()), 1.0, &buffer);
     }
 
     // Uncomment to draw collision polygon
     /*
-    buffer.append(SimUtilities::polygonToTriangleGraphics(
+    SimUtilities::appendTriangleGraphics(
         m_mouse->getCurrentCollisionPolygon(currentTranslation, currentRotation),
-        Color::GRAY, .5);
+        Color::GRAY, .5, &buffer);
     */
 
     return buffer;
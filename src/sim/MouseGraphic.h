@@ -1,9 +1,9 @@
 #pragma once
 
-#include <QPair>
 #include <QVector>
 
 #include "Mouse.h"
+#include "MouseSnapshot.h"
 #include "TriangleGraphic.h"
 #include "units/Angle.h"
 #include "units/Coordinate.h"
@@ -17,11 +17,9 @@ public:
     MouseGraphic(const Mouse* mouse);
 
     Coordinate getInitialMouseTranslation() const;
-    QPair<Coordinate, Angle> getCurrentMousePosition() const;
+    MouseSnapshot getCurrentSnapshot() const;
 
-    QVector<TriangleGraphic> draw(
-        const Coordinate& currentTranslation,
-        const Angle& currentRotation) const;
+    QVector<TriangleGraphic> draw(const MouseSnapshot& snapshot) const;
 
 private:
 
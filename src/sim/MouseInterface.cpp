@@ -3,7 +3,9 @@
 #include <QChar>
 #include <QDebug>
 #include <QPair>
+#include <QSharedPointer>
 #include <QtMath>
+#include <QVector>
 
 #include "units/AngularVelocity.h"
 #include "units/Distance.h"
@@ -14,32 +16,78 @@
 #include "FontImage.h"
 #include "Logging.h"
 #include "Param.h"
+#include "ProcessUtilities.h"
 #include "SimTime.h"
 #include "SimUtilities.h"
 
-// Helper function/macro that ensures that user-requested stops
-// can always interrupt the currently executing algorithm
-#define BREAK_IF_STOPPED_ELSE_SLEEP_MIN() {\
-    if (m_stopRequested) {\
-        break;\
-    }\
-    SimUtilities::sleep(Duration::Milliseconds(P()->minSleepDuration()));\
-}
-
 namespace mms {
 
+const QSet<QString> MouseInterface::MOVEMENTS = {
+    "delay",
+    "waitForTimer",
+    "resetPosition",
+    "moveForward",
+    "turnLeft",
+    "turnRight",
+    "turnAroundLeft",
+    "turnAroundRight",
+    "originMoveForwardToEdge",
+    "originTurnLeftInPlace",
+    "originTurnRightInPlace",
+    "moveForwardToEdge",
+    "turnLeftToEdge",
+    "turnRightToEdge",
+    "turnAroundLeftToEdge",
+    "turnAroundRightToEdge",
+    "diagonalLeftLeft",
+    "diagonalLeftRight",
+    "diagonalRightLeft",
+    "diagonalRightRight",
+    "executePath",
+};
+
 MouseInterface::MouseInterface(
         const Maze* maze,
         Mouse* mouse,
-        MazeView* view) :
+        MazeView* view,
+        Model* model) :
         m_maze(maze),
         m_mouse(mouse),
         m_view(view),
+        m_model(model),
         m_interfaceType(InterfaceType::DISCRETE),
         m_interfaceTypeFinalized(false),
         m_stopRequested(false),
+        m_moving(false),
+        m_inMotion(false),
+        m_movementAsync(false),
+        m_chainingMotion(false),
+        m_runningQueuedCommands(false),
+        m_algoPid(0),
+        m_algoCpuSeconds(0.0),
         m_inOrigin(true),
-        m_wheelSpeedFraction(1.0) {
+        m_wheelSpeedFraction(1.0),
+        m_timerArmed(false) {
+
+    // Motions complete on the model thread, but the rest of the movement
+    // has to run on the thread that the interface lives on
+    connect(this, &MouseInterface::motionComplete, this, [=](){
+        m_inMotion = false;
+        runSteps();
+    }, Qt::QueuedConnection);
+    connect(
+        this, &MouseInterface::heldCommandDue,
+        this, &MouseInterface::releaseHeldCommands,
+        Qt::QueuedConnection);
+
+    // The view may carry the declared state of a previous (crashed) run of
+    // the algorithm, which should be cleared along with everything else
+    for (const QPair<int, int>& tile : m_view->getMazeGraphic()->getTilesWithColor()) {
+        m_tilesWithColor.insert(tile);
+    }
+    for (const QPair<int, int>& tile : m_view->getMazeGraphic()->getTilesWithText()) {
+        m_tilesWithText.insert(tile);
+    }
 }
 
 void MouseInterface::handleStandardOutput(QString output) {
@@ -49,12 +97,192 @@ void MouseInterface::handleStandardOutput(QString output) {
     emit algoOutput(output);
 }
 
-void MouseInterface::emitMouseAlgoStarted() {
-    emit mouseAlgoStarted();
+void MouseInterface::handleCommand(const QString& command) {
+
+    if (m_stopRequested) {
+        return;
+    }
+
+    if (!P()->chargeAlgoCpuTime() || m_algoPid <= 0) {
+        acceptCommand(command);
+        return;
+    }
+
+    // The algorithm started computing this command once it was done with
+    // the previous one, or once it got the response it was waiting for, so
+    // the command is due once that much sim time has passed. If the sim time
+    // has already passed that point (e.g., because the algorithm was waiting
+    // on something other than the CPU), it's due right away.
+    Duration now = SimTime::get()->elapsedSimTime();
+    double cpuSeconds = ProcessUtilities::getProcessCpuSeconds(m_algoPid);
+    if (0 <= cpuSeconds && 0 <= m_algoCpuSeconds) {
+        m_algoChargedUntil += Duration::Seconds(
+            (cpuSeconds - m_algoCpuSeconds) * P()->hostToMcuSpeedRatio());
+    }
+    m_algoCpuSeconds = cpuSeconds;
+    if (m_algoChargedUntil < now) {
+        m_algoChargedUntil = now;
+    }
+
+    // Commands are held in order, so only the first one has an alarm
+    bool wasEmpty = m_heldCommands.isEmpty();
+    m_heldCommands.enqueue({m_algoChargedUntil, command});
+    if (wasEmpty) {
+        releaseHeldCommands();
+    }
+}
+
+void MouseInterface::releaseHeldCommands() {
+    Duration now = SimTime::get()->elapsedSimTime();
+    while (!m_stopRequested && !m_heldCommands.isEmpty()) {
+        if (now < m_heldCommands.head().first) {
+            m_model->setAlarm(m_heldCommands.head().first, [=](){
+                emit heldCommandDue();
+            });
+            return;
+        }
+        acceptCommand(m_heldCommands.dequeue().second);
+    }
+}
+
+void MouseInterface::acceptCommand(const QString& command) {
+
+    // Every command goes through the queue, so that the ones that have to
+    // wait for a movement are handled in the same order as they arrived
+    Command parsed = parseCommand(command);
+    if (parsed.async) {
+        if (parsed.tag.isEmpty()) {
+            qWarning().noquote()
+                << "Asynchronous movements need a request ID, so \""
+                << command << "\" will run synchronously.";
+            parsed.async = false;
+        }
+        else {
+            m_pendingAsyncMovements.insert(parsed.tag);
+        }
+    }
+    m_queuedCommands.enqueue(parsed);
+    runQueuedCommands();
+}
+
+MouseInterface::Command MouseInterface::parseCommand(const QString& command) {
+
+    // A command may be tagged with a request ID, as in "#<id> <command>", in
+    // which case its response is tagged the same way. This lets algorithms
+    // send several requests before reading any of the responses. Movements
+    // may also be marked "async", as in "#<id> async <movement>".
+    Command parsed;
+    parsed.async = false;
+    parsed.body = command;
+    if (parsed.body.startsWith('#')) {
+        parsed.tag = parsed.body.section(' ', 0, 0, QString::SectionSkipEmpty);
+        parsed.body = parsed.body.section(' ', 1, -1, QString::SectionSkipEmpty);
+    }
+    parsed.function = parsed.body.section(' ', 0, 0, QString::SectionSkipEmpty);
+    if (parsed.function == "async") {
+        parsed.async = true;
+        parsed.body = parsed.body.section(' ', 1, -1, QString::SectionSkipEmpty);
+        parsed.function = parsed.body.section(' ', 0, 0, QString::SectionSkipEmpty);
+    }
+    parsed.isMovement = MOVEMENTS.contains(parsed.function);
+    return parsed;
+}
+
+void MouseInterface::runQueuedCommands() {
+
+    // Commands can finish (and thus get here) while they're being run below,
+    // in which case the loop below takes care of the rest of the queue
+    if (m_runningQueuedCommands) {
+        return;
+    }
+    m_runningQueuedCommands = true;
+
+    // Movements run one at a time, in order. Any other command waits for
+    // the movements ahead of it, so that the responses are sent in the same
+    // order as the commands, unless all of those movements are asynchronous,
+    // in which case it's handled right away.
+    bool ranCommand = true;
+    while (ranCommand && !m_stopRequested) {
+        ranCommand = false;
+        bool movementAhead = false;
+        bool syncMovementAhead = false;
+        for (int i = 0; i < m_queuedCommands.size(); i += 1) {
+            const Command& command = m_queuedCommands.at(i);
+            bool canRun = (
+                command.isMovement
+                ? !m_moving && !movementAhead
+                : !(m_moving && !m_movementAsync) && !syncMovementAhead
+            );
+            if (canRun) {
+                runCommand(m_queuedCommands.takeAt(i));
+                ranCommand = true;
+                break;
+            }
+            if (command.isMovement) {
+                movementAhead = true;
+                syncMovementAhead = syncMovementAhead || !command.async;
+            }
+        }
+    }
+    m_runningQueuedCommands = false;
 }
 
-void MouseInterface::emitMouseAlgoCannotStart(QString errorString) {
-    emit mouseAlgoCannotStart(errorString);
+void MouseInterface::runCommand(const Command& command) {
+
+    if (m_ignoredCommands.contains(command.function)) {
+        m_pendingAsyncMovements.remove(command.tag);
+        emitResponse(command.tag, "ACK");
+        return;
+    }
+
+    QString result = dispatch(command.body);
+    if (result.isNull()) {
+        m_movementTag = command.tag;
+        m_movementAsync = command.async;
+        runSteps();
+    }
+    else {
+        // Not actually a movement (e.g., an invalid one), so it's done
+        m_pendingAsyncMovements.remove(command.tag);
+        if (!result.isEmpty()) {
+            emitResponse(command.tag, result);
+        }
+    }
+}
+
+void MouseInterface::emitResponse(const QString& tag, const QString& result) {
+
+    // Once every command has been answered, the algorithm may have been
+    // waiting on this response, and so it starts computing from here
+    if (
+        m_heldCommands.isEmpty() &&
+        m_queuedCommands.isEmpty() &&
+        !(m_moving && !m_movementAsync)
+    ) {
+        m_algoChargedUntil = SimTime::get()->elapsedSimTime();
+    }
+
+    if (tag.isEmpty()) {
+        emit response(result);
+    }
+    else {
+        emit response(tag + " " + result);
+    }
+}
+
+void MouseInterface::setIgnoredCommands(const QSet<QString>& functions) {
+    m_ignoredCommands = functions;
+}
+
+void MouseInterface::setAlgoProcessId(qint64 pid) {
+    m_algoPid = pid;
+    m_algoCpuSeconds = ProcessUtilities::getProcessCpuSeconds(pid);
+    m_algoChargedUntil = SimTime::get()->elapsedSimTime();
+    if (P()->chargeAlgoCpuTime() && m_algoCpuSeconds < 0) {
+        qWarning().noquote()
+            << "The CPU time of the algorithm can't be measured on this"
+            << "platform, so it won't be charged to the sim clock.";
+    }
 }
 
 QString MouseInterface::dispatch(const QString& command) {
@@ -77,6 +305,8 @@ QString MouseInterface::dispatch(const QString& command) {
         }
         else {
             m_interfaceType = InterfaceType::CONTINUOUS;
+            // Only a mouse that's driven by its wheels can run into walls
+            m_model->setCollisionDetectionEnabled(P()->collisionDetectionEnabled());
         }
         return ACK_STRING;
     }
@@ -153,17 +383,36 @@ QString MouseInterface::dispatch(const QString& command) {
     else if (function == "initialDirection") {
         return QString(QChar(getStartedDirection()));
     }
+    else if (function == "moveDone") {
+        return SimUtilities::boolToStr(
+            !m_pendingAsyncMovements.contains("#" + tokens.at(1)));
+    }
+    else if (function == "getDeclaredState") {
+        return m_view->getMazeGraphic()->getDeclaredState();
+    }
     else if (function == "getRandomFloat") {
         return QString::number(getRandom());
     }
     else if (function == "millis") {
         return QString::number(millis());
     }
+    else if (function == "micros") {
+        return QString::number(micros());
+    }
     else if (function == "delay") {
         int milliseconds = SimUtilities::strToInt(tokens.at(1));
         delay(milliseconds);
+        return startMovement(ACK_STRING);
+    }
+    else if (function == "setTimer") {
+        int periodUs = SimUtilities::strToInt(tokens.at(1));
+        setTimer(periodUs);
         return ACK_STRING;
     }
+    else if (function == "waitForTimer") {
+        waitForTimer();
+        return startMovement(ACK_STRING);
+    }
     else if (function == "setTileColor") {
         int x = SimUtilities::strToInt(tokens.at(1));
         int y = SimUtilities::strToInt(tokens.at(2));
@@ -301,35 +550,35 @@ QString MouseInterface::dispatch(const QString& command) {
             count = SimUtilities::strToInt(tokens.at(1));
         }
         moveForward(count);
-        return ACK_STRING;
+        return startMovement(ACK_STRING);
     }
     else if (function == "turnLeft") {
         turnLeft();
-        return ACK_STRING;
+        return startMovement(ACK_STRING);
     }
     else if (function == "turnRight") {
         turnRight();
-        return ACK_STRING;
+        return startMovement(ACK_STRING);
     }
     else if (function == "turnAroundLeft") {
         turnAroundLeft();
-        return ACK_STRING;
+        return startMovement(ACK_STRING);
     }
     else if (function == "turnAroundRight") {
         turnAroundRight();
-        return ACK_STRING;
+        return startMovement(ACK_STRING);
     }
     else if (function == "originMoveForwardToEdge") {
         originMoveForwardToEdge();
-        return ACK_STRING;
+        return startMovement(ACK_STRING);
     }
     else if (function == "originTurnLeftInPlace") {
         originTurnLeftInPlace();
-        return ACK_STRING;
+        return startMovement(ACK_STRING);
     }
     else if (function == "originTurnRightInPlace") {
         originTurnRightInPlace();
-        return ACK_STRING;
+        return startMovement(ACK_STRING);
     }
     else if (function == "moveForwardToEdge") {
         int count = 1;
@@ -337,43 +586,50 @@ QString MouseInterface::dispatch(const QString& command) {
             count = SimUtilities::strToInt(tokens.at(1));
         }
         moveForwardToEdge(count);
-        return ACK_STRING;
+        return startMovement(ACK_STRING);
     }
     else if (function == "turnLeftToEdge") {
         turnLeftToEdge();
-        return ACK_STRING;
+        return startMovement(ACK_STRING);
     }
     else if (function == "turnRightToEdge") {
         turnRightToEdge();
-        return ACK_STRING;
+        return startMovement(ACK_STRING);
     }
     else if (function == "turnAroundLeftToEdge") {
         turnAroundLeftToEdge();
-        return ACK_STRING;
+        return startMovement(ACK_STRING);
     }
     else if (function == "turnAroundRightToEdge") {
         turnAroundRightToEdge();
-        return ACK_STRING;
+        return startMovement(ACK_STRING);
     }
     else if (function == "diagonalLeftLeft") {
         int count = SimUtilities::strToInt(tokens.at(1));
         diagonalLeftLeft(count);
-        return ACK_STRING;
+        return startMovement(ACK_STRING);
     }
     else if (function == "diagonalLeftRight") {
         int count = SimUtilities::strToInt(tokens.at(1));
         diagonalLeftRight(count);
-        return ACK_STRING;
+        return startMovement(ACK_STRING);
     }
     else if (function == "diagonalRightLeft") {
         int count = SimUtilities::strToInt(tokens.at(1));
         diagonalRightLeft(count);
-        return ACK_STRING;
+        return startMovement(ACK_STRING);
     }
     else if (function == "diagonalRightRight") {
         int count = SimUtilities::strToInt(tokens.at(1));
         diagonalRightRight(count);
-        return ACK_STRING;
+        return startMovement(ACK_STRING);
+    }
+    else if (function == "executePath") {
+        int moves = executePath(QStringList(tokens.mid(1)).join(""));
+        if (moves < 0) {
+            return ERROR_STRING;
+        }
+        return startMovement(QString::number(moves));
     }
     else if (function == "currentXTile") {
         return QString::number(currentXTile());
@@ -399,6 +655,14 @@ QString MouseInterface::dispatch(const QString& command) {
 
 void MouseInterface::requestStop() {
     m_stopRequested = true;
+    m_model->clearCompletion();
+    m_model->clearAlarm();
+    m_heldCommands.clear();
+    m_steps.clear();
+    m_pathMotions.clear();
+    m_queuedCommands.clear();
+    m_pendingAsyncMovements.clear();
+    m_mouse->stopAllWheels();
 }
 
 void MouseInterface::inputButtonWasPressed(int button) {
@@ -455,11 +719,58 @@ int MouseInterface::millis() {
     return SimTime::get()->elapsedSimTime().getMilliseconds();
 }
 
+qint64 MouseInterface::micros() {
+    return qRound64(SimTime::get()->elapsedSimTime().getMicroseconds());
+}
+
 void MouseInterface::delay(int milliseconds) {
-    Duration start = SimTime::get()->elapsedSimTime();
-    while (SimTime::get()->elapsedSimTime() < start + Duration::Milliseconds(milliseconds)) {
-        BREAK_IF_STOPPED_ELSE_SLEEP_MIN();
+    addStep([=](){
+        Duration end = SimTime::get()->elapsedSimTime() + Duration::Milliseconds(milliseconds);
+        startMotionAt(end, nullptr);
+    });
+}
+
+void MouseInterface::setTimer(int periodUs) {
+    if (periodUs < 0) {
+        qWarning().noquote().nospace()
+            << "The timer period must be non-negative, not " << periodUs
+            << " microseconds.";
+        return;
     }
+    m_timerArmed = (0 < periodUs);
+    m_timerPeriod = Duration::Microseconds(periodUs);
+    m_timerDeadline = SimTime::get()->elapsedSimTime() + m_timerPeriod;
+}
+
+void MouseInterface::waitForTimer() {
+    addStep([=](){
+
+        if (!m_timerArmed) {
+            qWarning().noquote().nospace()
+                << "You can't wait for the timer since it isn't set.";
+            m_movementResponse = QString::number(micros());
+            return;
+        }
+
+        // If the algorithm took longer than a period, the deadline has
+        // already passed, so respond right away. Any other deadlines that
+        // were missed are skipped, but the phase of the timer is kept.
+        Duration now = SimTime::get()->elapsedSimTime();
+        Duration deadline = m_timerDeadline;
+        if (!(now < deadline)) {
+            while (!(now < m_timerDeadline)) {
+                deadline = m_timerDeadline;
+                m_timerDeadline = m_timerDeadline + m_timerPeriod;
+            }
+            m_movementResponse = QString::number(
+                qRound64(deadline.getMicroseconds()));
+            return;
+        }
+        m_timerDeadline = deadline + m_timerPeriod;
+        m_movementResponse = QString::number(
+            qRound64(deadline.getMicroseconds()));
+        startMotionAt(deadline, nullptr);
+    });
 }
 
 void MouseInterface::setTileColor(int x, int y, char color) {
@@ -980,6 +1291,267 @@ void MouseInterface::diagonalRightRight(int count) {
     doDiagonal(count, false, false);
 }
 
+int MouseInterface::executePath(const QString& path) {
+
+    ENSURE_DISCRETE_INTERFACE
+
+    static Distance halfWallLength = Distance::Meters(P()->wallLength() / 2.0);
+    static Distance halfWallLengthPlusWallWidth =
+        Distance::Meters(P()->wallLength() / 2.0 + P()->wallWidth());
+    static Distance wallWidth = Distance::Meters(P()->wallWidth());
+    static Distance halfWallWidth = Distance::Meters(P()->wallWidth() / 2.0);
+    static Distance tileLength = Distance::Meters(P()->wallLength() + P()->wallWidth());
+    static Distance halfTileDiagonal =
+        Distance::Meters(std::sqrt(2.0) * tileLength.getMeters() / 2.0);
+
+    auto malformed = [&](const QString& reason) {
+        qWarning().noquote().nospace()
+            << "The path \"" << path << "\" passed to"
+            << " MouseInterface::executePath() is malformed: " << reason
+            << ". The mouse won't move.";
+        return -1;
+    };
+
+    // First, parse the whole path, so that nothing moves if it's malformed
+    struct Move {
+        QChar type;
+        bool left;
+        bool endLeft;
+        int count;
+    };
+    QVector<Move> parsedMoves;
+    int position = 0;
+    auto readSide = [&](bool* left) {
+        if (position < path.size() && (path.at(position) == 'L' || path.at(position) == 'R')) {
+            *left = (path.at(position) == 'L');
+            position += 1;
+            return true;
+        }
+        return false;
+    };
+    auto readCount = [&]() {
+        int start = position;
+        while (position < path.size() && path.at(position).isDigit()) {
+            position += 1;
+        }
+        return (start == position ? -1 : path.mid(start, position - start).toInt());
+    };
+    while (position < path.size()) {
+        Move move = {path.at(position), false, false, 1};
+        position += 1;
+        if (move.type == 'F') {
+            move.count = readCount();
+            if (move.count == 0) {
+                return malformed("a forward move must be at least one tile");
+            }
+            if (move.count < 0) {
+                move.count = 1;
+            }
+        }
+        else if (move.type == 'L' || move.type == 'R') {
+            move.left = (move.type == 'L');
+        }
+        else if (move.type == 'U') {
+            if (!readSide(&move.left)) {
+                return malformed("a turn around must be UL or UR");
+            }
+        }
+        else if (move.type == 'D') {
+            if (!readSide(&move.left) || !readSide(&move.endLeft)) {
+                return malformed("a diagonal must be DLL, DLR, DRL, or DRR");
+            }
+            move.count = readCount();
+            if (move.count < 1) {
+                return malformed("a diagonal must have a segment count");
+            }
+        }
+        else {
+            return malformed(QString("'%1' isn't a move").arg(move.type));
+        }
+        parsedMoves.append(move);
+    }
+
+    // Then plan the motions, starting from where the mouse is now. Each
+    // move is checked against the walls before any of its motions are
+    // planned, and the path ends early at the first move that would crash.
+    bool tileEdgeMovements = getDynamicOptions().useTileEdgeMovements;
+    QPair<int, int> tile = m_mouse->getCurrentDiscretizedTranslation();
+    Direction direction = m_mouse->getCurrentDiscretizedRotation();
+    Coordinate translation = m_mouse->getCurrentTranslation();
+    Angle rotation = m_mouse->getCurrentRotation();
+    bool inOrigin = m_inOrigin;
+
+    // The motions after the first one start on the model thread, so they're
+    // given the wheel speed fraction as of now, rather than reading it then
+    // (it may be changed by a later command while the path is in progress)
+    double wheelSpeedFraction = m_wheelSpeedFraction;
+
+    // Moves from the tile through each of the directions in turn, unless
+    // that would hit a wall
+    auto advance = [&](QPair<int, int>* from, const QVector<Direction>& directions) {
+        QPair<int, int> current = *from;
+        for (Direction throughDirection : directions) {
+            if (isWall({current, throughDirection}, false, false)) {
+                return false;
+            }
+            current = getOpposingWall({current, throughDirection}).first;
+        }
+        *from = current;
+        return true;
+    };
+
+    // Consecutive straight motions are along the same line, and so they're
+    // merged into one
+    QVector<std::function<void()>> motions;
+    bool lastMotionIsStraight = false;
+    auto addStraight = [&](const Coordinate& destination) {
+        if (lastMotionIsStraight) {
+            motions.removeLast();
+        }
+        Angle destinationRotation = rotation;
+        motions.append([=](){
+            moveForwardTo(destination, destinationRotation, wheelSpeedFraction);
+        });
+        translation = destination;
+        lastMotionIsStraight = true;
+    };
+    auto addArc = [&](const Coordinate& destination, const Angle& destinationRotation,
+            const Distance& radius, double extraWheelSpeedFraction) {
+        motions.append([=](){
+            arcTo(destination, destinationRotation, radius,
+                extraWheelSpeedFraction, wheelSpeedFraction);
+        });
+        translation = destination;
+        rotation = destinationRotation;
+        lastMotionIsStraight = false;
+    };
+    auto addTurn = [&](const Angle& destinationRotation) {
+        addArc(translation, destinationRotation, Distance::Meters(0), 0.5);
+    };
+
+    int moves = 0;
+    for (const Move& move : parsedMoves) {
+
+        if (move.type == 'F') {
+            QPair<int, int> destinationTile = tile;
+            if (!advance(&destinationTile, QVector<Direction>(move.count, direction))) {
+                break;
+            }
+            Distance distance = tileLength * move.count;
+            if (tileEdgeMovements && inOrigin) {
+                distance = halfWallLengthPlusWallWidth + tileLength * (move.count - 1);
+                inOrigin = false;
+            }
+            rotation = DIRECTION_TO_ANGLE().value(direction);
+            addStraight(translation + Coordinate::Polar(distance, rotation));
+            tile = destinationTile;
+        }
+
+        else if (move.type == 'L' || move.type == 'R') {
+            Direction newDirection = (
+                move.left ?
+                DIRECTION_ROTATE_LEFT().value(direction) :
+                DIRECTION_ROTATE_RIGHT().value(direction)
+            );
+            if (tileEdgeMovements && !inOrigin) {
+                QPair<int, int> destinationTile = tile;
+                if (!advance(&destinationTile, {newDirection})) {
+                    break;
+                }
+                QPair<Coordinate, Angle> crashLocation = getCrashLocation(tile, newDirection);
+                addArc(crashLocation.first, crashLocation.second, halfWallLength, 1.0);
+                addStraight(crashLocation.first + Coordinate::Polar(wallWidth, crashLocation.second));
+                tile = destinationTile;
+            }
+            else {
+                addTurn(rotation + Angle::Degrees(move.left ? 90 : -90));
+            }
+            direction = newDirection;
+        }
+
+        else if (move.type == 'U') {
+            Direction newDirection = DIRECTION_OPPOSITE().value(direction);
+            if (tileEdgeMovements) {
+                if (inOrigin) {
+                    return malformed("you can't turn around to an edge in the origin");
+                }
+                addStraight(translation + Coordinate::Polar(halfWallLength, rotation));
+            }
+            for (int i = 0; i < 2; i += 1) {
+                addTurn(rotation + Angle::Degrees(move.left ? 90 : -90));
+            }
+            if (tileEdgeMovements) {
+                addStraight(translation + Coordinate::Polar(halfWallLengthPlusWallWidth, rotation));
+                tile = getOpposingWall({tile, newDirection}).first;
+            }
+            direction = newDirection;
+        }
+
+        else if (move.type == 'D') {
+            if (!tileEdgeMovements || inOrigin) {
+                return malformed("diagonals require tile edge movements, outside of the origin");
+            }
+
+            // As in doDiagonal(), turning the same way at the entrance and
+            // exit requires an odd number of segments, and otherwise an even
+            // number; the segments alternate between crossing the edge to
+            // the side and the edge in front
+            if ((move.left == move.endLeft) != (move.count % 2 == 1)) {
+                break;
+            }
+            Direction side = (
+                move.left ?
+                DIRECTION_ROTATE_LEFT().value(direction) :
+                DIRECTION_ROTATE_RIGHT().value(direction)
+            );
+            QVector<Direction> crossings;
+            for (int i = 0; i < move.count; i += 1) {
+                crossings.append(i % 2 == 0 ? side : direction);
+            }
+            QPair<int, int> destinationTile = tile;
+            if (!advance(&destinationTile, crossings)) {
+                break;
+            }
+
+            Coordinate backALittleBit = translation +
+                Coordinate::Polar(halfWallWidth, rotation + Angle::Degrees(180));
+            Coordinate destination = backALittleBit + Coordinate::Polar(
+                halfTileDiagonal * move.count,
+                rotation + Angle::Degrees(45) * (move.left ? 1 : -1));
+            Angle endRotation = rotation;
+            if (move.left && move.endLeft) {
+                endRotation += Angle::Degrees(90);
+            }
+            if (!move.left && !move.endLeft) {
+                endRotation -= Angle::Degrees(90);
+            }
+            addTurn((destination - translation).getTheta());
+            addStraight(destination);
+            addTurn(endRotation);
+            addStraight(destination + Coordinate::Polar(halfWallWidth, endRotation));
+            tile = destinationTile;
+            direction = (move.count % 2 == 1 ? side : direction);
+        }
+
+        moves += 1;
+    }
+
+    m_inOrigin = inOrigin;
+
+    // Only the first motion starts from here; the rest are started by the
+    // motions before them, so that the wheels don't stop in between
+    if (!motions.isEmpty()) {
+        addStep([=](){
+            for (int i = 1; i < motions.size(); i += 1) {
+                m_pathMotions.enqueue(motions.at(i));
+            }
+            motions.first()();
+        });
+    }
+
+    return moves;
+}
+
 int MouseInterface::currentXTile() {
 
     ENSURE_ALLOW_OMNISCIENCE
@@ -1181,44 +1753,59 @@ void MouseInterface::moveForwardImpl(bool originMoveForwardToEdge) {
     static Distance halfWallLengthPlusWallWidth =
         Distance::Meters(P()->wallLength() / 2.0 + P()->wallWidth());
     static Distance tileLength = Distance::Meters(P()->wallLength() + P()->wallWidth());
-    static Distance wallWidth = Distance::Meters(P()->wallWidth());
 
-    // Whether or not this movement will cause a crash
-    bool crash = wallFrontImpl(false, false);
+    // Determined by the first step, and used by the second
+    QSharedPointer<bool> crash(new bool(false));
+    QSharedPointer<QPair<Coordinate, Angle>> destination(new QPair<Coordinate, Angle>());
 
-    // Get the location of the crash, if it will happen
-    QPair<Coordinate, Angle> crashLocation = getCrashLocation(
-        m_mouse->getCurrentDiscretizedTranslation(),
-        m_mouse->getCurrentDiscretizedRotation()
-    );
+    addStep([=](){
 
-    // Get the destination translation of the mouse
-    Coordinate destinationTranslation = m_mouse->getCurrentTranslation() +
-        Coordinate::Polar(
-            (originMoveForwardToEdge ? halfWallLengthPlusWallWidth : tileLength),
-            crashLocation.second
+        // Whether or not this movement will cause a crash
+        *crash = wallFrontImpl(false, false);
+
+        // Get the location of the crash, if it will happen
+        QPair<Coordinate, Angle> crashLocation = getCrashLocation(
+            m_mouse->getCurrentDiscretizedTranslation(),
+            m_mouse->getCurrentDiscretizedRotation()
         );
 
-    // Move forward to the crash location
-    moveForwardTo(crashLocation.first, crashLocation.second);
+        // Get the destination translation of the mouse
+        *destination = {
+            m_mouse->getCurrentTranslation() + Coordinate::Polar(
+                (originMoveForwardToEdge ? halfWallLengthPlusWallWidth : tileLength),
+                crashLocation.second
+            ),
+            crashLocation.second
+        };
 
-    // If we didn't crash, finish the move forward
-    if (!crash) {
-        moveForwardTo(destinationTranslation, crashLocation.second);
-    }
+        // Move forward to the crash location
+        moveForwardTo(crashLocation.first, crashLocation.second);
+    });
 
-    // Otherwise, set the crashed state (if it hasn't already been set)
-    else if (!m_mouse->didCrash()) {
-        m_mouse->setCrashed();
-    }
+    addStep([=](){
+
+        // If we didn't crash, finish the move forward
+        if (!*crash) {
+            moveForwardTo(destination->first, destination->second);
+        }
+
+        // Otherwise, set the crashed state (if it hasn't already been set)
+        else if (!m_mouse->didCrash()) {
+            m_mouse->setCrashed();
+        }
+    });
 }
 
 void MouseInterface::turnLeftImpl() {
-    turnTo(m_mouse->getCurrentTranslation(), m_mouse->getCurrentRotation() + Angle::Degrees(90));
+    addStep([=](){
+        turnTo(m_mouse->getCurrentTranslation(), m_mouse->getCurrentRotation() + Angle::Degrees(90));
+    });
 }
 
 void MouseInterface::turnRightImpl() {
-    turnTo(m_mouse->getCurrentTranslation(), m_mouse->getCurrentRotation() - Angle::Degrees(90));
+    addStep([=](){
+        turnTo(m_mouse->getCurrentTranslation(), m_mouse->getCurrentRotation() - Angle::Degrees(90));
+    });
 }
 
 void MouseInterface::turnAroundLeftImpl() {
@@ -1236,9 +1823,11 @@ void MouseInterface::turnAroundRightImpl() {
 void MouseInterface::turnAroundToEdgeImpl(bool turnLeft) {
 
     // Move to the center of the tile
-    Coordinate delta = Coordinate::Polar(
-        Distance::Meters(P()->wallLength() / 2.0), m_mouse->getCurrentRotation());
-    moveForwardTo(m_mouse->getCurrentTranslation() + delta, m_mouse->getCurrentRotation());
+    addStep([=](){
+        Coordinate delta = Coordinate::Polar(
+            Distance::Meters(P()->wallLength() / 2.0), m_mouse->getCurrentRotation());
+        moveForwardTo(m_mouse->getCurrentTranslation() + delta, m_mouse->getCurrentRotation());
+    });
 
     // Turn around
     if (turnLeft) {
@@ -1249,9 +1838,11 @@ void MouseInterface::turnAroundToEdgeImpl(bool turnLeft) {
     }
 
     // Move forward, into the next tile
-    delta = Coordinate::Polar(
-        Distance::Meters(P()->wallLength() / 2.0 + P()->wallWidth()), m_mouse->getCurrentRotation());
-    moveForwardTo(m_mouse->getCurrentTranslation() + delta, m_mouse->getCurrentRotation());
+    addStep([=](){
+        Coordinate delta = Coordinate::Polar(
+            Distance::Meters(P()->wallLength() / 2.0 + P()->wallWidth()), m_mouse->getCurrentRotation());
+        moveForwardTo(m_mouse->getCurrentTranslation() + delta, m_mouse->getCurrentRotation());
+    });
 }
 
 void MouseInterface::turnToEdgeImpl(bool turnLeft) {
@@ -1259,37 +1850,47 @@ void MouseInterface::turnToEdgeImpl(bool turnLeft) {
     static Distance halfWallLength = Distance::Meters(P()->wallLength() / 2.0);
     static Distance wallWidth = Distance::Meters(P()->wallWidth());
 
-    // Whether or not this movement will cause a crash
-    bool crash = (
-        ( turnLeft &&  wallLeftImpl(false, false)) ||
-        (!turnLeft && wallRightImpl(false, false))
-    );
+    // Determined by the first step, and used by the second
+    QSharedPointer<bool> crash(new bool(false));
+    QSharedPointer<QPair<Coordinate, Angle>> crashLocation(new QPair<Coordinate, Angle>());
 
-    // Get the location of the crash, if it will happen
-    QPair<Coordinate, Angle> crashLocation = getCrashLocation(
-        m_mouse->getCurrentDiscretizedTranslation(),
-        (
-            turnLeft ?
-            DIRECTION_ROTATE_LEFT().value(m_mouse->getCurrentDiscretizedRotation()) :
-            DIRECTION_ROTATE_RIGHT().value(m_mouse->getCurrentDiscretizedRotation())
-        )
-    );
+    addStep([=](){
 
-    // Perform the curve turn
-    arcTo(crashLocation.first, crashLocation.second, halfWallLength, 1.0);
+        // Whether or not this movement will cause a crash
+        *crash = (
+            ( turnLeft &&  wallLeftImpl(false, false)) ||
+            (!turnLeft && wallRightImpl(false, false))
+        );
 
-    // If we didn't crash, move forward into the new tile
-    if (!crash) {
-        moveForwardTo(
-            crashLocation.first + Coordinate::Polar(wallWidth, crashLocation.second),
-            crashLocation.second
+        // Get the location of the crash, if it will happen
+        *crashLocation = getCrashLocation(
+            m_mouse->getCurrentDiscretizedTranslation(),
+            (
+                turnLeft ?
+                DIRECTION_ROTATE_LEFT().value(m_mouse->getCurrentDiscretizedRotation()) :
+                DIRECTION_ROTATE_RIGHT().value(m_mouse->getCurrentDiscretizedRotation())
+            )
         );
-    }
 
-    // Otherwise, set the crashed state (if it hasn't already been set)
-    else if (!m_mouse->didCrash()) {
-        m_mouse->setCrashed();
-    }
+        // Perform the curve turn
+        arcTo(crashLocation->first, crashLocation->second, halfWallLength, 1.0);
+    });
+
+    addStep([=](){
+
+        // If we didn't crash, move forward into the new tile
+        if (!*crash) {
+            moveForwardTo(
+                crashLocation->first + Coordinate::Polar(wallWidth, crashLocation->second),
+                crashLocation->second
+            );
+        }
+
+        // Otherwise, set the crashed state (if it hasn't already been set)
+        else if (!m_mouse->didCrash()) {
+            m_mouse->setCrashed();
+        }
+    });
 }
 
 bool MouseInterface::isWall(QPair<QPair<int, int>, Direction> wall, bool declareWallOnRead, bool declareBothWallHalves) {
@@ -1343,7 +1944,100 @@ QPair<QPair<int, int>, Direction> MouseInterface::getOpposingWall(
     }
 }
 
+QString MouseInterface::startMovement(const QString& response) {
+    ASSERT_FA(m_moving);
+    m_moving = true;
+    m_movementResponse = response;
+    return QString();
+}
+
+void MouseInterface::addStep(std::function<void()> step) {
+    m_steps.enqueue(step);
+}
+
+void MouseInterface::runSteps() {
+
+    if (m_stopRequested) {
+        return;
+    }
+
+    // Run steps until one of them starts a motion, or until they're all done
+    while (!m_inMotion && !m_steps.isEmpty()) {
+        std::function<void()> step = m_steps.dequeue();
+        step();
+    }
+    if (m_inMotion) {
+        return;
+    }
+
+    // The movement is done, so respond to it (for asynchronous movements,
+    // this is the notification that they're done), and then get to the
+    // commands that were waiting for it
+    m_moving = false;
+    m_pendingAsyncMovements.remove(m_movementTag);
+    emitResponse(m_movementTag, m_movementResponse);
+    runQueuedCommands();
+}
+
+void MouseInterface::startMotion(
+        std::function<bool()> isComplete,
+        std::function<void()> onComplete) {
+
+    // A crashed mouse doesn't move, so it would never reach the end of the
+    // motion; instead, the motion (and the rest of the path) ends where the
+    // mouse crashed, so that the movement still gets its response
+    Mouse* mouse = m_mouse;
+    std::function<bool()> condition = [=](){
+        return mouse->didCrash() || isComplete();
+    };
+    std::function<void()> action = [=](){
+        if (mouse->didCrash()) {
+            m_pathMotions.clear();
+            emit motionComplete();
+            return;
+        }
+        if (onComplete) {
+            onComplete();
+        }
+
+        // The next motion of a path, if any, starts right away (still on the
+        // model thread), and takes the place of this one
+        if (!m_pathMotions.isEmpty()) {
+            m_chainingMotion = true;
+            m_pathMotions.dequeue()();
+            m_chainingMotion = false;
+            return;
+        }
+        emit motionComplete();
+    };
+    if (m_chainingMotion) {
+        m_model->chainCompletion(condition, action);
+        return;
+    }
+    ASSERT_FA(m_inMotion);
+    m_inMotion = true;
+    m_model->setCompletion(condition, action);
+}
+
+void MouseInterface::startMotionAt(
+        const Duration& deadline,
+        std::function<void()> onComplete) {
+    ASSERT_FA(m_inMotion);
+    m_inMotion = true;
+    m_model->setCompletionAt(deadline, [=](){
+        if (onComplete) {
+            onComplete();
+        }
+        emit motionComplete();
+    });
+}
+
 void MouseInterface::moveForwardTo(const Coordinate& destinationTranslation, const Angle& destinationRotation) {
+    moveForwardTo(destinationTranslation, destinationRotation, m_wheelSpeedFraction);
+}
+
+void MouseInterface::moveForwardTo(const Coordinate& destinationTranslation, const Angle& destinationRotation,
+        double wheelSpeedFraction) {
 
     // This function assumes that we're already facing the correct direction,
     // and that we simply need to move forward to reach the destination.
@@ -1354,29 +2048,38 @@ void MouseInterface::moveForwardTo(const Coordinate& destinationTranslation, con
     Distance previousDistance = delta.getRho();
 
     // Start the mouse moving forward
-    m_mouse->setWheelSpeedsForMoveForward(m_wheelSpeedFraction);
-
-    // Move forward until we've reached the destination
-    do {
-        // Assert that we're actually moving closer to the destination
-        ASSERT_LE(delta.getRho().getMeters(), previousDistance.getMeters());
-        previousDistance = delta.getRho();
-        // Check if a stop has been requested
-        BREAK_IF_STOPPED_ELSE_SLEEP_MIN();
-        // Update the translation delta
-        delta = destinationTranslation - m_mouse->getCurrentTranslation();
-    }
-    // While the angle delta is not ~180 degrees, sleep for a short amout of time
-    while (std::abs((delta.getTheta() - initialAngle).getDegreesZeroTo360()) <  90
-        || std::abs((delta.getTheta() - initialAngle).getDegreesZeroTo360()) > 270);
-
-    // Stop the wheels and teleport to the exact destination
-    m_mouse->stopAllWheels();
-    m_mouse->teleport(destinationTranslation, destinationRotation);
+    m_mouse->setWheelSpeedsForMoveForward(wheelSpeedFraction);
+
+    Mouse* mouse = m_mouse;
+    startMotion(
+        // We've reached the destination once the angle delta is ~180 degrees
+        [=]() mutable {
+            Coordinate delta = destinationTranslation - mouse->getCurrentTranslation();
+            // Assert that we're actually moving closer to the destination
+            ASSERT_LE(delta.getRho().getMeters(), previousDistance.getMeters());
+            previousDistance = delta.getRho();
+            double degrees = std::abs((delta.getTheta() - initialAngle).getDegreesZeroTo360());
+            return 90 <= degrees && degrees <= 270;
+        },
+        // Stop the wheels (unless another motion of a path follows this
+        // one) and teleport to the exact destination
+        [=](){
+            if (m_pathMotions.isEmpty()) {
+                mouse->stopAllWheels();
+            }
+            mouse->teleport(destinationTranslation, destinationRotation);
+        }
+    );
 }
 
 void MouseInterface::arcTo(const Coordinate& destinationTranslation, const Angle& destinationRotation,
         const Distance& radius, double extraWheelSpeedFraction) {
+    arcTo(destinationTranslation, destinationRotation, radius,
+        extraWheelSpeedFraction, m_wheelSpeedFraction);
+}
+
+void MouseInterface::arcTo(const Coordinate& destinationTranslation, const Angle& destinationRotation,
+        const Distance& radius, double extraWheelSpeedFraction, double wheelSpeedFraction) {
 
     // Determine the inital rotation delta in [-180, 180)
     Angle initialRotationDelta = getRotationDelta(m_mouse->getCurrentRotation(), destinationRotation);
@@ -1384,26 +2087,33 @@ void MouseInterface::arcTo(const Coordinate& destinationTranslation, const Angle
     // Set the speed based on the initial rotation delta
     if (0 < initialRotationDelta.getDegreesUnbounded()) {
         m_mouse->setWheelSpeedsForCurveLeft(
-            m_wheelSpeedFraction * extraWheelSpeedFraction, radius);
+            wheelSpeedFraction * extraWheelSpeedFraction, radius);
     }
     else {
         m_mouse->setWheelSpeedsForCurveRight(
-            m_wheelSpeedFraction * extraWheelSpeedFraction, radius);
-    }
-    
-    // While the deltas have the same sign, sleep for a short amount of time
-    while (0 <
-            initialRotationDelta.getRadiansUnbounded() *
-            getRotationDelta(
-                m_mouse->getCurrentRotation(),
-                destinationRotation
-            ).getRadiansUnbounded()) {
-        BREAK_IF_STOPPED_ELSE_SLEEP_MIN();
-    }
-
-    // Stop the wheels and teleport to the exact destination
-    m_mouse->stopAllWheels();
-    m_mouse->teleport(destinationTranslation, destinationRotation);
+            wheelSpeedFraction * extraWheelSpeedFraction, radius);
+    }
+
+    Mouse* mouse = m_mouse;
+    startMotion(
+        // We've reached the destination once the deltas have different signs
+        [=](){
+            return 0 >=
+                initialRotationDelta.getRadiansUnbounded() *
+                getRotationDelta(
+                    mouse->getCurrentRotation(),
+                    destinationRotation
+                ).getRadiansUnbounded();
+        },
+        // Stop the wheels (unless another motion of a path follows this
+        // one) and teleport to the exact destination
+        [=](){
+            if (m_pathMotions.isEmpty()) {
+                mouse->stopAllWheels();
+            }
+            mouse->teleport(destinationTranslation, destinationRotation);
+        }
+    );
 }
 
 void MouseInterface::turnTo(const Coordinate& destinationTranslation, const Angle& destinationRotation) {
@@ -1534,14 +2244,23 @@ void MouseInterface::doDiagonal(int count, bool startLeft, bool endLeft) {
         endRotation -= Angle::Degrees(90);
     }
     
-    turnTo(m_mouse->getCurrentTranslation(), delta.getTheta());
-    moveForwardTo(destination, m_mouse->getCurrentRotation());
-    turnTo(m_mouse->getCurrentTranslation(), endRotation);
-    moveForwardTo(destination + Coordinate::Polar(Distance::Meters(P()->wallWidth() / 2.0), m_mouse->getCurrentRotation()), m_mouse->getCurrentRotation());
-
-    if (crash && !m_mouse->didCrash()) {
-        m_mouse->setCrashed();
-    }
+    addStep([=](){
+        turnTo(m_mouse->getCurrentTranslation(), delta.getTheta());
+    });
+    addStep([=](){
+        moveForwardTo(destination, m_mouse->getCurrentRotation());
+    });
+    addStep([=](){
+        turnTo(m_mouse->getCurrentTranslation(), endRotation);
+    });
+    addStep([=](){
+        moveForwardTo(destination + Coordinate::Polar(Distance::Meters(P()->wallWidth() / 2.0), m_mouse->getCurrentRotation()), m_mouse->getCurrentRotation());
+    });
+    addStep([=](){
+        if (crash && !m_mouse->didCrash()) {
+            m_mouse->setCrashed();
+        }
+    });
 }
 
 } // namespace mms
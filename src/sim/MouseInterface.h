@@ -3,12 +3,18 @@
 #include <QMap>
 #include <QObject>
 #include <QPair>
+#include <QQueue>
+#include <QSet>
+
+#include <functional>
 
 #include "DynamicMouseAlgorithmOptions.h"
 #include "InterfaceType.h"
 #include "MazeView.h"
+#include "Model.h"
 #include "Mouse.h"
 #include "Param.h"
+#include "units/Duration.h"
 
 #define ENSURE_DISCRETE_INTERFACE ensureDiscreteInterface(__func__);
 #define ENSURE_CONTINUOUS_INTERFACE ensureContinuousInterface(__func__);
@@ -20,6 +26,12 @@
 
 namespace mms {
 
+// Movements never block: a movement is a sequence of steps, and each step
+// that moves the mouse registers a completion condition with the model and
+// returns. The next step runs once the model reports that the condition
+// holds, and the response is sent once the last step is done. Thus the
+// interface can share an event loop with anything else, including the
+// interfaces of other algorithms.
 class MouseInterface : public QObject {
 
     Q_OBJECT
@@ -29,19 +41,36 @@ public:
     MouseInterface(
         const Maze* maze,
         Mouse* mouse,
-        MazeView* view);
+        MazeView* view,
+        Model* model);
 
     // Called when the algo process writes to stdout
     void handleStandardOutput(QString output);
 
-    // Called when the algo started successfully
-    void emitMouseAlgoStarted();
+    // Called for each command that the algo process writes to stderr; the
+    // response, if any, is emitted via the response() signal. Commands that
+    // arrive during a movement are handled, in order, once it's done. A
+    // command may be prefixed with a request ID ("#<id> "), which is then
+    // prefixed to its response. Movements that are tagged may also be
+    // asynchronous ("#<id> async <movement>"), in which case commands that
+    // aren't movements are handled while they're in progress, and their
+    // response is the notification that they're done.
+    void handleCommand(const QString& command);
+
+    // Execute a request, return a response; for movements, this returns a
+    // null string, and the response is emitted once the movement is done
+    QString dispatch(const QString& command);
 
-    // Called when the algo process could not start
-    void emitMouseAlgoCannotStart(QString string);
+    // Commands that are acknowledged but not executed, so that options set
+    // by the simulator can't be changed by the algorithm
+    void setIgnoredCommands(const QSet<QString>& functions);
 
-    // Execute a request, return a response
-    QString dispatch(const QString& command);
+    // The algorithm's process, whose CPU time is charged to the sim clock if
+    // the charge-algo-cpu-time param is set: each command takes effect only
+    // once the sim time has caught up with the time the algorithm spent
+    // computing it (scaled by host-to-mcu-speed-ratio), while the mouse
+    // keeps doing whatever it was doing
+    void setAlgoProcessId(qint64 pid);
 
     // Request that the mouse algorithm exit
     void requestStop();
@@ -58,14 +87,17 @@ signals:
     // Emit sanitized algorithm output
     void algoOutput(QString output);
 
+    // The response to a command, to be written to the algorithm
+    void response(QString response);
+
     // An algorithm acknowledged an input button
     void inputButtonWasAcknowledged(int button);
 
-    // The algorithm started as expected
-    void mouseAlgoStarted();
+    // Emitted (from the model thread) when a motion is complete
+    void motionComplete();
 
-    // The algorithm could not be started
-    void mouseAlgoCannotStart(QString errorString);
+    // Emitted (from the model thread) when the first held command is due
+    void heldCommandDue();
 
 private:
 
@@ -81,8 +113,15 @@ private:
     // Misc functions
     double getRandom();
     int millis(); // # of milliseconds of sim time (adjusted based on sim speed) that have passed
+    qint64 micros(); // # of microseconds of sim time (adjusted based on sim speed) that have passed
     void delay(int milliseconds); // # of milliseconds of sim time (adjusted based on sim speed)
 
+    // Periodic timer, in microseconds of sim time; a period of zero disarms
+    // it. Waiting for the timer responds at exactly the next deadline, with
+    // the deadline (in microseconds of sim time).
+    void setTimer(int periodUs);
+    void waitForTimer();
+
     // Tile color
     void setTileColor(int x, int y, char color);
     void clearTileColor(int x, int y);
@@ -171,6 +210,16 @@ private:
     void diagonalRightLeft(int count);
     void diagonalRightRight(int count);
 
+    // Executes a whole sequence of moves back to back, without stopping the
+    // wheels in between, and returns the number of moves that will be
+    // executed; this is less than the number of moves in the path if one of
+    // them would crash, and -1 if the path is malformed. The path is written
+    // with one letter per move: F<count> (forward), L and R (turns), UL and
+    // UR (turn arounds), and D<LL|LR|RL|RR><count> (diagonals). Whether the
+    // moves end at the centers or the edges of tiles, like the commands they
+    // stand for, depends on useTileEdgeMovements().
+    int executePath(const QString& path);
+
     // ----- Omniscience methods ----- //
 
     int currentXTile();
@@ -187,6 +236,7 @@ private:
     const Maze* m_maze;
     Mouse* m_mouse;
     MazeView* m_view;
+    Model* m_model;
 
     // The interface type (DISCRETE or CONTINUOUS)
     InterfaceType m_interfaceType;
@@ -198,6 +248,56 @@ private:
     // Whether or a stop was requested
     bool m_stopRequested;
 
+    // The steps of the movement that's in progress, whether one of them is
+    // waiting on the model, and the response to send once they're all done
+    QQueue<std::function<void()>> m_steps;
+    bool m_moving;
+    bool m_inMotion;
+    QString m_movementResponse;
+    QString m_movementTag;
+    bool m_movementAsync;
+
+    // The remaining motions of a path; each one starts (on the model thread)
+    // right as the one before it completes, without stopping the wheels
+    QQueue<std::function<void()>> m_pathMotions;
+    bool m_chainingMotion;
+
+    // The commands that move the mouse (or otherwise wait on the model, or
+    // can't happen during a movement), which run one at a time
+    static const QSet<QString> MOVEMENTS;
+
+    // A command, split into its request ID (if any), whether or not it's
+    // asynchronous, and the rest of it
+    struct Command {
+        QString tag;
+        bool async;
+        QString body;
+        QString function;
+        bool isMovement;
+    };
+    static Command parseCommand(const QString& command);
+
+    // Commands that are waiting for a movement, the request IDs of the
+    // asynchronous movements that aren't done yet, and commands that are
+    // acknowledged without being executed
+    QQueue<Command> m_queuedCommands;
+    QSet<QString> m_pendingAsyncMovements;
+    QSet<QString> m_ignoredCommands;
+    bool m_runningQueuedCommands;
+    void acceptCommand(const QString& command);
+    void runQueuedCommands();
+    void runCommand(const Command& command);
+
+    // For charging the algorithm's CPU time to the sim clock: the process,
+    // its CPU time as of the last command, the sim time that the algorithm
+    // has been charged up to, and the commands (with the sim times that
+    // they're due) that are held until the sim time catches up
+    qint64 m_algoPid;
+    double m_algoCpuSeconds;
+    Duration m_algoChargedUntil;
+    QQueue<QPair<Duration, QString>> m_heldCommands;
+    void releaseHeldCommands();
+
     // Whether or not the input buttons are pressed/acknowleged
     QMap<int, bool> m_inputButtonsPressed;
 
@@ -208,6 +308,11 @@ private:
     // doesn't travel too fast in DISCRETE mode
     double m_wheelSpeedFraction;
 
+    // The period and next deadline of the timer, if it's armed
+    bool m_timerArmed;
+    Duration m_timerPeriod;
+    Duration m_timerDeadline;
+
     // Cache of tiles, for making clearAll methods faster
     std::set<QPair<int, int>> m_tilesWithColor;
     std::set<QPair<int, int>> m_tilesWithText;
@@ -254,10 +359,32 @@ private:
     QPair<QPair<int, int>, Direction> getOpposingWall(
         QPair<QPair<int, int>, Direction> wall) const;
 
-    // Some helper abstractions for mouse movements
+    // Helpers for running the steps of a movement: the movement methods add
+    // steps, which only run once the steps before them are done (and so
+    // should look at the mouse's position when they run, not when they're
+    // added), and each step may start at most one motion
+    QString startMovement(const QString& response);
+    void emitResponse(const QString& tag, const QString& result);
+    void addStep(std::function<void()> step);
+    void runSteps();
+    void startMotion(
+        std::function<bool()> isComplete,
+        std::function<void()> onComplete);
+    void startMotionAt(
+        const Duration& deadline,
+        std::function<void()> onComplete);
+
+    // Some helper abstractions for mouse movements; each starts a motion,
+    // and so must be called from within a step. The versions that take the
+    // wheel speed fraction don't read it from the interface, and so can also
+    // start the motions of a path, on the model thread.
     void moveForwardTo(const Coordinate& destinationTranslation, const Angle& destinationRotation);
+    void moveForwardTo(const Coordinate& destinationTranslation, const Angle& destinationRotation,
+        double wheelSpeedFraction);
     void arcTo(const Coordinate& destinationTranslation, const Angle& destinationRotation,
         const Distance& radius, double extraWheelSpeedFraction);
+    void arcTo(const Coordinate& destinationTranslation, const Angle& destinationRotation,
+        const Distance& radius, double extraWheelSpeedFraction, double wheelSpeedFraction);
     void turnTo(const Coordinate& destinationTranslation, const Angle& destinationRotation);
 
     // Returns the angle with from "from" to "to", with values in [-180, 180) degrees
@@ -2,11 +2,13 @@
 
 #include <QDebug>
 #include <QFile>
+#include <QTextStream>
 #include <QVector>
 
 #include "Assert.h"
 #include "EncoderType.h"
 #include "GeometryUtilities.h"
+#include "SensorType.h"
 #include "SimUtilities.h"
 #include "units/AngularVelocity.h"
 
@@ -37,6 +39,8 @@ const QString MouseParser::SENSOR_TAG = "Sensor";
 const QString MouseParser::RADIUS_TAG = "Radius";
 const QString MouseParser::RANGE_TAG = "Range";
 const QString MouseParser::HALF_WIDTH_TAG = "Half-Width";
+const QString MouseParser::SENSOR_TYPE_TAG = "Sensor-Type";
+const QString MouseParser::THRESHOLD_TAG = "Threshold";
 
 MouseParser::MouseParser(const QString& filePath, bool* success) :
         m_forwardDirection(Angle::Radians(0)),
@@ -187,9 +191,19 @@ QMap<QString, Sensor> MouseParser::getSensors(
         QDomElement sensor = elementList.at(i).toElement();
 
         QString name = getNameIfNonemptyAndUnique("sensor", sensor, sensors, success);
+        SensorType type = getSensorTypeIfValid(sensor, success);
         double radius = getDoubleIfHasDoubleAndNonNegative(sensor, RADIUS_TAG, success);
         double range = getDoubleIfHasDoubleAndNonNegative(sensor, RANGE_TAG, success);
-        double halfWidth = getDoubleIfHasDoubleAndNonNegative(sensor, HALF_WIDTH_TAG, success);
+        // Only the area sensors have a width, and only the digital sensors
+        // have a threshold, which defaults to the range
+        double halfWidth = 0.0;
+        if (type == SensorType::ANALOG) {
+            halfWidth = getDoubleIfHasDoubleAndNonNegative(sensor, HALF_WIDTH_TAG, success);
+        }
+        double threshold = range;
+        if (type == SensorType::DIGITAL && !sensor.firstChildElement(THRESHOLD_TAG).isNull()) {
+            threshold = getDoubleIfHasDoubleAndNonNegative(sensor, THRESHOLD_TAG, success);
+        }
         QDomElement position = getContainerElement(sensor, POSITION_TAG, success);
         double x = getDoubleIfHasDouble(position, X_TAG, success);
         double y = getDoubleIfHasDouble(position, Y_TAG, success);
@@ -199,9 +213,11 @@ QMap<QString, Sensor> MouseParser::getSensors(
             sensors.insert(
                 name,
                 Sensor(
+                    type,
                     Distance::Meters(radius),
                     Distance::Meters(range), 
                     Angle::Degrees(halfWidth),
+                    Distance::Meters(threshold),
                     alignVertex(
                         Coordinate::Cartesian(Distance::Meters(x), Distance::Meters(y)),
                         alignmentTranslation,
@@ -215,6 +231,62 @@ QMap<QString, Sensor> MouseParser::getSensors(
     return sensors;
 }
 
+int MouseParser::overrideField(
+        const QString& elementType,
+        const QString& name,
+        const QString& field,
+        double value) {
+
+    QString tag;
+    if (elementType == "wheel") {
+        tag = WHEEL_TAG;
+    }
+    else if (elementType == "sensor") {
+        tag = SENSOR_TAG;
+    }
+    else {
+        return 0;
+    }
+
+    int count = 0;
+    QDomNodeList elementList = m_root.elementsByTagName(tag);
+    for (int i = 0; i < elementList.size(); i += 1) {
+        QDomElement element = elementList.at(i).toElement();
+        if (name != "*" && element.firstChildElement(NAME_TAG).text() != name) {
+            continue;
+        }
+        for (const QString& part : field.split("/")) {
+            element = element.firstChildElement(part);
+        }
+        if (element.isNull()) {
+            continue;
+        }
+        // Replace the text of the field, leaving any comments in place
+        QDomNode child = element.firstChild();
+        while (!child.isNull()) {
+            QDomNode next = child.nextSibling();
+            if (child.isText()) {
+                element.removeChild(child);
+            }
+            child = next;
+        }
+        element.appendChild(m_doc.createTextNode(QString::number(value, 'g', 17)));
+        count += 1;
+    }
+    return count;
+}
+
+bool MouseParser::save(const QString& filePath) const {
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qWarning() << "Unable to open file" << filePath;
+        return false;
+    }
+    QTextStream stream(&file);
+    m_doc.save(stream, 4);
+    return true;
+}
+
 double MouseParser::getDoubleIfHasDouble(const QDomElement& element, const QString& tag, bool* success) {
     QString valueString = element.firstChildElement(tag).text();
     if (!SimUtilities::isDouble(valueString)) {
@@ -270,6 +342,31 @@ EncoderType MouseParser::getEncoderTypeIfValid(const QDomElement& element, bool*
     return encoderType;
 }
 
+SensorType MouseParser::getSensorTypeIfValid(const QDomElement& element, bool* success) {
+    // Sensors without a type are area sensors, as they always have been
+    QDomElement typeElement = element.firstChildElement(SENSOR_TYPE_TAG);
+    if (typeElement.isNull()) {
+        return SensorType::ANALOG;
+    }
+    SensorType sensorType = SensorType::ANALOG;
+    QString sensorTypeString = typeElement.text();
+    if (STRING_TO_SENSOR_TYPE().contains(sensorTypeString)) {
+        sensorType = STRING_TO_SENSOR_TYPE().value(sensorTypeString);
+    }
+    else {
+        qWarning().noquote().nospace()
+            << "The sensor type \"" << sensorTypeString << "\" is not valid."
+            << " The only valid sensor types are \""
+            << SENSOR_TYPE_TO_STRING().value(SensorType::ANALOG)
+            << "\", \""
+            << SENSOR_TYPE_TO_STRING().value(SensorType::DIGITAL)
+            << "\", and \""
+            << SENSOR_TYPE_TO_STRING().value(SensorType::DISTANCE) << "\".";
+        *success = false;
+    }
+    return sensorType;
+}
+
 Coordinate MouseParser::alignVertex(
     const Coordinate& vertex,
     const Coordinate& alignmentTranslation,
@@ -40,6 +40,18 @@ public:
         const Maze& maze,
         bool* success);
 
+    // Overrides a field (e.g., "Max-Speed", or "Position/X") of each "wheel"
+    // or "sensor" with the given name ("*" for all of them), so that variants
+    // of a mouse can be generated. Returns the number of fields overridden.
+    int overrideField(
+        const QString& elementType,
+        const QString& name,
+        const QString& field,
+        double value);
+
+    // Writes the (possibly overridden) mouse to a file
+    bool save(const QString& filePath) const;
+
 private:
     QDomDocument m_doc;
     QDomElement m_root;
@@ -51,6 +63,7 @@ private:
         const QDomElement& element, const QString& tag, bool* success);
     QDomElement getContainerElement(const QDomElement& element, const QString& tag, bool* success);
     EncoderType getEncoderTypeIfValid(const QDomElement& element, bool* success);
+    SensorType getSensorTypeIfValid(const QDomElement& element, bool* success);
 
     Coordinate alignVertex(
         const Coordinate& vertex,
@@ -79,6 +92,8 @@ private:
     static const QString RADIUS_TAG;
     static const QString RANGE_TAG;
     static const QString HALF_WIDTH_TAG;
+    static const QString SENSOR_TYPE_TAG;
+    static const QString THRESHOLD_TAG;
 
     template<class T>
     QString getNameIfNonemptyAndUnique(
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+#include "units/Angle.h"
+#include "units/Coordinate.h"
+
+namespace mms {
+
+// The state of the mouse at a single instant, published at the end of each
+// update (or reset) so that readers never mix data from two ticks
+struct MouseSnapshot {
+    Coordinate translation;
+    Angle rotation;
+    // For each sensor, the position of the sensor followed by the points at
+    // which its rays hit the maze (or reached their max range)
+    QVector<QVector<Coordinate>> sensorViews;
+    // The reading of each sensor, by name
+    QMap<QString, double> sensorReadings;
+};
+
+} // namespace mms
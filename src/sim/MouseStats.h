@@ -3,6 +3,7 @@
 #include <QPair>
 #include <QSet>
 
+#include "ClearanceStats.h"
 #include "units/Duration.h"
 
 namespace mms {
@@ -12,6 +13,7 @@ struct MouseStats {
     Duration timeOfOriginDeparture = Duration::Seconds(-1);
     QSet<QPair<int, int>> traversedTileLocations;
     int closestDistanceToCenter = -1;
+    ClearanceStats clearance;
 };
 
 } // namespace mms
@@ -1,5 +1,6 @@
 #include "Param.h"
 
+#include "CatchUpPolicy.h"
 #include "Color.h"
 #include "Direction.h"
 #include "LayoutType.h"
@@ -124,6 +125,28 @@ Param::Param() {
         "number-of-circle-approximation-points", 8, 3, 30);
     m_numberOfSensorEdgePoints = ParamParser::getIntIfHasIntAndInRange(
         "number-of-sensor-edge-points", 3, 2, 10);
+    m_sampleHistorySeconds = ParamParser::getDoubleIfHasDoubleAndInRange(
+        "sample-history-seconds", 600.0, 10.0, 14400.0);
+    m_simTimeStep = ParamParser::getDoubleIfHasDoubleAndInRange(
+        "sim-time-step", 0.001, 0.0001, 0.02);
+    m_realTimeMode = ParamParser::getBoolIfHasBool(
+        "real-time-mode", false);
+    m_realTimeCpu = ParamParser::getIntIfHasIntAndInRange(
+        "real-time-cpu", -1, -1, 1023);
+    m_realTimePriority = ParamParser::getIntIfHasIntAndInRange(
+        "real-time-priority", 50, 1, 99);
+    m_catchUpPolicy = ParamParser::getStringIfHasStringAndIsCatchUpPolicy(
+        "catch-up-policy", CATCH_UP_POLICY_TO_STRING().value(CatchUpPolicy::BURST));
+    m_chargeAlgoCpuTime = ParamParser::getBoolIfHasBool(
+        "charge-algo-cpu-time", false);
+    m_hostToMcuSpeedRatio = ParamParser::getDoubleIfHasDoubleAndInRange(
+        "host-to-mcu-speed-ratio", 1.0, 0.001, 1000.0);
+    m_trailPointSpacing = ParamParser::getDoubleIfHasDoubleAndInRange(
+        "trail-point-spacing", 0.005, 0.001, 0.1);
+    m_trailLength = ParamParser::getIntIfHasIntAndInRange(
+        "trail-length", 65536, 256, 4194304);
+    m_trailMaxSpeed = ParamParser::getDoubleIfHasDoubleAndInRange(
+        "trail-max-speed", 3.0, 0.1, 20.0);
 
     // Maze Parameters
     m_wallWidth = ParamParser::getDoubleIfHasDoubleAndInRange(
@@ -134,6 +157,16 @@ Param::Param() {
         "maze-mirrored", false);
     m_mazeRotations = ParamParser::getIntIfHasIntAndInRange(
         "maze-rotations", 0, 0, 3);
+    m_clearanceFieldResolution = ParamParser::getDoubleIfHasDoubleAndInRange(
+        "clearance-field-resolution", 0.004, 0.001, 0.02);
+
+    // Telemetry Parameters
+    m_telemetrySocketName = ParamParser::getStringIfHasString(
+        "telemetry-socket-name", "");
+    m_telemetryUpdateRate = ParamParser::getIntIfHasIntAndInRange(
+        "telemetry-update-rate", 30, 1, 1000);
+    m_telemetryMaxBufferedBytes = ParamParser::getIntIfHasIntAndInRange(
+        "telemetry-max-buffered-bytes", 1 << 20, 1 << 10, 1 << 28);
 }
 
 int Param::defaultWindowWidth() {
@@ -228,6 +261,10 @@ double Param::defaultSimSpeed() {
     return m_defaultSimSpeed;
 }
 
+bool Param::collisionDetectionEnabled() {
+    return m_collisionDetectionEnabled;
+}
+
 char Param::defaultTileTextCharacter() {
     return m_defaultTileTextCharacter;
 }
@@ -244,6 +281,50 @@ int Param::numberOfSensorEdgePoints() {
     return m_numberOfSensorEdgePoints;
 }
 
+double Param::sampleHistorySeconds() {
+    return m_sampleHistorySeconds;
+}
+
+double Param::simTimeStep() {
+    return m_simTimeStep;
+}
+
+bool Param::realTimeMode() {
+    return m_realTimeMode;
+}
+
+int Param::realTimeCpu() {
+    return m_realTimeCpu;
+}
+
+int Param::realTimePriority() {
+    return m_realTimePriority;
+}
+
+QString Param::catchUpPolicy() {
+    return m_catchUpPolicy;
+}
+
+bool Param::chargeAlgoCpuTime() {
+    return m_chargeAlgoCpuTime;
+}
+
+double Param::hostToMcuSpeedRatio() {
+    return m_hostToMcuSpeedRatio;
+}
+
+double Param::trailPointSpacing() {
+    return m_trailPointSpacing;
+}
+
+int Param::trailLength() {
+    return m_trailLength;
+}
+
+double Param::trailMaxSpeed() {
+    return m_trailMaxSpeed;
+}
+
 double Param::wallWidth() {
     return m_wallWidth;
 }
@@ -260,4 +341,20 @@ int Param::mazeRotations() {
     return m_mazeRotations;
 }
 
+double Param::clearanceFieldResolution() {
+    return m_clearanceFieldResolution;
+}
+
+QString Param::telemetrySocketName() {
+    return m_telemetrySocketName;
+}
+
+int Param::telemetryUpdateRate() {
+    return m_telemetryUpdateRate;
+}
+
+int Param::telemetryMaxBufferedBytes() {
+    return m_telemetryMaxBufferedBytes;
+}
+
 } // namespace mms
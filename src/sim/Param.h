@@ -52,7 +52,7 @@ public:
     // bool defaultPaused();
     double maxSimSpeed();
     double defaultSimSpeed();
-    // bool collisionDetectionEnabled();
+    bool collisionDetectionEnabled();
     // QString crashMessage();
     char defaultTileTextCharacter();
     double minSleepDuration();
@@ -62,12 +62,29 @@ public:
     // bool printLateCollisionDetections();
     int numberOfCircleApproximationPoints();
     int numberOfSensorEdgePoints();
+    double sampleHistorySeconds();
+    double simTimeStep();
+    bool realTimeMode();
+    int realTimeCpu();
+    int realTimePriority();
+    QString catchUpPolicy();
+    bool chargeAlgoCpuTime();
+    double hostToMcuSpeedRatio();
+    double trailPointSpacing();
+    int trailLength();
+    double trailMaxSpeed();
 
     // Maze parameters
     double wallWidth();
     double wallLength();
     bool mazeMirrored();
     int mazeRotations();
+    double clearanceFieldResolution();
+
+    // Telemetry parameters
+    QString telemetrySocketName();
+    int telemetryUpdateRate();
+    int telemetryMaxBufferedBytes();
 
 private:
 
@@ -124,12 +141,29 @@ private:
     bool m_printLateCollisionDetections;
     int m_numberOfCircleApproximationPoints;
     int m_numberOfSensorEdgePoints;
+    double m_sampleHistorySeconds;
+    double m_simTimeStep;
+    bool m_realTimeMode;
+    int m_realTimeCpu;
+    int m_realTimePriority;
+    QString m_catchUpPolicy;
+    bool m_chargeAlgoCpuTime;
+    double m_hostToMcuSpeedRatio;
+    double m_trailPointSpacing;
+    int m_trailLength;
+    double m_trailMaxSpeed;
 
     // Maze parameters
     double m_wallWidth;
     double m_wallLength;
     bool m_mazeMirrored;
     int m_mazeRotations;
+    double m_clearanceFieldResolution;
+
+    // Telemetry parameters
+    QString m_telemetrySocketName;
+    int m_telemetryUpdateRate;
+    int m_telemetryMaxBufferedBytes;
 };
 
 } // namespace mms
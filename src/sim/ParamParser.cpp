@@ -1,6 +1,7 @@
 #include "ParamParser.h"
 
 #include "Assert.h"
+#include "CatchUpPolicy.h"
 #include "Color.h"
 #include "ConfigDialog.h"
 #include "ConfigDialogField.h"
@@ -170,6 +171,10 @@ int ParamParser::getIntIfHasIntAndInRange(const QString& tag, int defaultValue,
     return getNumIfHasNumAndInRange("int", tag, defaultValue, min, max);
 }
 
+QString ParamParser::getStringIfHasStringAndIsCatchUpPolicy(const QString& tag, const QString& defaultValue) {
+    return getStringIfHasStringAndIsSpecial("catch-up policy", tag, defaultValue, STRING_TO_CATCH_UP_POLICY());
+}
+
 QString ParamParser::getStringIfHasStringAndIsColor(const QString& tag, const QString& defaultValue) {
     return getStringIfHasStringAndIsSpecial("color", tag, defaultValue, STRING_TO_COLOR());
 }
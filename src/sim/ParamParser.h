@@ -44,6 +44,7 @@ public:
     static int getIntIfHasIntAndInRange(const QString& tag, int defaultValue, int min, int max);
 
     // If we can get a value and it's valid/special then return it, else return default
+    static QString getStringIfHasStringAndIsCatchUpPolicy(const QString& tag, const QString& defaultValue);
     static QString getStringIfHasStringAndIsColor(const QString& tag, const QString& defaultValue);
     static QString getStringIfHasStringAndIsDirection(const QString& tag, const QString& defaultValue);
     static QString getStringIfHasStringAndIsLayoutType(const QString& tag, const QString& defaultValue);
@@ -9,11 +9,13 @@
 
 namespace mms {
 
-Polygon::Polygon() {
+Polygon::Polygon() :
+    m_shape(PolygonShape::GENERAL) {
 }
 
 Polygon::Polygon(const Polygon& polygon) :
-    m_vertices(polygon.getVertices()) {
+    m_vertices(polygon.getVertices()),
+    m_shape(polygon.getShape()) {
     // If the polygon being copyed has already been triangulated, we should
     // grab the triangles, lest we have to re-triangulate in the future. If not,
     // we can be lazy, in case the triangles for this polygon aren't needed.
@@ -33,8 +35,9 @@ Polygon::Polygon(const Polygon& polygon) :
     }
 }
 
-Polygon::Polygon(QVector<Coordinate> vertices) :
+Polygon::Polygon(QVector<Coordinate> vertices, PolygonShape shape) :
     m_vertices(vertices),
+    m_shape(shape),
     // Postpone triangulation until we absolutely have to do it.
     m_triangles({}) {
     ASSERT_LE(3, m_vertices.size());
@@ -55,11 +58,15 @@ QVector<Coordinate> Polygon::getVertices() const {
 QVector<Triangle> Polygon::getTriangles() const {
     // Lazy initialization here
     if (m_triangles.size() == 0) {
-        m_triangles = triangulate(m_vertices);
+        m_triangles = triangulate(m_vertices, m_shape);
     }
     return m_triangles;
 }
 
+PolygonShape Polygon::getShape() const {
+    return m_shape;
+}
+
 Area Polygon::area() const {
 
     // See http://mathmodel.wolfram.com/PolygonArea.html
@@ -95,7 +102,7 @@ Polygon Polygon::translate(const Coordinate& translation) const {
         });
     }
 
-    return Polygon(vertices, triangles);
+    return Polygon(vertices, triangles, m_shape);
 }
 
 Polygon Polygon::rotateAroundPoint(const Angle& angle, const Coordinate& point) const {
@@ -114,11 +121,15 @@ Polygon Polygon::rotateAroundPoint(const Angle& angle, const Coordinate& point)
         });
     }
 
-    return Polygon(vertices, triangles);
+    return Polygon(vertices, triangles, m_shape);
 }
 
-Polygon::Polygon(QVector<Coordinate> vertices, QVector<Triangle> triangles) :
+Polygon::Polygon(
+        QVector<Coordinate> vertices,
+        QVector<Triangle> triangles,
+        PolygonShape shape) :
     m_vertices(vertices),
+    m_shape(shape),
     m_triangles(triangles) {
 }
 
@@ -126,7 +137,38 @@ bool Polygon::alreadyPerformedTriangulation() const {
     return 0 < m_triangles.size();
 }
 
-QVector<Triangle> Polygon::triangulate(QVector<Coordinate> vertices) {
+QVector<Triangle> Polygon::triangulate(
+        const QVector<Coordinate>& vertices,
+        PolygonShape shape) {
+    switch (shape) {
+        case PolygonShape::CONVEX:
+        case PolygonShape::FAN:
+            return triangulateFan(vertices);
+        case PolygonShape::GENERAL:
+            return triangulateEarClipping(vertices);
+    }
+    ASSERT_NEVER_RUNS();
+}
+
+QVector<Triangle> Polygon::triangulateFan(const QVector<Coordinate>& vertices) {
+
+    // Both convex polygons and fans are star-shaped around their first
+    // vertex, so the triangles (v0, vi, vi+1) exactly cover the polygon. Note
+    // that some of these triangles may be degenerate (e.g., when adjacent
+    // sensor rays hit the same wall), which is harmless for drawing.
+    QVector<Triangle> triangles;
+    triangles.reserve(vertices.size() - 2);
+    for (int i = 1; i < vertices.size() - 1; i += 1) {
+        triangles.append({
+            vertices.at(0),
+            vertices.at(i),
+            vertices.at(i + 1),
+        });
+    }
+    return triangles;
+}
+
+QVector<Triangle> Polygon::triangulateEarClipping(const QVector<Coordinate>& vertices) {
 
     // Populate the TPPLPoly
     TPPLPoly tpplPoly;
@@ -2,6 +2,7 @@
 
 #include <QVector>
 
+#include "PolygonShape.h"
 #include "Triangle.h"
 #include "units/Angle.h"
 #include "units/Area.h"
@@ -15,10 +16,11 @@ public:
 
     Polygon();
     Polygon(const Polygon& polygon);
-    Polygon(QVector<Coordinate> vertices);
+    Polygon(QVector<Coordinate> vertices, PolygonShape shape = PolygonShape::GENERAL);
 
     QVector<Coordinate> getVertices() const;
     QVector<Triangle> getTriangles() const;
+    PolygonShape getShape() const;
 
     Area area() const;
 
@@ -29,6 +31,10 @@ private:
 
     QVector<Coordinate> m_vertices;
 
+    // Convex and fan polygons can be triangulated in linear time, so we keep
+    // track of the hint in order to avoid ear clipping whenever possible
+    PolygonShape m_shape;
+
     // We're lazy about triangulation, since it's expensive and not always
     // necessary. The "mutable" keyword allows us to assign m_triangles in the
     // const function getTriangles().
@@ -38,7 +44,10 @@ private:
     // require re-triangulation. We keep it private since it's pretty easy to
     // abuse the fact that the triangles argument should be the triangulation
     // of the polygon specified by the vertices argument.
-    Polygon(QVector<Coordinate> vertices, QVector<Triangle> triangles);
+    Polygon(
+        QVector<Coordinate> vertices,
+        QVector<Triangle> triangles,
+        PolygonShape shape);
 
     // Tells us whether or not the polygon has already performed triangulation.
     // This is used in the copy constructor, and allows us to be lazy without
@@ -46,7 +55,15 @@ private:
     bool alreadyPerformedTriangulation() const;
 
     // Actually peforms the triangulation of the polygon.
-    static QVector<Triangle> triangulate(QVector<Coordinate> vertices);
+    static QVector<Triangle> triangulate(
+        const QVector<Coordinate>& vertices,
+        PolygonShape shape);
+
+    // Triangulates a convex or fan polygon around its first vertex, in O(n)
+    static QVector<Triangle> triangulateFan(const QVector<Coordinate>& vertices);
+
+    // Triangulates an arbitrary simple polygon via ear clipping, in O(n^2)
+    static QVector<Triangle> triangulateEarClipping(const QVector<Coordinate>& vertices);
 
 };
 
@@ -0,0 +1,18 @@
+#pragma once
+
+namespace mms {
+
+// A hint about the shape of a polygon, used to pick the cheapest correct
+// triangulation. If in doubt, use GENERAL - the other values are promises
+// made by the caller, and they aren't verified.
+enum class PolygonShape {
+    // Any simple polygon; triangulated by ear clipping (polypartition)
+    GENERAL,
+    // A convex polygon; every vertex sees every other vertex
+    CONVEX,
+    // A polygon that is star-shaped around its first vertex, with the
+    // remaining vertices sorted by angle (e.g., a sensor view)
+    FAN,
+};
+
+} // namespace mms
@@ -1,7 +1,14 @@
 #include "ProcessUtilities.h"
 
+#include <QFile>
 #include <QStringList>
 
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
 namespace mms {
 
 bool ProcessUtilities::start(
@@ -20,4 +27,51 @@ bool ProcessUtilities::start(
     return process->waitForStarted();
 }
 
+double ProcessUtilities::getFinishedChildrenCpuSeconds() {
+#ifdef _WIN32
+    return -1.0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_CHILDREN, &usage) != 0) {
+        return -1.0;
+    }
+    return (
+        usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1000000.0 +
+        usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1000000.0
+    );
+#endif
+}
+
+double ProcessUtilities::getProcessCpuSeconds(qint64 pid) {
+#ifdef _WIN32
+    return -1.0;
+#else
+    // The process's CPU-time clock has nanosecond resolution, so prefer it
+    // to /proc, which only counts whole clock ticks (usually 10 ms)
+    clockid_t clock;
+    struct timespec time;
+    if (
+        clock_getcpuclockid(static_cast<pid_t>(pid), &clock) == 0 &&
+        clock_gettime(clock, &time) == 0
+    ) {
+        return time.tv_sec + time.tv_nsec / 1000000000.0;
+    }
+
+    // The fields after the command (which is in parentheses, and may itself
+    // contain spaces) start with the state; utime and stime are 12 and 13
+    // fields after it
+    QFile file(QString("/proc/%1/stat").arg(pid));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return -1.0;
+    }
+    QString stat = QString(file.readAll());
+    QStringList fields = stat.mid(stat.lastIndexOf(')') + 2).split(' ');
+    if (fields.size() < 13) {
+        return -1.0;
+    }
+    double ticks = fields.at(11).toDouble() + fields.at(12).toDouble();
+    return ticks / sysconf(_SC_CLK_TCK);
+#endif
+}
+
 } // namespace mms
@@ -15,6 +15,14 @@ public:
         const QString& command,
         const QString& directory,
         QProcess* process);
+
+    // The CPU time (user and system) used by every child process that has
+    // exited and been waited for, or -1 if the platform doesn't report it
+    static double getFinishedChildrenCpuSeconds();
+
+    // The CPU time (user and system) used so far by a running process, or -1
+    // if the platform doesn't report it
+    static double getProcessCpuSeconds(qint64 pid);
 };
 
 } // namespace mms
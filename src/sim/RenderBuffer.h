@@ -0,0 +1,89 @@
+#pragma once
+
+#include <QPair>
+
+#include <algorithm>
+#include <vector>
+
+#include "Assert.h"
+
+namespace mms {
+
+// The CPU-side copy of a vertex buffer. Unlike a QVector, it's never
+// implicitly shared, so writing to an element never checks for (or does) a
+// detach. It also keeps track of the range of elements that have changed
+// since the map last took it, so that the map only has to upload that range
+// to the GPU, rather than the whole buffer on every frame.
+template<typename T>
+class RenderBuffer {
+
+public:
+
+    RenderBuffer() : m_dirtyBegin(0), m_dirtyEnd(0) {
+    }
+
+    // Copying the buffer is never what you want
+    RenderBuffer(const RenderBuffer&) = delete;
+    RenderBuffer& operator=(const RenderBuffer&) = delete;
+
+    int size() const {
+        return static_cast<int>(m_elements.size());
+    }
+
+    const T* data() const {
+        return m_elements.data();
+    }
+
+    // Both of these mark the element as changed
+    void append(const T& element) {
+        m_elements.push_back(element);
+        markDirty(size() - 1, size());
+    }
+    T* write(int index) {
+        ASSERT_LE(0, index);
+        ASSERT_LT(index, size());
+        markDirty(index, index + 1);
+        return &m_elements[index];
+    }
+
+    void clear() {
+        m_elements.clear();
+        m_dirtyBegin = 0;
+        m_dirtyEnd = 0;
+    }
+
+    // Marks every element as changed, e.g., when the map's copy of the
+    // buffer is from another view
+    void markAllDirty() {
+        markDirty(0, size());
+    }
+
+    // Returns the range [first, second) of elements that changed since the
+    // last time this was called, which is empty if nothing changed
+    QPair<int, int> takeDirtyRange() {
+        QPair<int, int> range = {m_dirtyBegin, m_dirtyEnd};
+        m_dirtyBegin = 0;
+        m_dirtyEnd = 0;
+        return range;
+    }
+
+private:
+
+    std::vector<T> m_elements;
+    int m_dirtyBegin;
+    int m_dirtyEnd;
+
+    void markDirty(int begin, int end) {
+        if (m_dirtyBegin == m_dirtyEnd) {
+            m_dirtyBegin = begin;
+            m_dirtyEnd = end;
+        }
+        else {
+            m_dirtyBegin = std::min(m_dirtyBegin, begin);
+            m_dirtyEnd = std::max(m_dirtyEnd, end);
+        }
+    }
+
+};
+
+} // namespace mms
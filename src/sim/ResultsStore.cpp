@@ -0,0 +1,340 @@
+#include "ResultsStore.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QProcess>
+#include <QSqlDatabase>
+#include <QSqlError>
+#include <QSqlQuery>
+#include <QVariant>
+
+namespace mms {
+
+const int ResultsStore::BATCH_SIZE = 256;
+
+ResultsStore::ResultsStore(const QString& filePath) :
+        m_connectionName(QString("results-%1").arg(
+            reinterpret_cast<quintptr>(this))),
+        m_isOpen(false) {
+
+    QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", m_connectionName);
+    db.setDatabaseName(filePath);
+    if (!db.open()) {
+        qWarning().noquote()
+            << "Unable to open the results database" << filePath
+            << "-" << db.lastError().text();
+        return;
+    }
+
+    // Favor throughput over durability; losing the last few rows of a crashed
+    // sweep is fine, but waiting on the disk for every transaction is not
+    QSqlQuery query(db);
+    query.exec("PRAGMA journal_mode = WAL");
+    query.exec("PRAGMA synchronous = NORMAL");
+
+    QStringList statements = {
+        "CREATE TABLE IF NOT EXISTS runs ("
+        "    id INTEGER PRIMARY KEY,"
+        "    recorded_at TEXT NOT NULL,"
+        "    algo TEXT NOT NULL,"
+        "    algo_hash TEXT NOT NULL,"
+        "    maze TEXT NOT NULL,"
+        "    maze_hash TEXT NOT NULL,"
+        "    mouse_file_hash TEXT NOT NULL,"
+        "    seed INTEGER NOT NULL,"
+        "    params TEXT NOT NULL,"
+        "    status TEXT NOT NULL,"
+        "    best_time_to_center REAL NOT NULL,"
+        "    tiles_traversed INTEGER NOT NULL,"
+        "    closest_distance_to_center INTEGER NOT NULL,"
+        "    crashed INTEGER NOT NULL,"
+        "    exit_code INTEGER NOT NULL,"
+        "    sim_seconds REAL NOT NULL,"
+        "    real_seconds REAL NOT NULL,"
+        "    cpu_seconds REAL NOT NULL"
+        ")",
+        "CREATE INDEX IF NOT EXISTS runs_by_algo "
+        "ON runs (algo, algo_hash, maze_hash)",
+        "CREATE INDEX IF NOT EXISTS runs_by_maze "
+        "ON runs (maze_hash, mouse_file_hash)",
+    };
+    for (const QString& statement : statements) {
+        if (!query.exec(statement)) {
+            qWarning().noquote()
+                << "Unable to create the results tables -"
+                << query.lastError().text();
+            return;
+        }
+    }
+    m_isOpen = true;
+}
+
+ResultsStore::~ResultsStore() {
+    flush();
+    {
+        QSqlDatabase db = QSqlDatabase::database(m_connectionName, false);
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(m_connectionName);
+}
+
+bool ResultsStore::isOpen() const {
+    return m_isOpen;
+}
+
+void ResultsStore::insert(const RunRecord& record) {
+    m_pending.append(record);
+    if (BATCH_SIZE <= m_pending.size()) {
+        flush();
+    }
+}
+
+bool ResultsStore::flush() {
+
+    if (!m_isOpen || m_pending.isEmpty()) {
+        return m_pending.isEmpty();
+    }
+
+    QSqlDatabase db = QSqlDatabase::database(m_connectionName);
+    db.transaction();
+    QSqlQuery query(db);
+    query.prepare(
+        "INSERT INTO runs ("
+        "    recorded_at, algo, algo_hash, maze, maze_hash, mouse_file_hash,"
+        "    seed, params, status, best_time_to_center, tiles_traversed,"
+        "    closest_distance_to_center, crashed, exit_code, sim_seconds,"
+        "    real_seconds, cpu_seconds"
+        ") VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)"
+    );
+    QString recordedAt = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    for (const RunRecord& record : m_pending) {
+        query.addBindValue(recordedAt);
+        query.addBindValue(record.algo);
+        query.addBindValue(record.algoHash);
+        query.addBindValue(record.maze);
+        query.addBindValue(record.mazeHash);
+        query.addBindValue(record.mouseFileHash);
+        query.addBindValue(record.seed);
+        query.addBindValue(record.params);
+        query.addBindValue(record.status);
+        query.addBindValue(record.bestTimeToCenter);
+        query.addBindValue(record.tilesTraversed);
+        query.addBindValue(record.closestDistanceToCenter);
+        query.addBindValue(record.crashed ? 1 : 0);
+        query.addBindValue(record.exitCode);
+        query.addBindValue(record.simSeconds);
+        query.addBindValue(record.realSeconds);
+        query.addBindValue(record.cpuSeconds);
+        if (!query.exec()) {
+            qWarning().noquote()
+                << "Unable to store a run -" << query.lastError().text();
+            db.rollback();
+            return false;
+        }
+    }
+    if (!db.commit()) {
+        qWarning().noquote()
+            << "Unable to store the runs -" << db.lastError().text();
+        return false;
+    }
+    m_pending.clear();
+    return true;
+}
+
+QMap<QString, ResultsStore::Summary> ResultsStore::summarize(
+        const QString& algo) const {
+
+    QMap<QString, Summary> summaries;
+    if (!m_isOpen) {
+        return summaries;
+    }
+
+    QString name = algo.section('@', 0, 0);
+    QString hash = algo.section('@', 1);
+
+    QSqlQuery query(QSqlDatabase::database(m_connectionName));
+    query.prepare(
+        "SELECT"
+        "    maze_hash,"
+        "    MIN(maze),"
+        "    COUNT(*),"
+        "    SUM(best_time_to_center >= 0),"
+        "    AVG(CASE WHEN best_time_to_center >= 0 THEN best_time_to_center END),"
+        "    MIN(CASE WHEN best_time_to_center >= 0 THEN best_time_to_center END) "
+        "FROM runs "
+        "WHERE algo = ? AND algo_hash LIKE ? AND status != 'error' "
+        "GROUP BY maze_hash"
+    );
+    query.addBindValue(name);
+    query.addBindValue(hash + "%");
+    if (!query.exec()) {
+        qWarning().noquote()
+            << "Unable to query the runs -" << query.lastError().text();
+        return summaries;
+    }
+    while (query.next()) {
+        Summary summary;
+        summary.maze = query.value(1).toString();
+        summary.runs = query.value(2).toInt();
+        summary.solved = query.value(3).toInt();
+        if (!query.value(4).isNull()) {
+            summary.meanBestTime = query.value(4).toDouble();
+            summary.minBestTime = query.value(5).toDouble();
+        }
+        summaries.insert(query.value(0).toString(), summary);
+    }
+    return summaries;
+}
+
+QString ResultsStore::hashFile(const QString& filePath) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QString();
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(&file);
+    return hash.result().toHex();
+}
+
+QString ResultsStore::hashAlgoDir(const QString& dirPath) {
+
+    // Prefer the commit, since that's what people refer to, and mark it if
+    // there are uncommitted changes
+    QProcess git;
+    git.setWorkingDirectory(dirPath);
+    git.start("git", {"rev-parse", "HEAD"});
+    if (git.waitForFinished() && git.exitCode() == 0) {
+        QString commit = QString(git.readAllStandardOutput()).trimmed();
+        git.start("git", {"status", "--porcelain", "--untracked-files=no"});
+        if (git.waitForFinished() && !git.readAllStandardOutput().trimmed().isEmpty()) {
+            commit += "-dirty";
+        }
+        return commit;
+    }
+
+    // Otherwise, hash the names and contents of the files, in a fixed order
+    QStringList files;
+    QDirIterator it(dirPath, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        files.append(QDir(dirPath).relativeFilePath(it.next()));
+    }
+    files.sort();
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    for (const QString& file : files) {
+        hash.addData(file.toUtf8());
+        hash.addData(hashFile(QDir(dirPath).filePath(file)).toUtf8());
+    }
+    return "sha1:" + hash.result().toHex();
+}
+
+int ResultsStore::compare(
+        const QString& filePath,
+        const QString& algoA,
+        const QString& algoB,
+        const QStringList& mazePaths) {
+
+    if (!QFileInfo(filePath).isFile()) {
+        qWarning().noquote() << "The results database" << filePath << "doesn't exist";
+        return 1;
+    }
+    ResultsStore store(filePath);
+    if (!store.isOpen()) {
+        return 1;
+    }
+    QMap<QString, Summary> a = store.summarize(algoA);
+    QMap<QString, Summary> b = store.summarize(algoB);
+
+    // The mazes are identified by their contents, so that renamed or moved
+    // files still match
+    QStringList mazeHashes;
+    for (const QString& path : mazePaths) {
+        QStringList files;
+        if (QFileInfo(path).isDir()) {
+            QDir dir(path);
+            for (const QString& name : dir.entryList(QDir::Files, QDir::Name)) {
+                files.append(dir.filePath(name));
+            }
+        }
+        else {
+            files.append(path);
+        }
+        for (const QString& file : files) {
+            QString hash = hashFile(file);
+            if (hash.isEmpty()) {
+                qWarning().noquote() << "Unable to read the maze" << file;
+                return 1;
+            }
+            mazeHashes.append(hash);
+        }
+    }
+    if (mazePaths.isEmpty()) {
+        for (const QString& hash : a.keys()) {
+            if (b.contains(hash)) {
+                mazeHashes.append(hash);
+            }
+        }
+    }
+
+    auto formatSolved = [](const Summary& summary) {
+        return QString("%1/%2").arg(summary.solved).arg(summary.runs);
+    };
+    auto formatTime = [](double seconds) {
+        return seconds < 0 ? QString("-") : QString::number(seconds, 'f', 2);
+    };
+
+    QString table = QString("%1 %2 %3 %4 %5 %6\n").arg(
+        QString("Maze").leftJustified(32),
+        QString("A solved").rightJustified(9),
+        QString("A time").rightJustified(9),
+        QString("B solved").rightJustified(9),
+        QString("B time").rightJustified(9),
+        QString("B - A").rightJustified(9)
+    );
+    int runsA = 0;
+    int runsB = 0;
+    int solvedA = 0;
+    int solvedB = 0;
+    int winsA = 0;
+    int winsB = 0;
+    for (const QString& hash : mazeHashes) {
+        Summary summaryA = a.value(hash);
+        Summary summaryB = b.value(hash);
+        QString maze = !summaryA.maze.isEmpty() ? summaryA.maze : summaryB.maze;
+        runsA += summaryA.runs;
+        runsB += summaryB.runs;
+        solvedA += summaryA.solved;
+        solvedB += summaryB.solved;
+        bool bothSolved = (0 <= summaryA.meanBestTime && 0 <= summaryB.meanBestTime);
+        double difference = 0.0;
+        if (bothSolved) {
+            difference = summaryB.meanBestTime - summaryA.meanBestTime;
+            winsA += (0 < difference ? 1 : 0);
+            winsB += (difference < 0 ? 1 : 0);
+        }
+        table += QString("%1 %2 %3 %4 %5 %6\n").arg(
+            (maze.isEmpty() ? hash.left(12) : QFileInfo(maze).fileName()).leftJustified(32),
+            formatSolved(summaryA).rightJustified(9),
+            formatTime(summaryA.meanBestTime).rightJustified(9),
+            formatSolved(summaryB).rightJustified(9),
+            formatTime(summaryB.meanBestTime).rightJustified(9),
+            (!bothSolved ? QString("-") : QString::number(difference, 'f', 2)).rightJustified(9)
+        );
+    }
+
+    qInfo().noquote() << "A:" << algoA;
+    qInfo().noquote() << "B:" << algoB;
+    qInfo().noquote() << table.trimmed();
+    qInfo().noquote() << QString(
+        "Over %1 mazes: A solved %2/%3 runs, B solved %4/%5 runs; "
+        "A was faster on %6 mazes, B on %7"
+    ).arg(mazeHashes.size()).arg(solvedA).arg(runsA).arg(solvedB).arg(runsB)
+     .arg(winsA).arg(winsB);
+    return 0;
+}
+
+} // namespace mms
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+#include "RunRecord.h"
+
+namespace mms {
+
+// A SQLite database of runs, so that runs can be compared across versions of
+// an algorithm. Each algorithm version, maze, and mouse file is identified
+// by a hash of its contents, rather than by its path or name.
+class ResultsStore {
+
+public:
+
+    // Rows are buffered, and written in one transaction per this many rows
+    static const int BATCH_SIZE;
+
+    // The results of an algorithm on a single maze
+    struct Summary {
+        QString maze;
+        int runs = 0;
+        int solved = 0;
+        double meanBestTime = -1.0;
+        double minBestTime = -1.0;
+    };
+
+    ResultsStore(const QString& filePath);
+    ~ResultsStore();
+
+    bool isOpen() const;
+
+    void insert(const RunRecord& record);
+    bool flush();
+
+    // The results of every run of an algorithm, by maze hash; the algorithm
+    // may be given as "name@hash" to select a single version of it, where
+    // the hash can be abbreviated
+    QMap<QString, Summary> summarize(const QString& algo) const;
+
+    // The hash of a file's contents, and of an algorithm's directory (the
+    // git commit if the directory is in a repository, or else its contents)
+    static QString hashFile(const QString& filePath);
+    static QString hashAlgoDir(const QString& dirPath);
+
+    // Prints a comparison of two algorithms on a set of mazes (or on every
+    // maze that both have been run on, if there are no maze arguments)
+    static int compare(
+        const QString& filePath,
+        const QString& algoA,
+        const QString& algoB,
+        const QStringList& mazePaths);
+
+private:
+
+    QString m_connectionName;
+    bool m_isOpen;
+    QVector<RunRecord> m_pending;
+};
+
+} // namespace mms
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <QString>
+
+namespace mms {
+
+// Everything that's stored about a single run of an algorithm on a maze
+struct RunRecord {
+
+    // What was run
+    QString algo;
+    QString algoHash;
+    QString maze;
+    QString mazeHash;
+    QString mouseFileHash;
+    int seed = 0;
+    QString params;
+
+    // How it went
+    QString status;
+    double bestTimeToCenter = -1.0;
+    int tilesTraversed = 0;
+    int closestDistanceToCenter = -1;
+    bool crashed = false;
+    int exitCode = 0;
+
+    // What it cost
+    double simSeconds = 0.0;
+    double realSeconds = 0.0;
+    double cpuSeconds = -1.0;
+};
+
+} // namespace mms
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <QPair>
+
+#include "Direction.h"
+#include "units/Angle.h"
+#include "units/Coordinate.h"
+#include "units/Duration.h"
+
+namespace mms {
+
+// A snapshot of the current (or most recent) run, which the model publishes
+// on every tick, so that reading it doesn't mean copying the set of
+// traversed tiles or querying the mouse
+struct RunStats {
+    bool hasMouse = false;
+    int tilesTraversed = 0;
+    int closestDistanceToCenter = -1;
+    Coordinate translation;
+    Angle rotation;
+    QPair<int, int> tile = {0, 0};
+    Direction direction = Direction::NORTH;
+    Duration elapsedSimTime = Duration::Seconds(0);
+    Duration timeOfOriginDeparture = Duration::Seconds(-1);
+    Duration bestTimeToCenter = Duration::Seconds(-1);
+    bool crashed = false;
+
+    // In meters, and only meaningful once the first clearance is recorded
+    bool hasClearance = false;
+    double clearance = 0.0;
+    double minClearance = 0.0;
+};
+
+} // namespace mms
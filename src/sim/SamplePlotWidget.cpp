@@ -0,0 +1,182 @@
+#include "SamplePlotWidget.h"
+
+#include <QPainter>
+#include <QPen>
+
+#include <algorithm>
+#include <limits>
+
+namespace mms {
+
+SamplePlotWidget::SamplePlotWidget(QWidget* parent) :
+    QWidget(parent),
+    m_secondsPerSample(1.0),
+    m_following(true),
+    m_end(0),
+    m_span(10000),
+    m_dragStartX(0),
+    m_dragStartEnd(0) {
+
+    setMinimumHeight(100);
+
+    // Repaint periodically, but only while following new samples
+    connect(&m_timer, &QTimer::timeout, this, [=](){
+        if (m_following && isVisible()) {
+            update();
+        }
+    });
+    m_timer.start(1000 / 30);
+}
+
+void SamplePlotWidget::setBuffers(
+        const QVector<QSharedPointer<const SampleRingBuffer>>& buffers,
+        double secondsPerSample) {
+    m_buffers = buffers;
+    m_secondsPerSample = secondsPerSample;
+    m_following = true;
+    m_span = static_cast<qint64>(10.0 / m_secondsPerSample);
+    update();
+}
+
+void SamplePlotWidget::paintEvent(QPaintEvent* event) {
+
+    Q_UNUSED(event);
+    QPainter painter(this);
+    painter.fillRect(rect(), Qt::black);
+    if (m_buffers.isEmpty() || width() <= 0) {
+        return;
+    }
+
+    qint64 end = getEnd();
+    qint64 begin = end - m_span;
+    int numColumns = width();
+    int laneHeight = height() / m_buffers.size();
+    QFontMetrics metrics = painter.fontMetrics();
+
+    for (int lane = 0; lane < m_buffers.size(); lane += 1) {
+
+        const SampleRingBuffer* buffer = m_buffers.at(lane).data();
+        int top = lane * laneHeight;
+        int bottom = top + laneHeight - 1;
+
+        // One min/max pair per pixel column, computed from the block summaries
+        QVector<QPair<float, float>> columns = buffer->getMinMax(begin, end, numColumns);
+
+        // Scale each lane to its own visible range
+        float min = std::numeric_limits<float>::max();
+        float max = std::numeric_limits<float>::lowest();
+        for (const QPair<float, float>& column : columns) {
+            if (column.first <= column.second) {
+                min = std::min(min, column.first);
+                max = std::max(max, column.second);
+            }
+        }
+        if (max < min) {
+            min = 0.0;
+            max = 0.0;
+        }
+        float range = (max - min == 0.0 ? 1.0 : max - min);
+        auto toY = [&](float value){
+            return bottom - static_cast<int>((value - min) / range * (laneHeight - 1));
+        };
+
+        // Draw each column as a vertical line from its min to its max, and
+        // bridge any gap to the previous column so the trace stays connected
+        painter.setPen(QPen(Qt::green, 1));
+        int previous = -1;
+        for (int x = 0; x < columns.size(); x += 1) {
+            const QPair<float, float>& column = columns.at(x);
+            if (column.second < column.first) {
+                continue;
+            }
+            int yMin = toY(column.first);
+            int yMax = toY(column.second);
+            painter.drawLine(x, yMin, x, yMax);
+            if (previous != -1) {
+                const QPair<float, float>& prev = columns.at(previous);
+                if (prev.second < column.first) {
+                    painter.drawLine(previous, toY(prev.second), x, yMin);
+                }
+                else if (column.second < prev.first) {
+                    painter.drawLine(previous, toY(prev.first), x, yMax);
+                }
+            }
+            previous = x;
+        }
+
+        // Label the lane with its name and visible range
+        painter.setPen(Qt::gray);
+        painter.drawLine(0, bottom, width(), bottom);
+        painter.setPen(Qt::white);
+        painter.drawText(4, top + metrics.ascent() + 2, QString("%1  [%2, %3]")
+            .arg(buffer->getName())
+            .arg(min, 0, 'g', 4)
+            .arg(max, 0, 'g', 4));
+    }
+
+    // Label the visible time window
+    painter.setPen(Qt::white);
+    QString right = QString("%1 s").arg(end * m_secondsPerSample, 0, 'f', 3);
+    painter.drawText(4, height() - metrics.descent() - 2,
+        QString("%1 s").arg(begin * m_secondsPerSample, 0, 'f', 3));
+    painter.drawText(width() - metrics.width(right) - 4, height() - metrics.descent() - 2, right);
+}
+
+void SamplePlotWidget::wheelEvent(QWheelEvent* event) {
+
+    double factor = (0 < event->angleDelta().y() ? 0.8 : 1.25);
+    qint64 span = std::max(
+        static_cast<qint64>(width() / 8),
+        static_cast<qint64>(m_span * factor));
+
+    // While following, the right edge stays live; otherwise, zoom around
+    // the sample under the cursor
+    if (!m_following) {
+        double fraction = static_cast<double>(event->pos().x()) / std::max(1, width());
+        qint64 anchor = m_end - m_span + static_cast<qint64>(fraction * m_span);
+        m_end = anchor + static_cast<qint64>((1.0 - fraction) * span);
+    }
+    m_span = span;
+    update();
+}
+
+void SamplePlotWidget::mousePressEvent(QMouseEvent* event) {
+    m_dragStartX = event->pos().x();
+    m_dragStartEnd = getEnd();
+}
+
+void SamplePlotWidget::mouseMoveEvent(QMouseEvent* event) {
+    if (!(event->buttons() & Qt::LeftButton)) {
+        return;
+    }
+    qint64 delta = static_cast<qint64>(
+        static_cast<double>(m_dragStartX - event->pos().x()) / std::max(1, width()) * m_span);
+    m_end = m_dragStartEnd + delta;
+    m_following = false;
+    update();
+}
+
+void SamplePlotWidget::mouseDoubleClickEvent(QMouseEvent* event) {
+    Q_UNUSED(event);
+    m_following = true;
+    update();
+}
+
+qint64 SamplePlotWidget::getSize() const {
+    qint64 size = 0;
+    for (const QSharedPointer<const SampleRingBuffer>& buffer : m_buffers) {
+        size = std::max(size, buffer->size());
+    }
+    return size;
+}
+
+qint64 SamplePlotWidget::getEnd() const {
+    // While following, keep the newest sample at the right edge (or, before
+    // the window fills up, keep the oldest sample at the left edge)
+    if (m_following) {
+        return std::max(getSize(), m_span);
+    }
+    return m_end;
+}
+
+} // namespace mms
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <QMouseEvent>
+#include <QPaintEvent>
+#include <QSharedPointer>
+#include <QTimer>
+#include <QVector>
+#include <QWheelEvent>
+#include <QWidget>
+
+#include "SampleRingBuffer.h"
+
+namespace mms {
+
+// Plots sample histories as stacked strips, one per channel. Each pixel
+// column is drawn as the min/max of the samples that fall within it, which
+// the buffers compute without scanning (or copying) the raw samples.
+//
+// Scrolling zooms around the cursor, dragging pans, and double-clicking
+// goes back to following the most recent samples.
+class SamplePlotWidget : public QWidget {
+
+    Q_OBJECT
+
+public:
+
+    SamplePlotWidget(QWidget* parent = 0);
+
+    void setBuffers(
+        const QVector<QSharedPointer<const SampleRingBuffer>>& buffers,
+        double secondsPerSample);
+
+protected:
+
+    void paintEvent(QPaintEvent* event);
+    void wheelEvent(QWheelEvent* event);
+    void mousePressEvent(QMouseEvent* event);
+    void mouseMoveEvent(QMouseEvent* event);
+    void mouseDoubleClickEvent(QMouseEvent* event);
+
+private:
+
+    QVector<QSharedPointer<const SampleRingBuffer>> m_buffers;
+    double m_secondsPerSample;
+    QTimer m_timer;
+
+    // The visible window is [m_end - m_span, m_end), in samples; while
+    // following, m_end tracks the most recent sample
+    bool m_following;
+    qint64 m_end;
+    qint64 m_span;
+
+    // The x position and window end at the start of a drag
+    int m_dragStartX;
+    qint64 m_dragStartEnd;
+
+    qint64 getSize() const;
+    qint64 getEnd() const;
+
+};
+
+} // namespace mms
@@ -0,0 +1,138 @@
+#include "SampleRingBuffer.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "Assert.h"
+
+namespace mms {
+
+SampleRingBuffer::SampleRingBuffer(const QString& name, qint64 capacity) :
+    m_name(name),
+    m_size(0) {
+
+    ASSERT_LT(0, capacity);
+    qint64 largestBlockSize = getBlockSize(NUM_LEVELS);
+    m_capacity = (capacity + largestBlockSize - 1) / largestBlockSize * largestBlockSize;
+
+    m_samples.resize(m_capacity);
+    m_mins.resize(NUM_LEVELS + 1);
+    m_maxs.resize(NUM_LEVELS + 1);
+    for (int level = 1; level <= NUM_LEVELS; level += 1) {
+        m_mins[level].resize(m_capacity / getBlockSize(level));
+        m_maxs[level].resize(m_capacity / getBlockSize(level));
+    }
+    m_runningMins.resize(NUM_LEVELS + 1);
+    m_runningMaxs.resize(NUM_LEVELS + 1);
+}
+
+const QString& SampleRingBuffer::getName() const {
+    return m_name;
+}
+
+void SampleRingBuffer::push(float value) {
+
+    // NOTE: This is called for every channel on every tick of the model
+
+    qint64 index = m_size.load();
+    m_samples[index % m_capacity] = value;
+
+    // Fold the sample into the running block summaries, and write out any
+    // blocks that it completes
+    for (int level = 1; level <= NUM_LEVELS; level += 1) {
+        qint64 blockSize = getBlockSize(level);
+        if (index % blockSize == 0) {
+            m_runningMins[level] = value;
+            m_runningMaxs[level] = value;
+        }
+        else {
+            m_runningMins[level] = std::min(m_runningMins[level], value);
+            m_runningMaxs[level] = std::max(m_runningMaxs[level], value);
+        }
+        if ((index + 1) % blockSize == 0) {
+            int block = (index / blockSize) % (m_capacity / blockSize);
+            m_mins[level][block] = m_runningMins[level];
+            m_maxs[level][block] = m_runningMaxs[level];
+        }
+    }
+
+    // Only now let readers see the sample (and any completed blocks)
+    m_size.storeRelease(index + 1);
+}
+
+qint64 SampleRingBuffer::size() const {
+    return m_size.loadAcquire();
+}
+
+qint64 SampleRingBuffer::getFirstIndex() const {
+    return getFirstIndex(size());
+}
+
+QPair<float, float> SampleRingBuffer::getMinMax(qint64 begin, qint64 end) const {
+
+    qint64 size = m_size.loadAcquire();
+    begin = std::max(begin, getFirstIndex(size));
+    end = std::min(end, size);
+
+    float min = std::numeric_limits<float>::max();
+    float max = std::numeric_limits<float>::lowest();
+
+    // Greedily take the biggest aligned block that fits in the remaining
+    // range, which touches at most ~2 * LEVEL_FACTOR values per level
+    while (begin < end) {
+        int level = NUM_LEVELS;
+        while (0 < level) {
+            qint64 blockSize = getBlockSize(level);
+            if (begin % blockSize == 0 && begin + blockSize <= end) {
+                break;
+            }
+            level -= 1;
+        }
+        if (level == 0) {
+            float value = m_samples.at(begin % m_capacity);
+            min = std::min(min, value);
+            max = std::max(max, value);
+            begin += 1;
+        }
+        else {
+            qint64 blockSize = getBlockSize(level);
+            int block = (begin / blockSize) % (m_capacity / blockSize);
+            min = std::min(min, m_mins.at(level).at(block));
+            max = std::max(max, m_maxs.at(level).at(block));
+            begin += blockSize;
+        }
+    }
+
+    return {min, max};
+}
+
+QVector<QPair<float, float>> SampleRingBuffer::getMinMax(
+        qint64 begin,
+        qint64 end,
+        int numBuckets) const {
+    ASSERT_LT(0, numBuckets);
+    QVector<QPair<float, float>> buckets;
+    buckets.reserve(numBuckets);
+    qint64 length = std::max(static_cast<qint64>(0), end - begin);
+    for (int i = 0; i < numBuckets; i += 1) {
+        buckets.append(getMinMax(
+            begin + length * i / numBuckets,
+            begin + length * (i + 1) / numBuckets));
+    }
+    return buckets;
+}
+
+qint64 SampleRingBuffer::getBlockSize(int level) {
+    qint64 blockSize = 1;
+    for (int i = 0; i < level; i += 1) {
+        blockSize *= LEVEL_FACTOR;
+    }
+    return blockSize;
+}
+
+qint64 SampleRingBuffer::getFirstIndex(qint64 size) const {
+    // Leave an eighth of the ring as slack between the writer and readers
+    return std::max(static_cast<qint64>(0), size - m_capacity + m_capacity / 8);
+}
+
+} // namespace mms
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <QAtomicInteger>
+#include <QPair>
+#include <QString>
+#include <QVector>
+
+namespace mms {
+
+// A fixed-size history of samples of a single channel (e.g., a sensor
+// reading), written by one thread and read by another without locking.
+//
+// Alongside the raw samples, the buffer keeps the min and max of every
+// aligned block of 64, 64^2, and 64^3 samples, so that the min/max over any
+// range can be found by touching a few hundred values at most, no matter how
+// long the range is. This is what lets a plot of hours of data be redrawn
+// without copying or scanning all of it.
+class SampleRingBuffer {
+
+public:
+
+    // Capacity is rounded up to a multiple of the largest block size
+    SampleRingBuffer(const QString& name, qint64 capacity);
+
+    const QString& getName() const;
+
+    // Appends a sample; must only ever be called from one thread
+    void push(float value);
+
+    // The total number of samples pushed so far, and the index of the
+    // oldest sample that may still be safely read. The ring is not fully
+    // used, so that a reader has some slack before the writer catches up.
+    qint64 size() const;
+    qint64 getFirstIndex() const;
+
+    // Returns the min and max of the samples in [begin, end), clamped to the
+    // retained samples; if there are none, the min is greater than the max
+    QPair<float, float> getMinMax(qint64 begin, qint64 end) const;
+
+    // Splits [begin, end) into numBuckets equal parts and returns the min and
+    // max of each, as above
+    QVector<QPair<float, float>> getMinMax(qint64 begin, qint64 end, int numBuckets) const;
+
+private:
+
+    static const int NUM_LEVELS = 3;
+    static const int LEVEL_FACTOR = 64;
+    static qint64 getBlockSize(int level);
+
+    QString m_name;
+    qint64 m_capacity;
+
+    // Level 0 is the raw samples; level i holds one min and max for each
+    // block of LEVEL_FACTOR^i samples
+    QVector<float> m_samples;
+    QVector<QVector<float>> m_mins;
+    QVector<QVector<float>> m_maxs;
+
+    // The writer's running min and max of the current block at each level
+    QVector<float> m_runningMins;
+    QVector<float> m_runningMaxs;
+
+    // Published after each sample is fully written
+    QAtomicInteger<qint64> m_size;
+
+    qint64 getFirstIndex(qint64 size) const;
+
+};
+
+} // namespace mms
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QtMath>
+
+#include "CatchUpPolicy.h"
+
+namespace mms {
+
+// How closely the model thread kept to its schedule in real-time mode. The
+// lateness of a wakeup is how long after its deadline the thread woke up,
+// and a deadline is missed once the thread is late by a whole tick.
+struct SchedulingStats {
+    bool realTime = false;
+    CatchUpPolicy catchUpPolicy = CatchUpPolicy::BURST;
+    bool pinned = false;
+    bool fifo = false;
+    qint64 wakeups = 0;
+    qint64 missedDeadlines = 0;
+    qint64 burstTicks = 0;
+    qint64 skippedTicks = 0;
+    qint64 rescheduled = 0;
+    double maxLatenessUs = 0.0;
+    double sumLatenessUs = 0.0;
+    double sumSquaredLatenessUs = 0.0;
+
+    double meanLatenessUs() const {
+        return wakeups == 0 ? 0.0 : sumLatenessUs / wakeups;
+    }
+
+    // The standard deviation of the lateness
+    double jitterUs() const {
+        if (wakeups == 0) {
+            return 0.0;
+        }
+        double mean = meanLatenessUs();
+        return qSqrt(qMax(0.0, sumSquaredLatenessUs / wakeups - mean * mean));
+    }
+};
+
+} // namespace mms
@@ -12,21 +12,27 @@
 namespace mms {
 
 Sensor::Sensor() :
+    m_type(SensorType::ANALOG),
     m_range(Distance()),
     m_halfWidth(Angle()),
+    m_threshold(Distance()),
     m_initialPosition(Coordinate()),
     m_initialDirection(Angle()) {
 }
 
 Sensor::Sensor(
+    SensorType type,
     const Distance& radius,
     const Distance& range,
     const Angle& halfWidth,
+    const Distance& threshold,
     const Coordinate& position,
     const Angle& direction,
     const Maze& maze) :
+    m_type(type),
     m_range(range),
     m_halfWidth(halfWidth),
+    m_threshold(threshold),
     m_initialPosition(position),
     m_initialDirection(direction) {
 
@@ -35,12 +41,18 @@ Sensor::Sensor(
         position, radius, P()->numberOfCircleApproximationPoints());
 
     // Create the polygon for the view of the sensor
-    QVector<Coordinate> view;
-    view.push_back(position);
-    for (double i = -1; i <= 1; i += 2.0 / (P()->numberOfSensorEdgePoints() - 1)) {
-        view.push_back(Coordinate::Polar(range, (halfWidth * i) + direction) + position);
+    if (m_type == SensorType::ANALOG) {
+        QVector<Coordinate> view;
+        view.push_back(position);
+        for (double i = -1; i <= 1; i += 2.0 / (P()->numberOfSensorEdgePoints() - 1)) {
+            view.push_back(Coordinate::Polar(range, (halfWidth * i) + direction) + position);
+        }
+        m_initialViewPolygon = Polygon(view, PolygonShape::FAN);
+    }
+    else {
+        m_initialViewPolygon = GeometryUtilities::createRayPolygon(
+            position, Coordinate::Polar(range, direction) + position);
     }
-    m_initialViewPolygon = Polygon(view);
 
     // Initialize the sensor reading
     updateReading(m_initialPosition, m_initialDirection, maze);
@@ -62,11 +74,12 @@ const Polygon& Sensor::getInitialViewPolygon() const {
     return m_initialViewPolygon;
 }
 
-Polygon Sensor::getCurrentViewPolygon(
-        const Coordinate& currentPosition,
-        const Angle& currentDirection,
-        const Maze& maze) const {
-    return getViewPolygon(currentPosition, currentDirection, maze);
+SensorType Sensor::getType() const {
+    return m_type;
+}
+
+const QVector<Coordinate>& Sensor::getCurrentView() const {
+    return m_currentView;
 }
 
 double Sensor::read() const {
@@ -78,30 +91,60 @@ void Sensor::updateReading(
         const Angle& currentDirection,
         const Maze& maze) {
 
+    // Cast the rays just once; the hit points are kept around so that the
+    // view can be drawn without casting them again
+    m_currentView = castView(currentPosition, currentDirection, maze);
+
+    // The single-ray sensors only need the distance to the hit point, which
+    // is much cheaper than the area of the view
+    if (m_type != SensorType::ANALOG) {
+        Distance distance = (m_currentView.at(1) - m_currentView.at(0)).getRho();
+        if (m_type == SensorType::DISTANCE) {
+            m_currentReading = distance.getMeters();
+        }
+        else {
+            m_currentReading = distance < m_threshold ? 1.0 : 0.0;
+        }
+        return;
+    }
+
     m_currentReading = std::max(
         0.0,
         1.0 - 
-            getViewPolygon(currentPosition, currentDirection, maze)
-                .area().getMetersSquared() /
+            Polygon(m_currentView, PolygonShape::FAN).area().getMetersSquared() /
             getInitialViewPolygon().area().getMetersSquared());
 
     ASSERT_LE(0.0, m_currentReading);
     ASSERT_LE(m_currentReading, 1.0);
 }
 
-Polygon Sensor::getViewPolygon(
+QVector<Coordinate> Sensor::castView(
         const Coordinate& currentPosition,
         const Angle& currentDirection,
         const Maze& maze) const {
 
-    // TODO: MACK - this can be deduped with getCurrentViewPolygon
-
-    // Calling this function causes triangulation of a polygon
+    // The view is a fan of rays around the sensor position, which lets the
+    // polygon be triangulated in linear time if it's ever drawn
 
     static Distance halfWallWidth = Distance::Meters(P()->wallWidth() / 2.0);
     static Distance tileLength = Distance::Meters(P()->wallLength() + P()->wallWidth());
 
+    // Single-ray sensors cast just the one, straight ahead
+    if (m_type != SensorType::ANALOG) {
+        return {
+            currentPosition,
+            GeometryUtilities::castRay(
+                currentPosition,
+                currentPosition + Coordinate::Polar(m_range, currentDirection),
+                maze,
+                halfWallWidth,
+                tileLength
+            ),
+        };
+    }
+
     QVector<Coordinate> polygon {currentPosition};
+    polygon.reserve(P()->numberOfSensorEdgePoints() + 1);
 
     for (double i = -1; i <= 1; i += 2.0 / (P()->numberOfSensorEdgePoints() - 1)) {
         polygon.push_back(
@@ -118,7 +161,7 @@ Polygon Sensor::getViewPolygon(
         );
     }
 
-    return Polygon(polygon);
+    return polygon;
 }
 
 } // namespace mms
@@ -1,6 +1,6 @@
 #pragma once
 
-#include <set>
+#include <QVector>
 
 #include "units/Angle.h"
 #include "units/Coordinate.h"
@@ -8,6 +8,7 @@
 
 #include "Maze.h"
 #include "Polygon.h"
+#include "SensorType.h"
 
 namespace mms {
 
@@ -16,9 +17,11 @@ class Sensor {
 public:
     Sensor();
     Sensor(
+        SensorType type,
         const Distance& radius,
         const Distance& range,
         const Angle& halfWidth,
+        const Distance& threshold,
         const Coordinate& position,
         const Angle& direction,
         const Maze& maze);
@@ -27,11 +30,13 @@ public:
     const Angle& getInitialDirection() const;
     const Polygon& getInitialPolygon() const;
     const Polygon& getInitialViewPolygon() const;
-    Polygon getCurrentViewPolygon(
-        const Coordinate& currentPosition,
-        const Angle& currentDirection,
-        const Maze& maze) const;
+    SensorType getType() const;
+
+    // The sensor position followed by the ray hit points, as of the most
+    // recent call to updateReading; single-ray sensors have just one
+    const QVector<Coordinate>& getCurrentView() const;
 
+    // See SensorType for the meaning of the reading
     double read() const;
     void updateReading(
         const Coordinate& currentPosition,
@@ -39,17 +44,20 @@ public:
         const Maze& maze);
 
 private:
+    SensorType m_type;
     Distance m_range;
     Angle m_halfWidth;
+    Distance m_threshold;
 
     Coordinate m_initialPosition;
     Angle m_initialDirection;
     Polygon m_initialPolygon;
     Polygon m_initialViewPolygon;
 
+    QVector<Coordinate> m_currentView;
     double m_currentReading;
 
-    Polygon getViewPolygon(
+    QVector<Coordinate> castView(
         const Coordinate& currentPosition,
         const Angle& currentDirection,
         const Maze& maze) const;
@@ -8,6 +8,7 @@ const QMap<SensorType, QString>& SENSOR_TYPE_TO_STRING() {
     static const QMap<SensorType, QString> map = {
         {SensorType::ANALOG, "ANALOG"},
         {SensorType::DIGITAL, "DIGITAL"},
+        {SensorType::DISTANCE, "DISTANCE"},
     };
     return map;
 }
@@ -9,8 +9,15 @@
 namespace mms {
 
 enum class SensorType {
+    // A fan of rays, read as the fraction of the view that's blocked, in
+    // [0.0, 1.0]; the rays are spread over the half width
     ANALOG,
+    // A single ray, read as 1.0 if it hits something closer than the
+    // threshold and 0.0 otherwise, like an IR proximity switch
     DIGITAL,
+    // A single ray, read as the distance to what it hits (or the range, if
+    // it doesn't hit anything) in meters, like a time-of-flight rangefinder
+    DISTANCE,
 };
 
 const QMap<SensorType, QString>& SENSOR_TYPE_TO_STRING();
@@ -1,18 +1,70 @@
 #include "SimUtilities.h"
 
 #include <QDateTime>
+#include <QDebug>
 #include <QRegExp>
 #include <QThread>
 #include <QTime>
 
+#include <chrono>
 #include <limits>
 #include <random>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#endif
 
 #include "Assert.h"
 #include "Param.h"
 
 namespace mms {
 
+namespace {
+
+// Both QVector and RenderBuffer have an append method, so the triangles are
+// written straight into whichever buffer is given
+template<typename Buffer>
+void appendTriangleGraphicsTo(
+        const Polygon& polygon,
+        Color color,
+        double alpha,
+        Buffer* buffer,
+        GraphicLayer layer) {
+    QVector<Triangle> triangles = polygon.getTriangles();
+    RGB rgb = COLOR_TO_RGB().value(color);
+    quint8 r = packColorValue(rgb.r);
+    quint8 g = packColorValue(rgb.g);
+    quint8 b = packColorValue(rgb.b);
+    quint8 a = packColorValue(alpha);
+    for (const Triangle& triangle : triangles) {
+        TriangleGraphic triangleGraphic = {
+            {
+                static_cast<float>(triangle.p1.getX().getMeters()),
+                static_cast<float>(triangle.p1.getY().getMeters()),
+                r, g, b, a, layer, {}
+            },
+            {
+                static_cast<float>(triangle.p2.getX().getMeters()),
+                static_cast<float>(triangle.p2.getY().getMeters()),
+                r, g, b, a, layer, {}
+            },
+            {
+                static_cast<float>(triangle.p3.getX().getMeters()),
+                static_cast<float>(triangle.p3.getY().getMeters()),
+                r, g, b, a, layer, {}
+            },
+        };
+        buffer->append(triangleGraphic);
+    }
+}
+
+} // namespace
+
 void SimUtilities::quit() {
     // TODO: MACK - make a better API for exiting from each of the threads
     exit(1);
@@ -55,6 +107,74 @@ double SimUtilities::getHighResTimestamp() {
     return QDateTime::currentDateTime().toMSecsSinceEpoch() / 1000.0;
 }
 
+double SimUtilities::getMonotonicTimestamp() {
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+void SimUtilities::sleepUntil(double monotonicTimestamp) {
+#ifdef __linux__
+    // The steady clock is CLOCK_MONOTONIC on Linux, and sleeping until an
+    // absolute time (rather than for a duration) means that the time spent
+    // computing the duration can't add to the error
+    struct timespec deadline;
+    deadline.tv_sec = static_cast<time_t>(monotonicTimestamp);
+    deadline.tv_nsec = static_cast<long>(
+        (monotonicTimestamp - deadline.tv_sec) * 1000000000.0);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr) == EINTR) {
+    }
+#else
+    std::this_thread::sleep_until(
+        std::chrono::steady_clock::time_point(
+            std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(monotonicTimestamp))));
+#endif
+}
+
+bool SimUtilities::pinCurrentThread(int cpu) {
+#ifdef __linux__
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+    int error = pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+    if (error != 0) {
+        qWarning().noquote().nospace()
+            << "Unable to pin the thread to CPU " << cpu << " - "
+            << strerror(error);
+        return false;
+    }
+    return true;
+#else
+    qWarning().noquote().nospace()
+        << "Unable to pin the thread to CPU " << cpu
+        << " - not supported on this platform";
+    return false;
+#endif
+}
+
+bool SimUtilities::setCurrentThreadRealTimePriority(int priority) {
+#ifdef __linux__
+    struct sched_param param;
+    param.sched_priority = priority;
+    int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (error != 0) {
+        qWarning().noquote().nospace()
+            << "Unable to use SCHED_FIFO with priority " << priority << " - "
+            << strerror(error) << (error == EPERM
+                ? " (this requires CAP_SYS_NICE or an rtprio limit)"
+                : "");
+        return false;
+    }
+    return true;
+#else
+    qWarning().noquote().nospace()
+        << "Unable to use a real-time priority of " << priority
+        << " - not supported on this platform";
+    return false;
+#endif
+}
+
 QString SimUtilities::formatDuration(const Duration& duration) {
     return QTime(0, 0, 0)
         .addMSecs(duration.getMilliseconds())
@@ -65,6 +185,38 @@ QStringList SimUtilities::splitLines(const QString& string) {
     return string.split(QRegExp("\n|\r\n|\r"));
 }
 
+QStringList SimUtilities::getLines(const QString& text, QStringList* buffer) {
+
+    // TODO: upforgrabs
+    // Determine whether or not this function is perf sensitive. If so,
+    // refactor this so that we're not copying QStrings between lists.
+
+    // Separate the text by line
+    QStringList parts = SimUtilities::splitLines(text);
+
+    // We'll return list of complete lines
+    QStringList lines;
+
+    // If the text has at least one newline character, we definitely have a
+    // complete line; combine it with the contents of the buffer and append
+    // it to the list of lines to be returned
+    if (1 < parts.size()) {
+        lines.append(buffer->join("") + parts.at(0));
+        buffer->clear();
+    }
+
+    // All newline-separated parts in the text are lines
+    for (int i = 1; i < parts.size() - 1; i += 1) {
+        lines.append(parts.at(i));
+    }
+
+    // Store the last part of the text (empty string if the text ended
+    // with newline) in the buffer, to be combined with future input
+    buffer->append(parts.at(parts.size() - 1));
+
+    return lines;
+}
+
 bool SimUtilities::isBool(const QString& str) {
     return str == "true" || str == "false";
 }
@@ -109,17 +261,27 @@ QVector<TriangleGraphic> SimUtilities::polygonToTriangleGraphics(
         const Polygon& polygon,
         Color color,
         double alpha) {
-    QVector<Triangle> triangles = polygon.getTriangles();
     QVector<TriangleGraphic> triangleGraphics;
-    RGB colorValues = COLOR_TO_RGB().value(color);
-    for (Triangle triangle : triangles) {
-        triangleGraphics.push_back({
-            {triangle.p1.getX().getMeters(), triangle.p1.getY().getMeters(), colorValues, alpha},
-            {triangle.p2.getX().getMeters(), triangle.p2.getY().getMeters(), colorValues, alpha},
-            {triangle.p3.getX().getMeters(), triangle.p3.getY().getMeters(), colorValues, alpha}
-        });
-    }
+    appendTriangleGraphics(polygon, color, alpha, &triangleGraphics);
     return triangleGraphics;
 }
 
+void SimUtilities::appendTriangleGraphics(
+        const Polygon& polygon,
+        Color color,
+        double alpha,
+        QVector<TriangleGraphic>* buffer,
+        GraphicLayer layer) {
+    appendTriangleGraphicsTo(polygon, color, alpha, buffer, layer);
+}
+
+void SimUtilities::appendTriangleGraphics(
+        const Polygon& polygon,
+        Color color,
+        double alpha,
+        RenderBuffer<TriangleGraphic>* buffer,
+        GraphicLayer layer) {
+    appendTriangleGraphicsTo(polygon, color, alpha, buffer, layer);
+}
+
 } // namespace mms
@@ -8,7 +8,9 @@
 #include <algorithm>
 
 #include "Color.h"
+#include "GraphicLayer.h"
 #include "Polygon.h"
+#include "RenderBuffer.h"
 #include "TriangleGraphic.h"
 #include "units/Duration.h"
 
@@ -39,12 +41,28 @@ public:
     // Like time() in <ctime> but higher resolution (returns seconds since epoch)
     static double getHighResTimestamp();
 
+    // Seconds on a monotonic clock with (at least) microsecond resolution;
+    // only the differences between these timestamps are meaningful
+    static double getMonotonicTimestamp();
+
+    // Sleeps the current thread until the given monotonic timestamp
+    static void sleepUntil(double monotonicTimestamp);
+
+    // Pin the current thread to a CPU, or give it a real-time (FIFO)
+    // priority; these warn and return false if that isn't possible
+    static bool pinCurrentThread(int cpu);
+    static bool setCurrentThreadRealTimePriority(int priority);
+
     // Converts a duration to a mm:ss.zzz string
     static QString formatDuration(const Duration& duration);
 
     // Splits into lines in a cross-platform way
     static QStringList splitLines(const QString& string);
 
+    // Given some text (and a buffer containing past input), return
+    // all complete lines and append remaining text to the buffer
+    static QStringList getLines(const QString& text, QStringList* buffer);
+
     // Convert between types
     static bool isBool(const QString& str);
     static bool isInt(const QString& str);
@@ -61,6 +79,20 @@ public:
         Color color,
         double alpha);
 
+    // Same as above, but appends the triangle graphics to buffer
+    static void appendTriangleGraphics(
+        const Polygon& polygon,
+        Color color,
+        double alpha,
+        QVector<TriangleGraphic>* buffer,
+        GraphicLayer layer = GraphicLayer::NONE);
+    static void appendTriangleGraphics(
+        const Polygon& polygon,
+        Color color,
+        double alpha,
+        RenderBuffer<TriangleGraphic>* buffer,
+        GraphicLayer layer = GraphicLayer::NONE);
+
 };
 
 } // namespace mms
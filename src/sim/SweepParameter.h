@@ -0,0 +1,25 @@
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+namespace mms {
+
+// A single dimension of a parameter sweep: either a field of the mouse's
+// wheels or sensors (as in the mouse XML), or a mouse interface option
+struct SweepParameter {
+    // "wheel", "sensor", or "option"
+    QString kind;
+    // The wheel or sensor name ("*" for all of them), or the option command
+    QString name;
+    // The wheel or sensor field, e.g., "Max-Speed" or "Position/X"
+    QString field;
+    // The values used by a grid sweep, and the range of a Latin hypercube
+    // sweep; if a Latin hypercube sweep has explicit values, it picks from them
+    QVector<double> values;
+    bool hasExplicitValues = false;
+    double min = 0.0;
+    double max = 0.0;
+};
+
+} // namespace mms
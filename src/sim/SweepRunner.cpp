@@ -0,0 +1,784 @@
+#include "SweepRunner.h"
+
+#include <QCoreApplication>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QProcessEnvironment>
+#include <QTextStream>
+#include <QThread>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+
+#include "MouseParser.h"
+#include "SettingsMouseAlgos.h"
+#include "SweepWorker.h"
+
+namespace mms {
+
+namespace {
+
+// The interface commands that can be swept, i.e., the dynamic options
+const QStringList OPTION_COMMANDS = {
+    "setWheelSpeedFraction",
+    "updateAllowOmniscience",
+    "updateAutomaticallyClearFog",
+    "updateDeclareBothWallHalves",
+    "updateSetTileTextWhenDistanceDeclared",
+    "updateSetTileBaseColorWhenDistanceDeclaredCorrectly",
+    "updateDeclareWallOnRead",
+    "updateUseTileEdgeMovements",
+};
+
+QString csvField(const QString& value) {
+    if (!value.contains(',') && !value.contains('"') && !value.contains('\n')) {
+        return value;
+    }
+    return "\"" + QString(value).replace("\"", "\"\"") + "\"";
+}
+
+// The Pearson correlation coefficient, or NaN if it's undefined
+double correlation(const QVector<double>& x, const QVector<double>& y) {
+    int n = x.size();
+    if (n < 2) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    double meanX = std::accumulate(x.begin(), x.end(), 0.0) / n;
+    double meanY = std::accumulate(y.begin(), y.end(), 0.0) / n;
+    double covariance = 0.0;
+    double varianceX = 0.0;
+    double varianceY = 0.0;
+    for (int i = 0; i < n; i += 1) {
+        covariance += (x.at(i) - meanX) * (y.at(i) - meanY);
+        varianceX += (x.at(i) - meanX) * (x.at(i) - meanX);
+        varianceY += (y.at(i) - meanY) * (y.at(i) - meanY);
+    }
+    if (varianceX == 0.0 || varianceY == 0.0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return covariance / std::sqrt(varianceX * varianceY);
+}
+
+QString formatNumber(double value) {
+    return std::isnan(value) ? "N/A" : QString::number(value, 'f', 3);
+}
+
+// Clearances may be negative, so a missing one (e.g., the job failed
+// before the mouse moved) is left empty rather than given a sentinel
+QString formatClearance(const QJsonValue& value) {
+    return value.isDouble() ? QString::number(value.toDouble()) : QString();
+}
+
+} // namespace
+
+SweepRunner::SweepRunner(QObject* parent) :
+        QObject(parent),
+        m_samples(0),
+        m_repeats(1),
+        m_seed(0),
+        m_numWorkers(1),
+        m_maxSimSeconds(0.0),
+        m_stopAtCenter(false),
+        m_store(nullptr),
+        m_nextJob(0),
+        m_numFinished(0) {
+}
+
+SweepRunner::~SweepRunner() {
+    delete m_store;
+}
+
+bool SweepRunner::start(const QString& specFilePath) {
+
+    if (!loadSpec(specFilePath)) {
+        return false;
+    }
+    if (!m_variantDir.isValid()) {
+        qWarning().noquote()
+            << "Unable to create a directory for the sweep's mouse files";
+        return false;
+    }
+
+    generateVariants();
+    if (!writeVariantMouseFiles()) {
+        return false;
+    }
+
+    if (!m_databasePath.isEmpty()) {
+        m_store = new ResultsStore(m_databasePath);
+        if (!m_store->isOpen()) {
+            return false;
+        }
+        m_algoHash = ResultsStore::hashAlgoDir(
+            SettingsMouseAlgos::getDirPath(m_mouseAlgo));
+        for (const QString& maze : m_mazes) {
+            m_mazeHashes.insert(maze, ResultsStore::hashFile(maze));
+        }
+        for (const QString& mouseFile : m_variantMouseFiles) {
+            m_variantMouseFileHashes.append(ResultsStore::hashFile(mouseFile));
+        }
+    }
+
+    // Each variant is run on each maze, with each seed
+    std::mt19937 generator(m_seed);
+    QVector<int> seeds;
+    for (int i = 0; i < m_repeats; i += 1) {
+        seeds.append(static_cast<int>(generator() % 1000000));
+    }
+    for (int variant = 0; variant < m_variants.size(); variant += 1) {
+        for (const QString& maze : m_mazes) {
+            for (int seed : seeds) {
+                m_jobs.append({variant, maze, seed});
+            }
+        }
+    }
+    m_results.resize(m_jobs.size());
+
+    qInfo().noquote() << QString(
+        "Sweeping %1 variants over %2 mazes (%3 jobs, %4 workers)"
+    ).arg(m_variants.size()).arg(m_mazes.size()).arg(m_jobs.size()).arg(
+        std::min(m_numWorkers, m_jobs.size()));
+
+    for (int i = 0; i < std::min(m_numWorkers, m_jobs.size()); i += 1) {
+        if (!startWorker()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SweepRunner::loadSpec(const QString& specFilePath) {
+
+    QFile file(specFilePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qWarning().noquote() << "Unable to open sweep spec" << specFilePath;
+        return false;
+    }
+    QJsonParseError error;
+    QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &error);
+    if (!document.isObject()) {
+        qWarning().noquote()
+            << "Invalid sweep spec" << specFilePath << "-" << error.errorString();
+        return false;
+    }
+    QJsonObject spec = document.object();
+
+    // Paths in the spec are relative to the spec itself
+    QDir specDir = QFileInfo(specFilePath).absoluteDir();
+    auto resolve = [&](const QString& path) {
+        return QDir::cleanPath(specDir.absoluteFilePath(path));
+    };
+
+    m_mouseAlgo = spec.value("mouseAlgo").toString();
+    if (m_mouseAlgo.isEmpty()) {
+        qWarning().noquote() << "The sweep spec has no \"mouseAlgo\"";
+        return false;
+    }
+    m_mouseFile = resolve(spec.value("mouseFile").toString(
+        ":/resources/mice/default.xml"));
+
+    for (const QJsonValue& value : spec.value("mazes").toArray()) {
+        QString path = resolve(value.toString());
+        QFileInfo info(path);
+        if (info.isDir()) {
+            QDir dir(path);
+            for (const QString& name : dir.entryList(QDir::Files, QDir::Name)) {
+                m_mazes.append(dir.absoluteFilePath(name));
+            }
+        }
+        else if (info.isFile()) {
+            m_mazes.append(path);
+        }
+        else {
+            qWarning().noquote() << "The sweep maze" << path << "doesn't exist";
+            return false;
+        }
+    }
+    if (m_mazes.isEmpty()) {
+        qWarning().noquote() << "The sweep spec has no \"mazes\"";
+        return false;
+    }
+
+    m_sampling = spec.value("sampling").toString("grid");
+    if (m_sampling != "grid" && m_sampling != "latin-hypercube") {
+        qWarning().noquote()
+            << "Invalid sweep sampling" << m_sampling
+            << "- expected \"grid\" or \"latin-hypercube\"";
+        return false;
+    }
+    m_samples = spec.value("samples").toInt(10);
+    m_repeats = spec.value("repeats").toInt(1);
+    m_seed = spec.value("seed").toInt(0);
+    m_numWorkers = spec.value("workers").toInt(QThread::idealThreadCount());
+    m_maxSimSeconds = spec.value("maxSimSeconds").toDouble(600.0);
+    m_stopAtCenter = spec.value("stopAtCenter").toBool(true);
+    m_outputPath = resolve(spec.value("output").toString("sweep-results.csv"));
+    if (spec.contains("database")) {
+        m_databasePath = resolve(spec.value("database").toString());
+    }
+    if (m_samples < 1 || m_repeats < 1 || m_numWorkers < 1) {
+        qWarning().noquote()
+            << "The sweep's \"samples\", \"repeats\", and \"workers\" must be positive";
+        return false;
+    }
+
+    for (const QJsonValue& value : spec.value("parameters").toArray()) {
+        SweepParameter parameter;
+        if (!loadParameter(value.toObject(), &parameter)) {
+            return false;
+        }
+        m_parameters.append(parameter);
+    }
+    return true;
+}
+
+bool SweepRunner::loadParameter(
+        const QJsonObject& object,
+        SweepParameter* parameter) {
+
+    int numKinds = 0;
+    for (const QString& kind : {"wheel", "sensor", "option"}) {
+        if (object.contains(kind)) {
+            parameter->kind = kind;
+            parameter->name = object.value(kind).toString();
+            numKinds += 1;
+        }
+    }
+    if (numKinds != 1) {
+        qWarning().noquote()
+            << "Each sweep parameter needs exactly one of \"wheel\","
+            << "\"sensor\", or \"option\"";
+        return false;
+    }
+    if (parameter->kind == "option") {
+        if (!OPTION_COMMANDS.contains(parameter->name)) {
+            qWarning().noquote()
+                << "Invalid sweep option" << parameter->name << "- expected one of"
+                << OPTION_COMMANDS.join(", ");
+            return false;
+        }
+    }
+    else {
+        parameter->field = object.value("field").toString();
+        if (parameter->field.isEmpty()) {
+            qWarning().noquote()
+                << "The sweep parameter for" << parameter->kind
+                << parameter->name << "has no \"field\"";
+            return false;
+        }
+    }
+
+    if (object.contains("values")) {
+        for (const QJsonValue& value : object.value("values").toArray()) {
+            parameter->values.append(value.toDouble());
+        }
+        if (parameter->values.isEmpty()) {
+            qWarning().noquote()
+                << "The sweep parameter" << getLabel(*parameter) << "has no values";
+            return false;
+        }
+        parameter->hasExplicitValues = true;
+        parameter->min = *std::min_element(
+            parameter->values.begin(), parameter->values.end());
+        parameter->max = *std::max_element(
+            parameter->values.begin(), parameter->values.end());
+    }
+    else {
+        if (!object.contains("min") || !object.contains("max")) {
+            qWarning().noquote()
+                << "The sweep parameter" << getLabel(*parameter)
+                << "needs either \"values\" or \"min\" and \"max\"";
+            return false;
+        }
+        parameter->min = object.value("min").toDouble();
+        parameter->max = object.value("max").toDouble();
+        int steps = object.value("steps").toInt(2);
+        if (steps < 1 || parameter->max < parameter->min) {
+            qWarning().noquote()
+                << "Invalid range for the sweep parameter" << getLabel(*parameter);
+            return false;
+        }
+        for (int i = 0; i < steps; i += 1) {
+            parameter->values.append(
+                steps == 1
+                ? parameter->min
+                : parameter->min + (parameter->max - parameter->min) * i / (steps - 1)
+            );
+        }
+    }
+    return true;
+}
+
+void SweepRunner::generateVariants() {
+
+    m_variants.clear();
+    int numParameters = m_parameters.size();
+
+    if (m_sampling == "grid") {
+        // The cartesian product of the values of every parameter
+        m_variants.append(QVector<double>());
+        for (const SweepParameter& parameter : m_parameters) {
+            QVector<QVector<double>> variants;
+            for (const QVector<double>& variant : m_variants) {
+                for (double value : parameter.values) {
+                    variants.append(variant);
+                    variants.last().append(value);
+                }
+            }
+            m_variants = variants;
+        }
+        return;
+    }
+
+    // A Latin hypercube: split each parameter's range into one stratum per
+    // sample, and give each sample a different stratum of each parameter
+    std::mt19937 generator(m_seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    m_variants.resize(m_samples);
+    for (int i = 0; i < numParameters; i += 1) {
+        const SweepParameter& parameter = m_parameters.at(i);
+        QVector<int> strata(m_samples);
+        std::iota(strata.begin(), strata.end(), 0);
+        std::shuffle(strata.begin(), strata.end(), generator);
+        for (int j = 0; j < m_samples; j += 1) {
+            double fraction = (strata.at(j) + uniform(generator)) / m_samples;
+            double value = (
+                parameter.hasExplicitValues
+                ? parameter.values.at(std::min(
+                    static_cast<int>(fraction * parameter.values.size()),
+                    parameter.values.size() - 1))
+                : parameter.min + fraction * (parameter.max - parameter.min)
+            );
+            m_variants[j].append(value);
+        }
+    }
+}
+
+bool SweepRunner::writeVariantMouseFiles() {
+
+    bool sweepsMouseFile = false;
+    for (const SweepParameter& parameter : m_parameters) {
+        sweepsMouseFile |= (parameter.kind != "option");
+    }
+
+    m_variantMouseFiles.clear();
+    for (int i = 0; i < m_variants.size(); i += 1) {
+        if (!sweepsMouseFile) {
+            m_variantMouseFiles.append(m_mouseFile);
+            continue;
+        }
+        bool success = true;
+        MouseParser parser(m_mouseFile, &success);
+        if (!success) {
+            qWarning().noquote() << "Unable to parse the mouse file" << m_mouseFile;
+            return false;
+        }
+        for (int j = 0; j < m_parameters.size(); j += 1) {
+            const SweepParameter& parameter = m_parameters.at(j);
+            if (parameter.kind == "option") {
+                continue;
+            }
+            int count = parser.overrideField(
+                parameter.kind,
+                parameter.name,
+                parameter.field,
+                m_variants.at(i).at(j)
+            );
+            if (count == 0) {
+                qWarning().noquote()
+                    << "The mouse file" << m_mouseFile << "has nothing that matches"
+                    << "the sweep parameter" << getLabel(parameter);
+                return false;
+            }
+        }
+        QString path = m_variantDir.filePath(QString("variant-%1.xml").arg(i));
+        if (!parser.save(path)) {
+            qWarning().noquote() << "Unable to write the mouse file" << path;
+            return false;
+        }
+        m_variantMouseFiles.append(path);
+    }
+    return true;
+}
+
+QJsonObject SweepRunner::getJobObject(int id) const {
+    const Job& job = m_jobs.at(id);
+    QJsonObject commands;
+    for (int i = 0; i < m_parameters.size(); i += 1) {
+        const SweepParameter& parameter = m_parameters.at(i);
+        if (parameter.kind != "option") {
+            continue;
+        }
+        double value = m_variants.at(job.variant).at(i);
+        commands.insert(
+            parameter.name,
+            parameter.name.startsWith("update")
+            ? QString(value != 0.0 ? "true" : "false")
+            : QString::number(value)
+        );
+    }
+    QJsonObject object;
+    object.insert("id", id);
+    object.insert("maze", job.maze);
+    object.insert("mouseAlgo", m_mouseAlgo);
+    object.insert("mouseFile", m_variantMouseFiles.at(job.variant));
+    object.insert("seed", job.seed);
+    object.insert("maxSimSeconds", m_maxSimSeconds);
+    object.insert("stopAtCenter", m_stopAtCenter);
+    object.insert("commands", commands);
+    return object;
+}
+
+bool SweepRunner::startWorker() {
+
+    // The workers never show a window, so they don't need a display
+    QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+    if (!environment.contains("QT_QPA_PLATFORM")) {
+        environment.insert("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QProcess* worker = new QProcess(this);
+    worker->setProcessEnvironment(environment);
+    worker->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    connect(worker, &QProcess::readyReadStandardOutput, this, [=](){
+        handleWorkerOutput(worker);
+    });
+    connect(
+        worker,
+        static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(
+            &QProcess::finished
+        ),
+        this,
+        [=](int exitCode, QProcess::ExitStatus exitStatus){
+            Q_UNUSED(exitCode);
+            Q_UNUSED(exitStatus);
+            handleWorkerFinished(worker);
+        }
+    );
+
+    worker->start(
+        QCoreApplication::applicationFilePath(),
+        {"--sweep-worker"}
+    );
+    if (!worker->waitForStarted()) {
+        qWarning().noquote()
+            << "Unable to start a sweep worker -" << worker->errorString();
+        delete worker;
+        return false;
+    }
+    m_workers.append(worker);
+    dispatchNextJob(worker);
+    return true;
+}
+
+void SweepRunner::dispatchNextJob(QProcess* worker) {
+    if (m_nextJob == m_jobs.size()) {
+        // Closing stdin tells the worker to quit
+        worker->closeWriteChannel();
+        return;
+    }
+    int id = m_nextJob;
+    m_nextJob += 1;
+    m_jobInProgress.insert(worker, id);
+    worker->write(QJsonDocument(getJobObject(id)).toJson(QJsonDocument::Compact));
+    worker->write("\n");
+}
+
+void SweepRunner::handleWorkerOutput(QProcess* worker) {
+    QByteArray& output = m_workerOutput[worker];
+    output += worker->readAllStandardOutput();
+    int index = output.indexOf('\n');
+    while (index != -1) {
+        QString line = QString::fromUtf8(output.left(index)).trimmed();
+        output.remove(0, index + 1);
+        index = output.indexOf('\n');
+        if (!line.startsWith(SweepWorker::RESULT_PREFIX)) {
+            continue;
+        }
+        QJsonObject result = QJsonDocument::fromJson(
+            line.mid(SweepWorker::RESULT_PREFIX.size()).toUtf8()).object();
+        int id = m_jobInProgress.value(worker, -1);
+        m_jobInProgress.remove(worker);
+        if (id != -1) {
+            handleResult(id, result);
+        }
+        dispatchNextJob(worker);
+    }
+}
+
+void SweepRunner::handleWorkerFinished(QProcess* worker) {
+
+    m_workers.removeOne(worker);
+    m_workerOutput.remove(worker);
+    worker->deleteLater();
+
+    // If the worker died partway through a job, record the job as an error
+    // and start another worker to take its place
+    if (m_jobInProgress.contains(worker)) {
+        int id = m_jobInProgress.take(worker);
+        QJsonObject result;
+        result.insert("status", "error");
+        result.insert("error", "worker exited unexpectedly");
+        handleResult(id, result);
+        if (m_nextJob < m_jobs.size() && !startWorker()) {
+            while (m_nextJob < m_jobs.size()) {
+                handleResult(m_nextJob++, result);
+            }
+        }
+    }
+}
+
+void SweepRunner::handleResult(int id, const QJsonObject& result) {
+
+    m_results[id] = result;
+    m_numFinished += 1;
+    if (m_store != nullptr) {
+        storeResult(id, result);
+    }
+
+    const Job& job = m_jobs.at(id);
+    QString status = result.value("status").toString();
+    double bestTime = result.value("bestTimeToCenter").toDouble(-1.0);
+    qInfo().noquote() << QString("[%1/%2] variant %3, %4: %5%6").arg(
+        QString::number(m_numFinished),
+        QString::number(m_jobs.size()),
+        QString::number(job.variant),
+        QFileInfo(job.maze).fileName(),
+        status,
+        0 <= bestTime ? QString(" (%1s)").arg(bestTime) : QString()
+    );
+
+    if (m_numFinished == m_jobs.size()) {
+        if (m_store != nullptr) {
+            m_store->flush();
+        }
+        writeResults();
+        writeSensitivity();
+        writeClearanceSegments();
+        emit finished(0);
+    }
+}
+
+void SweepRunner::storeResult(int id, const QJsonObject& result) {
+
+    const Job& job = m_jobs.at(id);
+    QJsonObject params;
+    for (int i = 0; i < m_parameters.size(); i += 1) {
+        params.insert(getLabel(m_parameters.at(i)), m_variants.at(job.variant).at(i));
+    }
+    params.insert("maxSimSeconds", m_maxSimSeconds);
+    params.insert("stopAtCenter", m_stopAtCenter);
+
+    RunRecord record;
+    record.algo = m_mouseAlgo;
+    record.algoHash = m_algoHash;
+    record.maze = job.maze;
+    record.mazeHash = m_mazeHashes.value(job.maze);
+    record.mouseFileHash = m_variantMouseFileHashes.at(job.variant);
+    record.seed = job.seed;
+    record.params = QJsonDocument(params).toJson(QJsonDocument::Compact);
+    record.status = result.value("status").toString();
+    record.bestTimeToCenter = result.value("bestTimeToCenter").toDouble(-1.0);
+    record.tilesTraversed = result.value("tilesTraversed").toInt();
+    record.closestDistanceToCenter = result.value("closestDistanceToCenter").toInt(-1);
+    record.crashed = result.value("crashed").toBool();
+    record.exitCode = result.value("exitCode").toInt();
+    record.simSeconds = result.value("simSeconds").toDouble();
+    record.realSeconds = result.value("realSeconds").toDouble();
+    record.cpuSeconds = result.value("cpuSeconds").toDouble(-1.0);
+    m_store->insert(record);
+}
+
+void SweepRunner::writeResults() const {
+
+    QFile file(m_outputPath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qWarning().noquote() << "Unable to write the sweep results to" << m_outputPath;
+        return;
+    }
+    QTextStream stream(&file);
+
+    QStringList header = {"job", "variant", "maze", "seed"};
+    for (const SweepParameter& parameter : m_parameters) {
+        header.append(getLabel(parameter));
+    }
+    header.append({
+        "status",
+        "bestTimeToCenter",
+        "tilesTraversed",
+        "closestDistanceToCenter",
+        "crashed",
+        "minClearance",
+        "p5Clearance",
+        "p50Clearance",
+        "simSeconds",
+        "realSeconds",
+        "cpuSeconds",
+        "error",
+    });
+    QStringList fields;
+    for (const QString& field : header) {
+        fields.append(csvField(field));
+    }
+    stream << fields.join(",") << "\n";
+
+    for (int id = 0; id < m_jobs.size(); id += 1) {
+        const Job& job = m_jobs.at(id);
+        const QJsonObject& result = m_results.at(id);
+        QStringList row = {
+            QString::number(id),
+            QString::number(job.variant),
+            csvField(job.maze),
+            QString::number(job.seed),
+        };
+        for (double value : m_variants.at(job.variant)) {
+            row.append(QString::number(value));
+        }
+        row.append({
+            result.value("status").toString(),
+            QString::number(result.value("bestTimeToCenter").toDouble(-1.0)),
+            QString::number(result.value("tilesTraversed").toInt()),
+            QString::number(result.value("closestDistanceToCenter").toInt(-1)),
+            result.value("crashed").toBool() ? "true" : "false",
+            formatClearance(result.value("minClearance")),
+            formatClearance(result.value("p5Clearance")),
+            formatClearance(result.value("p50Clearance")),
+            QString::number(result.value("simSeconds").toDouble()),
+            QString::number(result.value("realSeconds").toDouble()),
+            QString::number(result.value("cpuSeconds").toDouble(-1.0)),
+            csvField(result.value("error").toString()),
+        });
+        stream << row.join(",") << "\n";
+    }
+    qInfo().noquote() << "Wrote the sweep results to" << m_outputPath;
+}
+
+void SweepRunner::writeSensitivity() const {
+
+    QFileInfo info(m_outputPath);
+    QString path = info.dir().filePath(info.completeBaseName() + "-sensitivity.csv");
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qWarning().noquote() << "Unable to write the sweep sensitivity to" << path;
+        return;
+    }
+    QTextStream stream(&file);
+    stream << "parameter,runs,solvedRuns,timeCorrelation,solvedCorrelation,"
+           << "timeMainEffect\n";
+
+    QString table = QString("%1 %2 %3 %4 %5\n").arg(
+        QString("Parameter").leftJustified(40),
+        QString("Solved").rightJustified(9),
+        QString("r(time)").rightJustified(9),
+        QString("r(solved)").rightJustified(9),
+        QString("Effect").rightJustified(9)
+    );
+
+    for (int i = 0; i < m_parameters.size(); i += 1) {
+
+        // Time to center is only meaningful for runs that reached the
+        // center, while the solved rate is measured over every run
+        QVector<double> allValues;
+        QVector<double> solved;
+        QVector<double> solvedValues;
+        QVector<double> solvedTimes;
+        QMap<double, QVector<double>> timesByValue;
+        for (int id = 0; id < m_jobs.size(); id += 1) {
+            const QJsonObject& result = m_results.at(id);
+            if (result.value("status").toString() == "error") {
+                continue;
+            }
+            double value = m_variants.at(m_jobs.at(id).variant).at(i);
+            double bestTime = result.value("bestTimeToCenter").toDouble(-1.0);
+            allValues.append(value);
+            solved.append(0 <= bestTime ? 1.0 : 0.0);
+            if (0 <= bestTime) {
+                solvedValues.append(value);
+                solvedTimes.append(bestTime);
+                timesByValue[value].append(bestTime);
+            }
+        }
+
+        // The main effect is the spread of the mean time across the values
+        // of the parameter, which only makes sense if the values repeat
+        double mainEffect = std::numeric_limits<double>::quiet_NaN();
+        if (m_sampling == "grid" && 1 < timesByValue.size()) {
+            double minMean = std::numeric_limits<double>::max();
+            double maxMean = std::numeric_limits<double>::lowest();
+            for (const QVector<double>& times : timesByValue) {
+                double mean = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+                minMean = std::min(minMean, mean);
+                maxMean = std::max(maxMean, mean);
+            }
+            mainEffect = maxMean - minMean;
+        }
+
+        double timeCorrelation = correlation(solvedValues, solvedTimes);
+        double solvedCorrelation = correlation(allValues, solved);
+        QString label = getLabel(m_parameters.at(i));
+        stream << csvField(label) << ","
+               << allValues.size() << ","
+               << solvedTimes.size() << ","
+               << formatNumber(timeCorrelation) << ","
+               << formatNumber(solvedCorrelation) << ","
+               << formatNumber(mainEffect) << "\n";
+        table += QString("%1 %2 %3 %4 %5\n").arg(
+            label.leftJustified(40),
+            QString("%1/%2").arg(solvedTimes.size()).arg(allValues.size()).rightJustified(9),
+            formatNumber(timeCorrelation).rightJustified(9),
+            formatNumber(solvedCorrelation).rightJustified(9),
+            formatNumber(mainEffect).rightJustified(9)
+        );
+    }
+
+    qInfo().noquote() << "Sensitivity of the time to center to each parameter:";
+    qInfo().noquote() << table.trimmed();
+    qInfo().noquote() << "Wrote the sweep sensitivity to" << path;
+}
+
+void SweepRunner::writeClearanceSegments() const {
+
+    QFileInfo info(m_outputPath);
+    QString path = info.dir().filePath(info.completeBaseName() + "-clearance.csv");
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        qWarning().noquote() << "Unable to write the sweep clearances to" << path;
+        return;
+    }
+    QTextStream stream(&file);
+    stream << "job,segment,x,y,start,end,minClearance,p5Clearance\n";
+
+    // One row per segment (i.e., per stretch of time spent in a tile) of
+    // every job, so that the tightest spots of each run can be found
+    for (int id = 0; id < m_jobs.size(); id += 1) {
+        QJsonArray segments = m_results.at(id).value("clearanceSegments").toArray();
+        for (int i = 0; i < segments.size(); i += 1) {
+            QJsonObject segment = segments.at(i).toObject();
+            stream << id << ","
+                   << i << ","
+                   << segment.value("x").toInt() << ","
+                   << segment.value("y").toInt() << ","
+                   << segment.value("start").toDouble() << ","
+                   << segment.value("end").toDouble() << ","
+                   << segment.value("minClearance").toDouble() << ","
+                   << segment.value("p5Clearance").toDouble() << "\n";
+        }
+    }
+    qInfo().noquote() << "Wrote the sweep clearances to" << path;
+}
+
+QString SweepRunner::getLabel(const SweepParameter& parameter) const {
+    if (parameter.kind == "option") {
+        return parameter.name;
+    }
+    return QString("%1(%2)/%3").arg(parameter.kind, parameter.name, parameter.field);
+}
+
+} // namespace mms
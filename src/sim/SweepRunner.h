@@ -0,0 +1,127 @@
+#pragma once
+
+#include <QByteArray>
+#include <QJsonObject>
+#include <QMap>
+#include <QObject>
+#include <QProcess>
+#include <QString>
+#include <QStringList>
+#include <QTemporaryDir>
+#include <QVector>
+
+#include "ResultsStore.h"
+#include "SweepParameter.h"
+
+namespace mms {
+
+// Runs every variant of a mouse (wheel and sensor fields from the mouse XML,
+// plus mouse interface options) against every maze of a maze set, spread
+// across several headless SweepWorker processes, and then writes a table of
+// results and the sensitivity of the results to each parameter.
+//
+// The sweep is described by a JSON file, e.g.:
+//
+//     {
+//         "mouseAlgo": "Floodfill",
+//         "mouseFile": "mice/default.xml",
+//         "mazes": ["mazes/classic", "mazes/apec2010.num"],
+//         "sampling": "grid",
+//         "maxSimSeconds": 600,
+//         "workers": 4,
+//         "parameters": [
+//             {"wheel": "*", "field": "Max-Speed", "values": [800, 1200]},
+//             {"sensor": "front", "field": "Range", "min": 0.1, "max": 0.3, "steps": 3},
+//             {"option": "setWheelSpeedFraction", "values": [0.5, 1.0]}
+//         ]
+//     }
+//
+// Relative paths are relative to the JSON file, and maze directories stand
+// for every file within them. The "sampling" may also be "latin-hypercube",
+// with a number of "samples". Other optional keys are "seed", "repeats" (the
+// number of seeds per variant and maze), "stopAtCenter", "output" (the path
+// of the results CSV; the sensitivity and clearance CSVs are written next to
+// it), and "database" (a ResultsStore that every run is added to).
+class SweepRunner : public QObject {
+
+    Q_OBJECT
+
+public:
+
+    SweepRunner(QObject* parent = 0);
+    ~SweepRunner();
+
+    // Loads the spec and starts the workers; returns false if the spec is invalid
+    bool start(const QString& specFilePath);
+
+signals:
+
+    // Emitted once every job has a result
+    void finished(int exitCode);
+
+private:
+
+    // The values of the spec
+    QString m_mouseAlgo;
+    QString m_mouseFile;
+    QStringList m_mazes;
+    QString m_outputPath;
+    QString m_databasePath;
+    QString m_sampling;
+    int m_samples;
+    int m_repeats;
+    int m_seed;
+    int m_numWorkers;
+    double m_maxSimSeconds;
+    bool m_stopAtCenter;
+    QVector<SweepParameter> m_parameters;
+
+    // The value of each parameter, for each variant, and the mouse file that
+    // each variant uses (generated within the temporary directory)
+    QVector<QVector<double>> m_variants;
+    QStringList m_variantMouseFiles;
+    QTemporaryDir m_variantDir;
+
+    // Where every run is recorded, if anywhere, and the hashes that identify
+    // the algorithm version, mazes, and mouse files within it
+    ResultsStore* m_store;
+    QString m_algoHash;
+    QMap<QString, QString> m_mazeHashes;
+    QStringList m_variantMouseFileHashes;
+
+    // Each job is one variant, on one maze, with one seed
+    struct Job {
+        int variant;
+        QString maze;
+        int seed;
+    };
+    QVector<Job> m_jobs;
+    QVector<QJsonObject> m_results;
+    int m_nextJob;
+    int m_numFinished;
+
+    // The workers, the job that each is running, and their partial output
+    QVector<QProcess*> m_workers;
+    QMap<QProcess*, int> m_jobInProgress;
+    QMap<QProcess*, QByteArray> m_workerOutput;
+
+    bool loadSpec(const QString& specFilePath);
+    bool loadParameter(const QJsonObject& object, SweepParameter* parameter);
+    void generateVariants();
+    bool writeVariantMouseFiles();
+    QJsonObject getJobObject(int id) const;
+
+    bool startWorker();
+    void dispatchNextJob(QProcess* worker);
+    void handleWorkerOutput(QProcess* worker);
+    void handleWorkerFinished(QProcess* worker);
+    void handleResult(int id, const QJsonObject& result);
+    void storeResult(int id, const QJsonObject& result);
+
+    void writeResults() const;
+    void writeSensitivity() const;
+    void writeClearanceSegments() const;
+    QString getLabel(const SweepParameter& parameter) const;
+};
+
+} // namespace mms
@@ -0,0 +1,280 @@
+#include "SweepWorker.h"
+
+#include <QCoreApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonValue>
+
+#include "Assert.h"
+#include "MouseStats.h"
+#include "Param.h"
+#include "ProcessUtilities.h"
+#include "SettingsMouseAlgos.h"
+#include "SimTime.h"
+#include "SimUtilities.h"
+
+namespace mms {
+
+const QString SweepWorker::RESULT_PREFIX = "SWEEP-RESULT ";
+
+SweepWorker::SweepWorker(QObject* parent) :
+        QObject(parent),
+        m_stdin(stdin),
+        m_stdout(stdout),
+        m_startRealTime(0.0),
+        m_startCpuSeconds(0.0),
+        m_running(false),
+        m_processExited(false),
+        m_exitCode(0),
+        m_mouse(nullptr),
+        m_view(nullptr),
+        m_mouseInterface(nullptr),
+        m_process(nullptr) {
+
+    // There's nobody watching, so run as fast as we're allowed to
+    m_model.setSimSpeed(P()->maxSimSpeed());
+
+    m_watchdog.setInterval(20);
+    connect(&m_watchdog, &QTimer::timeout, this, &SweepWorker::checkJob);
+}
+
+SweepWorker::~SweepWorker() {
+    if (m_running) {
+        finishJob("canceled");
+    }
+    m_model.shutdown();
+    m_modelThread.quit();
+    m_modelThread.wait();
+    qDeleteAll(m_mazes);
+}
+
+void SweepWorker::start() {
+    connect(&m_modelThread, &QThread::started, &m_model, &Model::start);
+    m_model.moveToThread(&m_modelThread);
+    m_modelThread.start();
+    QTimer::singleShot(0, this, &SweepWorker::readNextJob);
+}
+
+void SweepWorker::readNextJob() {
+
+    // Note that this blocks, but there's nothing else to do until we get a
+    // job, since the model is idle whenever there's no mouse
+    QString line = m_stdin.readLine();
+    if (line.isNull()) {
+        QCoreApplication::quit();
+        return;
+    }
+
+    QJsonDocument document = QJsonDocument::fromJson(line.toUtf8());
+    if (!document.isObject()) {
+        qWarning().noquote() << "Invalid sweep job:" << line;
+        m_job = QJsonObject();
+        finishJob("error", "invalid job");
+        return;
+    }
+    startJob(document.object());
+}
+
+void SweepWorker::startJob(const QJsonObject& job) {
+
+    ASSERT_FA(m_running);
+    m_job = job;
+
+    // Load the maze, or reuse it if a previous job already loaded it
+    QString mazePath = job.value("maze").toString();
+    Maze* maze = m_mazes.value(mazePath, nullptr);
+    if (maze == nullptr) {
+        maze = Maze::fromFile(mazePath);
+        if (maze == nullptr) {
+            finishJob("error", "unable to load maze");
+            return;
+        }
+        m_mazes.insert(mazePath, maze);
+    }
+    if (!maze->isValidMaze()) {
+        finishJob("error", "invalid maze");
+        return;
+    }
+
+    // Look up how to run the algorithm
+    QString algoName = job.value("mouseAlgo").toString();
+    QString dirPath = SettingsMouseAlgos::getDirPath(algoName);
+    QString command = SettingsMouseAlgos::getRunCommand(algoName);
+    if (dirPath.isEmpty() || command.isEmpty()) {
+        finishJob("error", "unknown mouse algorithm");
+        return;
+    }
+    command += " ";
+    command += QString::number(job.value("seed").toInt());
+
+    // Generate the mouse
+    Mouse* mouse = new Mouse(maze);
+    if (!mouse->reload(job.value("mouseFile").toString())) {
+        delete mouse;
+        finishJob("error", "invalid mouse file");
+        return;
+    }
+
+    m_model.setMaze(maze);
+    m_mouse = mouse;
+    m_view = new MazeView(maze, false, false, false, false, false);
+    m_mouseInterface = new MouseInterface(maze, m_mouse, m_view, &m_model);
+    m_process = new QProcess();
+    m_processExited = false;
+    m_exitCode = 0;
+    m_stderrBuffer.clear();
+
+    // The swept options are applied before the algorithm starts, and are
+    // ignored if the algorithm sets them, so that it can't override them
+    QSet<QString> pinnedCommands;
+    QJsonObject commands = job.value("commands").toObject();
+    for (auto it = commands.constBegin(); it != commands.constEnd(); ++it) {
+        m_mouseInterface->dispatch(it.key() + " " + it.value().toString());
+        pinnedCommands.insert(it.key());
+    }
+    m_mouseInterface->setIgnoredCommands(pinnedCommands);
+
+    // Nobody reads the algorithm's output, but it has to be drained
+    QProcess* process = m_process;
+    MouseInterface* mouseInterface = m_mouseInterface;
+    connect(process, &QProcess::readyReadStandardOutput, this, [=](){
+        process->readAllStandardOutput();
+    });
+    connect(process, &QProcess::readyReadStandardError, this, [=](){
+        QString text = process->readAllStandardError();
+        QStringList lines = SimUtilities::getLines(text, &m_stderrBuffer);
+        for (const QString& line : lines) {
+            mouseInterface->handleCommand(line);
+        }
+    });
+    connect(mouseInterface, &MouseInterface::response, this, [=](QString response){
+        process->write((response + "\n").toStdString().c_str());
+    });
+    connect(
+        process,
+        static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(
+            &QProcess::finished
+        ),
+        this,
+        [=](int exitCode, QProcess::ExitStatus exitStatus){
+            m_processExited = true;
+            m_exitCode = (exitStatus == QProcess::NormalExit ? exitCode : -1);
+        }
+    );
+
+    m_model.setMouse(m_mouse);
+    m_startRealTime = SimUtilities::getHighResTimestamp();
+    m_startCpuSeconds = ProcessUtilities::getFinishedChildrenCpuSeconds();
+    m_running = true;
+    if (!ProcessUtilities::start(command, dirPath, process)) {
+        finishJob("error", process->errorString());
+        return;
+    }
+    m_mouseInterface->setAlgoProcessId(process->processId());
+    m_watchdog.start();
+}
+
+void SweepWorker::checkJob() {
+    if (!m_running) {
+        return;
+    }
+    double maxSimSeconds = m_job.value("maxSimSeconds").toDouble();
+    if (m_mouse->didCrash()) {
+        finishJob("crashed");
+    }
+    else if (m_processExited) {
+        finishJob("exited");
+    }
+    else if (
+        0 < maxSimSeconds &&
+        maxSimSeconds <= SimTime::get()->elapsedSimTime().getSeconds()
+    ) {
+        finishJob("timeout");
+    }
+    else if (
+        m_job.value("stopAtCenter").toBool() &&
+        0 <= m_model.getMouseStats().bestTimeToCenter.getSeconds()
+    ) {
+        finishJob("center");
+    }
+}
+
+void SweepWorker::finishJob(const QString& status, const QString& error) {
+
+    QJsonObject result;
+    result.insert("id", m_job.value("id"));
+    result.insert("status", status);
+    if (!error.isEmpty()) {
+        result.insert("error", error);
+    }
+
+    if (m_running) {
+        m_running = false;
+        m_watchdog.stop();
+
+        // Stop the algorithm, as in Window::mouseAlgoRunStop
+        m_mouseInterface->requestStop();
+
+        MouseStats stats = m_model.getMouseStats();
+        result.insert("simSeconds", SimTime::get()->elapsedSimTime().getSeconds());
+        result.insert("realSeconds", SimUtilities::getHighResTimestamp() - m_startRealTime);
+        result.insert("bestTimeToCenter", stats.bestTimeToCenter.getSeconds());
+        result.insert("tilesTraversed", stats.traversedTileLocations.size());
+        result.insert("closestDistanceToCenter", stats.closestDistanceToCenter);
+        result.insert("crashed", m_mouse->didCrash());
+        if (0 < stats.clearance.getCount()) {
+            result.insert("minClearance", stats.clearance.getMin());
+            result.insert("p5Clearance", stats.clearance.getPercentile(0.05));
+            result.insert("p50Clearance", stats.clearance.getPercentile(0.5));
+            QJsonArray segments;
+            for (const ClearanceSegment& segment : stats.clearance.getSegments()) {
+                QJsonObject object;
+                object.insert("x", segment.tile.first);
+                object.insert("y", segment.tile.second);
+                object.insert("start", segment.start.getSeconds());
+                object.insert("end", segment.end.getSeconds());
+                object.insert("minClearance", segment.minClearance);
+                object.insert("p5Clearance", segment.p5Clearance);
+                segments.append(object);
+            }
+            result.insert("clearanceSegments", segments);
+        }
+        result.insert("exitCode", m_exitCode);
+        m_model.removeMouse();
+
+        m_process->disconnect(this);
+        if (m_process->state() != QProcess::NotRunning) {
+            m_process->terminate();
+            if (!m_process->waitForFinished(1000)) {
+                m_process->kill();
+                m_process->waitForFinished();
+            }
+        }
+        delete m_process;
+        m_process = nullptr;
+
+        // The algorithm has been waited for, so its CPU time is now counted
+        double cpuSeconds = ProcessUtilities::getFinishedChildrenCpuSeconds();
+        result.insert(
+            "cpuSeconds",
+            0 <= cpuSeconds ? cpuSeconds - m_startCpuSeconds : -1.0
+        );
+        delete m_mouseInterface;
+        delete m_view;
+        delete m_mouse;
+        m_mouseInterface = nullptr;
+        m_view = nullptr;
+        m_mouse = nullptr;
+    }
+
+    writeResult(result);
+    QTimer::singleShot(0, this, &SweepWorker::readNextJob);
+}
+
+void SweepWorker::writeResult(const QJsonObject& result) {
+    m_stdout << RESULT_PREFIX
+             << QJsonDocument(result).toJson(QJsonDocument::Compact)
+             << endl;
+}
+
+} // namespace mms
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QJsonObject>
+#include <QMap>
+#include <QObject>
+#include <QProcess>
+#include <QString>
+#include <QStringList>
+#include <QTextStream>
+#include <QThread>
+#include <QTimer>
+
+#include "Maze.h"
+#include "MazeView.h"
+#include "Model.h"
+#include "Mouse.h"
+#include "MouseInterface.h"
+
+namespace mms {
+
+// Runs the jobs of a parameter sweep without a window, one at a time. Each
+// job is a JSON object read from a line of stdin, and each result is a JSON
+// object written to a line of stdout (see SweepRunner for the fields). Mazes
+// are immutable, so each one is loaded once and reused by every job.
+class SweepWorker : public QObject {
+
+    Q_OBJECT
+
+public:
+
+    // Results are written on lines that start with this prefix, so that
+    // they can be told apart from log messages, which also go to stdout
+    static const QString RESULT_PREFIX;
+
+    SweepWorker(QObject* parent = 0);
+    ~SweepWorker();
+
+    // Starts reading jobs; quits the application once stdin is closed
+    void start();
+
+private:
+
+    // Like the Window, the model gets its own thread
+    Model m_model;
+    QThread m_modelThread;
+
+    QTextStream m_stdin;
+    QTextStream m_stdout;
+
+    // Every maze that's been loaded so far, by path
+    QMap<QString, Maze*> m_mazes;
+
+    // Checks the stopping conditions of the current job
+    QTimer m_watchdog;
+
+    // The current job, and the objects that exist only for its duration
+    QJsonObject m_job;
+    double m_startRealTime;
+    double m_startCpuSeconds;
+    bool m_running;
+    bool m_processExited;
+    int m_exitCode;
+    Mouse* m_mouse;
+    MazeView* m_view;
+    MouseInterface* m_mouseInterface;
+    QProcess* m_process;
+    QStringList m_stderrBuffer;
+
+    void readNextJob();
+    void startJob(const QJsonObject& job);
+    void checkJob();
+    void finishJob(const QString& status, const QString& error = "");
+    void writeResult(const QJsonObject& result);
+};
+
+} // namespace mms
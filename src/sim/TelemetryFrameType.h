@@ -0,0 +1,38 @@
+#pragma once
+
+#include <QtGlobal>
+
+namespace mms {
+
+// The telemetry stream is a sequence of frames, each of which is laid out as
+//
+//     [quint32 size][quint8 TelemetryFrameType][payload...]
+//
+// where size counts the type byte and the payload. All values are written
+// with QDataStream (big-endian, Qt_5_0 format).
+enum class TelemetryFrameType : quint8 {
+    // Resets the viewer. Payload: the mouse file path (QString, possibly
+    // empty), the maze width and height (quint16 each), and then one quint8
+    // per tile, in column-major order, with bit i set if there's a wall in
+    // the direction DIRECTIONS().at(i)
+    MAZE = 0,
+    // Payload: sim time in seconds, mouse x and y in meters, and mouse
+    // rotation in radians (double each), followed by a quint32 count of
+    // deltas, each of which begins with a TelemetryDeltaType
+    UPDATE = 1,
+};
+
+// Every delta is laid out as [quint8 type][quint16 x][quint16 y][value...]
+enum class TelemetryDeltaType : quint8 {
+    // Value: the color, as a quint8 Color
+    TILE_COLOR = 0,
+    // Value: the direction (quint8 Direction), and then 0 (no wall), 1 (wall),
+    // or 2 (undeclared) as a quint8
+    TILE_WALL = 1,
+    // Value: 0 (clear) or 1 (foggy) as a quint8
+    TILE_FOG = 2,
+    // Value: the text, as a QString
+    TILE_TEXT = 3,
+};
+
+} // namespace mms
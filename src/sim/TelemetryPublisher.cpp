@@ -0,0 +1,281 @@
+#include "TelemetryPublisher.h"
+
+#include <QDataStream>
+
+#include "Assert.h"
+#include "SimTime.h"
+
+namespace mms {
+
+TelemetryPublisher::TelemetryPublisher(
+        const QString& name,
+        int updateRate,
+        int maxBufferedBytes,
+        QObject* parent) :
+    QObject(parent),
+    m_maxBufferedBytes(maxBufferedBytes),
+    m_maze(nullptr),
+    m_mouse(nullptr),
+    m_resetPending(false) {
+
+    ASSERT_LT(0, updateRate);
+
+    // Remove any socket left behind by a sim that didn't exit cleanly
+    QLocalServer::removeServer(name);
+    if (!m_server.listen(name)) {
+        qWarning().noquote().nospace()
+            << "Unable to open telemetry socket \"" << name << "\": "
+            << m_server.errorString() << ".";
+        return;
+    }
+    qInfo().noquote().nospace()
+        << "Publishing telemetry on \"" << m_server.fullServerName() << "\".";
+
+    connect(
+        &m_server, &QLocalServer::newConnection,
+        this, &TelemetryPublisher::onNewConnection
+    );
+    connect(&m_timer, &QTimer::timeout, this, &TelemetryPublisher::onTimeout);
+    m_timer.start(1000 / updateRate);
+}
+
+TelemetryPublisher::~TelemetryPublisher() {
+    m_server.close();
+}
+
+bool TelemetryPublisher::isListening() const {
+    return m_server.isListening();
+}
+
+void TelemetryPublisher::setMaze(const Maze* maze) {
+    m_mutex.lock();
+    m_maze = maze;
+    m_mouse = nullptr;
+    reset();
+    m_mutex.unlock();
+}
+
+void TelemetryPublisher::setMouse(const Mouse* mouse) {
+    m_mutex.lock();
+    m_mouse = mouse;
+    reset();
+    m_mutex.unlock();
+}
+
+void TelemetryPublisher::publishTileColor(int x, int y, Color color) {
+    QByteArray value;
+    QDataStream stream(&value, QIODevice::WriteOnly);
+    stream << static_cast<quint8>(color);
+    addDelta(TelemetryDeltaType::TILE_COLOR, x, y, 0, value);
+}
+
+void TelemetryPublisher::publishTileWall(int x, int y, Direction direction, bool isWall) {
+    QByteArray value;
+    QDataStream stream(&value, QIODevice::WriteOnly);
+    stream << static_cast<quint8>(direction) << static_cast<quint8>(isWall ? 1 : 0);
+    addDelta(TelemetryDeltaType::TILE_WALL, x, y, static_cast<int>(direction), value);
+}
+
+void TelemetryPublisher::publishTileWallUndeclared(int x, int y, Direction direction) {
+    QByteArray value;
+    QDataStream stream(&value, QIODevice::WriteOnly);
+    stream << static_cast<quint8>(direction) << static_cast<quint8>(2);
+    addDelta(TelemetryDeltaType::TILE_WALL, x, y, static_cast<int>(direction), value);
+}
+
+void TelemetryPublisher::publishTileFog(int x, int y, bool foggy) {
+    QByteArray value;
+    QDataStream stream(&value, QIODevice::WriteOnly);
+    stream << static_cast<quint8>(foggy ? 1 : 0);
+    addDelta(TelemetryDeltaType::TILE_FOG, x, y, 0, value);
+}
+
+void TelemetryPublisher::publishTileText(int x, int y, const QString& text) {
+    QByteArray value;
+    QDataStream stream(&value, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream << text;
+    addDelta(TelemetryDeltaType::TILE_TEXT, x, y, 0, value);
+}
+
+void TelemetryPublisher::onNewConnection() {
+    while (m_server.hasPendingConnections()) {
+        QLocalSocket* subscriber = m_server.nextPendingConnection();
+        connect(
+            subscriber, &QLocalSocket::disconnected,
+            this, [=](){
+                m_subscribers.remove(subscriber);
+                m_stale.remove(subscriber);
+                subscriber->deleteLater();
+            }
+        );
+        // New subscribers start out stale, so that they're sent the maze and
+        // the current state of the view on the next tick
+        m_subscribers.insert(subscriber);
+        m_stale.insert(subscriber);
+    }
+}
+
+void TelemetryPublisher::onTimeout() {
+
+    // Grab everything that other threads have handed us since the last tick
+    m_mutex.lock();
+    bool resetPending = m_resetPending;
+    m_resetPending = false;
+    QByteArray mazeFrame = m_mazeFrame;
+    QVector<QPair<quint64, QByteArray>> deltas;
+    deltas.swap(m_pendingDeltas);
+    MouseSnapshot snapshot;
+    if (m_mouse != nullptr) {
+        snapshot = m_mouse->getCurrentSnapshot();
+    }
+    m_mutex.unlock();
+
+    // Nothing to show until there's a maze
+    if (mazeFrame.isEmpty()) {
+        return;
+    }
+
+    // A reset invalidates everything that every subscriber has seen so far
+    if (resetPending) {
+        m_latestDeltas.clear();
+        m_stale = m_subscribers;
+    }
+    for (const QPair<quint64, QByteArray>& delta : deltas) {
+        m_latestDeltas.insert(delta.first, delta.second);
+    }
+
+    // Build the update frame for subscribers that are up to date
+    QByteArray pose;
+    QDataStream poseStream(&pose, QIODevice::WriteOnly);
+    poseStream.setVersion(QDataStream::Qt_5_0);
+    poseStream
+        << SimTime::get()->elapsedSimTime().getSeconds()
+        << snapshot.translation.getX().getMeters()
+        << snapshot.translation.getY().getMeters()
+        << snapshot.rotation.getRadiansZeroTo2pi();
+    QByteArray update = updateFrame(pose, deltas);
+
+    for (QLocalSocket* subscriber : m_subscribers) {
+        if (m_stale.contains(subscriber)) {
+            // Wait for slow subscribers to drain before resynchronizing them,
+            // so that they never hold up the rest
+            if (subscriber->bytesToWrite() == 0) {
+                resynchronize(subscriber, mazeFrame, pose);
+            }
+        }
+        else if (!write(subscriber, update)) {
+            m_stale.insert(subscriber);
+        }
+    }
+}
+
+void TelemetryPublisher::reset() {
+
+    m_mazeFrame.clear();
+    m_pendingDeltas.clear();
+    m_resetPending = true;
+    if (m_maze == nullptr) {
+        return;
+    }
+
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream
+        << (m_mouse != nullptr ? m_mouse->getMouseFile() : QString())
+        << static_cast<quint16>(m_maze->getWidth())
+        << static_cast<quint16>(m_maze->getHeight());
+    for (int x = 0; x < m_maze->getWidth(); x += 1) {
+        for (int y = 0; y < m_maze->getHeight(); y += 1) {
+            quint8 walls = 0;
+            for (int i = 0; i < DIRECTIONS().size(); i += 1) {
+                if (m_maze->getTile(x, y)->isWall(DIRECTIONS().at(i))) {
+                    walls |= (1 << i);
+                }
+            }
+            stream << walls;
+        }
+    }
+    m_mazeFrame = frame(TelemetryFrameType::MAZE, payload);
+}
+
+void TelemetryPublisher::addDelta(
+        TelemetryDeltaType type,
+        int x,
+        int y,
+        int direction,
+        const QByteArray& value) {
+
+    QByteArray delta;
+    QDataStream stream(&delta, QIODevice::WriteOnly);
+    stream
+        << static_cast<quint8>(type)
+        << static_cast<quint16>(x)
+        << static_cast<quint16>(y);
+    delta.append(value);
+
+    // Identifies the tile property that this delta overwrites
+    quint64 key =
+        (static_cast<quint64>(type) << 48) |
+        (static_cast<quint64>(direction) << 32) |
+        (static_cast<quint64>(x) << 16) |
+        static_cast<quint64>(y);
+
+    m_mutex.lock();
+    m_pendingDeltas.append({key, delta});
+    m_mutex.unlock();
+}
+
+void TelemetryPublisher::resynchronize(
+        QLocalSocket* subscriber,
+        const QByteArray& mazeFrame,
+        const QByteArray& pose) {
+
+    if (!write(subscriber, mazeFrame)) {
+        return;
+    }
+
+    // Replay the latest value of every tile property. This catch-up frame
+    // may be large, so it's exempt from the buffered bytes limit.
+    QVector<QPair<quint64, QByteArray>> deltas;
+    deltas.reserve(m_latestDeltas.size());
+    QHash<quint64, QByteArray>::const_iterator it;
+    for (it = m_latestDeltas.constBegin(); it != m_latestDeltas.constEnd(); it += 1) {
+        deltas.append({it.key(), it.value()});
+    }
+    subscriber->write(updateFrame(pose, deltas));
+    m_stale.remove(subscriber);
+}
+
+bool TelemetryPublisher::write(QLocalSocket* subscriber, const QByteArray& frame) {
+    if (m_maxBufferedBytes < subscriber->bytesToWrite() + frame.size()) {
+        return false;
+    }
+    subscriber->write(frame);
+    return true;
+}
+
+QByteArray TelemetryPublisher::updateFrame(
+        const QByteArray& pose,
+        const QVector<QPair<quint64, QByteArray>>& deltas) {
+    QByteArray payload(pose);
+    QDataStream stream(&payload, QIODevice::WriteOnly | QIODevice::Append);
+    stream << static_cast<quint32>(deltas.size());
+    for (const QPair<quint64, QByteArray>& delta : deltas) {
+        stream.writeRawData(delta.second.constData(), delta.second.size());
+    }
+    return frame(TelemetryFrameType::UPDATE, payload);
+}
+
+QByteArray TelemetryPublisher::frame(TelemetryFrameType type, const QByteArray& payload) {
+    QByteArray bytes;
+    QDataStream stream(&bytes, QIODevice::WriteOnly);
+    stream
+        << static_cast<quint32>(payload.size() + 1)
+        << static_cast<quint8>(type);
+    bytes.append(payload);
+    return bytes;
+}
+
+} // namespace mms
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <QByteArray>
+#include <QHash>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QMutex>
+#include <QObject>
+#include <QPair>
+#include <QSet>
+#include <QString>
+#include <QTimer>
+#include <QVector>
+
+#include "Color.h"
+#include "Direction.h"
+#include "Maze.h"
+#include "Mouse.h"
+#include "TelemetryFrameType.h"
+
+namespace mms {
+
+// Streams the state of a run over a local (Unix-domain) socket so that
+// external viewers can watch it. Any number of subscribers may attach or
+// detach at any time; a subscriber that can't keep up has frames dropped,
+// and is resynchronized once it catches up, rather than slowing down the
+// simulation. See TelemetryFrameType.h for the wire format.
+class TelemetryPublisher : public QObject {
+
+    Q_OBJECT
+
+public:
+
+    TelemetryPublisher(
+        const QString& name,
+        int updateRate,
+        int maxBufferedBytes,
+        QObject* parent = 0);
+    ~TelemetryPublisher();
+
+    // Returns whether or not the socket could be opened
+    bool isListening() const;
+
+    // Sets the maze/mouse that subscribers see, and resets their views. The
+    // mouse may be null. Safe to call from any thread.
+    void setMaze(const Maze* maze);
+    void setMouse(const Mouse* mouse);
+
+    // Records changes to the mouse's view of the maze, which are sent along
+    // with the next update frame. Safe to call from any thread.
+    void publishTileColor(int x, int y, Color color);
+    void publishTileWall(int x, int y, Direction direction, bool isWall);
+    void publishTileWallUndeclared(int x, int y, Direction direction);
+    void publishTileFog(int x, int y, bool foggy);
+    void publishTileText(int x, int y, const QString& text);
+
+private:
+
+    QLocalServer m_server;
+    QTimer m_timer;
+    int m_maxBufferedBytes;
+
+    // All attached subscribers, and the ones that missed a frame and so
+    // need to be resynchronized once they've drained their buffers
+    QSet<QLocalSocket*> m_subscribers;
+    QSet<QLocalSocket*> m_stale;
+
+    // Guards everything below, which may be written by other threads
+    QMutex m_mutex;
+    const Maze* m_maze;
+    const Mouse* m_mouse;
+    QByteArray m_mazeFrame;
+    bool m_resetPending;
+    QVector<QPair<quint64, QByteArray>> m_pendingDeltas;
+
+    // The latest delta for each tile property, used to bring new or stale
+    // subscribers up to date; only touched on the publisher's thread
+    QHash<quint64, QByteArray> m_latestDeltas;
+
+    void onNewConnection();
+    void onTimeout();
+
+    // Rebuilds the maze frame and schedules a reset of all subscribers; must
+    // be called with m_mutex held
+    void reset();
+
+    void addDelta(
+        TelemetryDeltaType type,
+        int x,
+        int y,
+        int direction,
+        const QByteArray& value);
+
+    // Sends the maze frame and all of the latest deltas to one subscriber
+    void resynchronize(
+        QLocalSocket* subscriber,
+        const QByteArray& mazeFrame,
+        const QByteArray& pose);
+
+    // Writes a frame to a subscriber, unless doing so would exceed the
+    // buffered bytes limit; returns whether or not the frame was written
+    bool write(QLocalSocket* subscriber, const QByteArray& frame);
+
+    static QByteArray updateFrame(
+        const QByteArray& pose,
+        const QVector<QPair<quint64, QByteArray>>& deltas);
+    static QByteArray frame(TelemetryFrameType type, const QByteArray& payload);
+
+};
+
+} // namespace mms
@@ -0,0 +1,235 @@
+#include "TelemetryViewer.h"
+
+#include <QCloseEvent>
+#include <QDataStream>
+#include <QVBoxLayout>
+
+#include "BasicMaze.h"
+#include "Color.h"
+#include "Direction.h"
+#include "TelemetryFrameType.h"
+#include "units/Angle.h"
+#include "units/Coordinate.h"
+#include "units/Distance.h"
+
+namespace mms {
+
+TelemetryViewer::TelemetryViewer(const QString& name, QWidget* parent) :
+        QWidget(parent),
+        m_name(name),
+        m_status(new QLabel()),
+        m_maze(nullptr),
+        m_view(nullptr),
+        m_mouse(nullptr),
+        m_mouseGraphic(nullptr) {
+
+    setWindowTitle(QString("Telemetry Viewer - %1").arg(name));
+
+    QVBoxLayout* layout = new QVBoxLayout();
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->setSpacing(0);
+    setLayout(layout);
+    layout->addWidget(&m_map);
+    layout->addWidget(m_status);
+    m_map.setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Expanding);
+    m_status->setAlignment(Qt::AlignCenter);
+    m_status->setText("CONNECTING");
+
+    // Keep trying to (re)connect, so that the viewer can be started before
+    // the sim, and can outlive it
+    connect(&m_reconnectTimer, &QTimer::timeout, this, [=](){
+        if (m_socket.state() == QLocalSocket::UnconnectedState) {
+            m_socket.connectToServer(m_name, QIODevice::ReadOnly);
+        }
+    });
+    m_reconnectTimer.start(1000);
+    connect(&m_socket, &QLocalSocket::connected, this, [=](){
+        m_status->setText("CONNECTED");
+    });
+    connect(&m_socket, &QLocalSocket::disconnected, this, [=](){
+        m_status->setText("DISCONNECTED");
+        m_buffer.clear();
+    });
+    connect(&m_socket, &QLocalSocket::readyRead, this, &TelemetryViewer::onReadyRead);
+    m_socket.connectToServer(m_name, QIODevice::ReadOnly);
+
+    // Redraw at the same rate as the main window
+    QTimer* mapTimer = new QTimer(this);
+    connect(mapTimer, &QTimer::timeout, &m_map, [=](){
+        m_map.update();
+    });
+    mapTimer->start(1000 / 60);
+}
+
+TelemetryViewer::~TelemetryViewer() {
+    clear();
+}
+
+void TelemetryViewer::closeEvent(QCloseEvent* event) {
+    m_reconnectTimer.stop();
+    m_socket.abort();
+    m_map.shutdown();
+    QWidget::closeEvent(event);
+}
+
+void TelemetryViewer::onReadyRead() {
+    m_buffer.append(m_socket.readAll());
+    int offset = 0;
+    while (m_buffer.size() - offset >= 5) {
+        quint32 size;
+        QDataStream stream(m_buffer.mid(offset, 4));
+        stream >> size;
+        if (m_buffer.size() - offset - 4 < static_cast<int>(size)) {
+            break;
+        }
+        TelemetryFrameType type = static_cast<TelemetryFrameType>(
+            static_cast<quint8>(m_buffer.at(offset + 4)));
+        QByteArray payload = m_buffer.mid(offset + 5, size - 1);
+        if (type == TelemetryFrameType::MAZE) {
+            handleMazeFrame(payload);
+        }
+        else if (type == TelemetryFrameType::UPDATE) {
+            handleUpdateFrame(payload);
+        }
+        offset += 4 + size;
+    }
+    m_buffer.remove(0, offset);
+}
+
+void TelemetryViewer::handleMazeFrame(const QByteArray& payload) {
+
+    QDataStream stream(payload);
+    stream.setVersion(QDataStream::Qt_5_0);
+    QString mouseFile;
+    quint16 width;
+    quint16 height;
+    stream >> mouseFile >> width >> height;
+
+    BasicMaze basicMaze;
+    for (int x = 0; x < width; x += 1) {
+        QVector<BasicTile> column;
+        for (int y = 0; y < height; y += 1) {
+            quint8 walls;
+            stream >> walls;
+            BasicTile tile;
+            for (int i = 0; i < DIRECTIONS().size(); i += 1) {
+                tile.insert(DIRECTIONS().at(i), (walls >> i) & 1);
+            }
+            column.append(tile);
+        }
+        basicMaze.append(column);
+    }
+    if (stream.status() != QDataStream::Ok) {
+        qWarning() << "Received a malformed telemetry maze frame.";
+        return;
+    }
+
+    clear();
+    m_maze = Maze::fromBasicMaze(basicMaze);
+    m_view = new MazeView(
+        m_maze,
+        true, // wallTruthVisible
+        true, // tileColorsVisible
+        true, // tileFogVisible
+        true, // tileTextVisible
+        false // autopopulateTextWithDistance
+    );
+    m_map.setMaze(m_maze);
+    m_map.setView(m_view);
+
+    // The mouse is only ever teleported, so that we can reuse its graphic
+    if (!mouseFile.isEmpty()) {
+        m_mouse = new Mouse(m_maze);
+        if (m_mouse->reload(mouseFile)) {
+            m_mouseGraphic = new MouseGraphic(m_mouse);
+            m_map.setMouseGraphic(m_mouseGraphic);
+        }
+        else {
+            delete m_mouse;
+            m_mouse = nullptr;
+        }
+    }
+}
+
+void TelemetryViewer::handleUpdateFrame(const QByteArray& payload) {
+
+    if (m_view == nullptr) {
+        return;
+    }
+
+    QDataStream stream(payload);
+    stream.setVersion(QDataStream::Qt_5_0);
+    double seconds;
+    double x;
+    double y;
+    double rotation;
+    quint32 numDeltas;
+    stream >> seconds >> x >> y >> rotation >> numDeltas;
+    if (m_mouse != nullptr) {
+        m_mouse->teleport(
+            Coordinate::Cartesian(Distance::Meters(x), Distance::Meters(y)),
+            Angle::Radians(rotation));
+    }
+    m_status->setText(QString("CONNECTED - %1s").arg(seconds, 0, 'f', 3));
+
+    MazeGraphic* graphic = m_view->getMazeGraphic();
+    for (quint32 i = 0; i < numDeltas && stream.status() == QDataStream::Ok; i += 1) {
+        quint8 type;
+        quint16 tileX;
+        quint16 tileY;
+        stream >> type >> tileX >> tileY;
+        if (!m_maze->withinMaze(tileX, tileY)) {
+            break;
+        }
+        switch (static_cast<TelemetryDeltaType>(type)) {
+            case TelemetryDeltaType::TILE_COLOR: {
+                quint8 color;
+                stream >> color;
+                graphic->setTileColor(tileX, tileY, static_cast<Color>(color));
+                break;
+            }
+            case TelemetryDeltaType::TILE_WALL: {
+                quint8 direction;
+                quint8 state;
+                stream >> direction >> state;
+                if (state == 2) {
+                    graphic->undeclareWall(tileX, tileY, static_cast<Direction>(direction));
+                }
+                else {
+                    graphic->declareWall(tileX, tileY, static_cast<Direction>(direction), state == 1);
+                }
+                break;
+            }
+            case TelemetryDeltaType::TILE_FOG: {
+                quint8 foggy;
+                stream >> foggy;
+                graphic->setTileFogginess(tileX, tileY, foggy == 1);
+                break;
+            }
+            case TelemetryDeltaType::TILE_TEXT: {
+                QString text;
+                stream >> text;
+                graphic->setTileText(tileX, tileY, text);
+                break;
+            }
+            default:
+                // An unknown delta type means we can't find the next delta
+                return;
+        }
+    }
+}
+
+void TelemetryViewer::clear() {
+    m_map.setMouseGraphic(nullptr);
+    m_map.setMaze(nullptr);
+    delete m_mouseGraphic;
+    delete m_mouse;
+    delete m_view;
+    delete m_maze;
+    m_mouseGraphic = nullptr;
+    m_mouse = nullptr;
+    m_view = nullptr;
+    m_maze = nullptr;
+}
+
+} // namespace mms
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QByteArray>
+#include <QLabel>
+#include <QLocalSocket>
+#include <QString>
+#include <QTimer>
+#include <QWidget>
+
+#include "Map.h"
+#include "Maze.h"
+#include "MazeView.h"
+#include "Mouse.h"
+#include "MouseGraphic.h"
+
+namespace mms {
+
+// A lightweight, read-only window that draws the telemetry stream of another
+// sim (see TelemetryPublisher), reconnecting whenever the stream goes away
+class TelemetryViewer : public QWidget {
+
+    Q_OBJECT
+
+public:
+
+    TelemetryViewer(const QString& name, QWidget* parent = 0);
+    ~TelemetryViewer();
+    void closeEvent(QCloseEvent* event);
+
+private:
+
+    QString m_name;
+    QLocalSocket m_socket;
+    QByteArray m_buffer;
+    QTimer m_reconnectTimer;
+
+    Map m_map;
+    QLabel* m_status;
+
+    // The objects being drawn; all null until the first maze frame arrives
+    Maze* m_maze;
+    MazeView* m_view;
+    Mouse* m_mouse;
+    MouseGraphic* m_mouseGraphic;
+
+    void onReadyRead();
+    void handleMazeFrame(const QByteArray& payload);
+    void handleUpdateFrame(const QByteArray& payload);
+    void clear();
+
+};
+
+} // namespace mms
@@ -117,7 +117,7 @@ void Tile::initFullPolygon(int mazeWidth, int mazeHeight) {
         upperLeftPoint,
         upperRightPoint,
         lowerRightPoint,
-    });
+    }, PolygonShape::CONVEX);
 }
 
 void Tile::initInteriorPolygon(int mazeWidth, int mazeHeight) {
@@ -145,7 +145,7 @@ void Tile::initInteriorPolygon(int mazeWidth, int mazeHeight) {
             halfWallWidth * (getX() == mazeWidth - 1 ? -2 : -1),
             halfWallWidth * (getY() == 0 ? 2 : 1)
         ),
-    });
+    }, PolygonShape::CONVEX);
 }
 
 void Tile::initWallPolygons(int mazeWidth, int mazeHeight) {
@@ -171,7 +171,7 @@ void Tile::initWallPolygons(int mazeWidth, int mazeHeight) {
         outerUpperRightPoint.getY()
     ));
     northWall.push_back(innerUpperRightPoint);
-    m_wallPolygons.insert(Direction::NORTH, Polygon(northWall));
+    m_wallPolygons.insert(Direction::NORTH, Polygon(northWall, PolygonShape::CONVEX));
 
     QVector<Coordinate> eastWall;
     eastWall.push_back(innerLowerRightPoint);
@@ -184,7 +184,7 @@ void Tile::initWallPolygons(int mazeWidth, int mazeHeight) {
         outerLowerRightPoint.getX(),
         innerLowerRightPoint.getY()
     ));
-    m_wallPolygons.insert(Direction::EAST, Polygon(eastWall));
+    m_wallPolygons.insert(Direction::EAST, Polygon(eastWall, PolygonShape::CONVEX));
 
     QVector<Coordinate> southWall;
     southWall.push_back(Coordinate::Cartesian(
@@ -197,7 +197,7 @@ void Tile::initWallPolygons(int mazeWidth, int mazeHeight) {
         innerLowerRightPoint.getX(),
         outerLowerRightPoint.getY()
     ));
-    m_wallPolygons.insert(Direction::SOUTH, Polygon(southWall));
+    m_wallPolygons.insert(Direction::SOUTH, Polygon(southWall, PolygonShape::CONVEX));
 
     QVector<Coordinate> westWall;
     westWall.push_back(Coordinate::Cartesian(
@@ -210,7 +210,7 @@ void Tile::initWallPolygons(int mazeWidth, int mazeHeight) {
     ));
     westWall.push_back(innerUpperLeftPoint);
     westWall.push_back(innerLowerLeftPoint);
-    m_wallPolygons.insert(Direction::WEST, Polygon(westWall));
+    m_wallPolygons.insert(Direction::WEST, Polygon(westWall, PolygonShape::CONVEX));
 }
 
 void Tile::initCornerPolygons(int mazeWidth, int mazeHeight) {
@@ -236,7 +236,7 @@ void Tile::initCornerPolygons(int mazeWidth, int mazeHeight) {
         innerLowerLeftPoint.getX(),
         outerLowerLeftPoint.getY()
     ));
-    m_cornerPolygons.push_back(Polygon(lowerLeftCorner));
+    m_cornerPolygons.push_back(Polygon(lowerLeftCorner, PolygonShape::CONVEX));
 
     QVector<Coordinate> upperLeftCorner;
     upperLeftCorner.push_back(Coordinate::Cartesian(
@@ -249,7 +249,7 @@ void Tile::initCornerPolygons(int mazeWidth, int mazeHeight) {
         outerUpperLeftPoint.getY()
     ));
     upperLeftCorner.push_back(innerUpperLeftPoint);
-    m_cornerPolygons.push_back(Polygon(upperLeftCorner));
+    m_cornerPolygons.push_back(Polygon(upperLeftCorner, PolygonShape::CONVEX));
 
     QVector<Coordinate> upperRightCorner;
     upperRightCorner.push_back(innerUpperRightPoint);
@@ -262,7 +262,7 @@ void Tile::initCornerPolygons(int mazeWidth, int mazeHeight) {
         outerUpperRightPoint.getX(),
         innerUpperRightPoint.getY()
     ));
-    m_cornerPolygons.push_back(Polygon(upperRightCorner));
+    m_cornerPolygons.push_back(Polygon(upperRightCorner, PolygonShape::CONVEX));
 
     QVector<Coordinate> lowerRightCorner;
     lowerRightCorner.push_back(Coordinate::Cartesian(
@@ -275,7 +275,7 @@ void Tile::initCornerPolygons(int mazeWidth, int mazeHeight) {
         innerLowerRightPoint.getY()
     ));
     lowerRightCorner.push_back(outerLowerRightPoint);
-    m_cornerPolygons.push_back(Polygon(lowerRightCorner));
+    m_cornerPolygons.push_back(Polygon(lowerRightCorner, PolygonShape::CONVEX));
 }
 
 } // namespace mms
@@ -12,36 +12,25 @@ TileGraphic::TileGraphic() :
     m_tile(nullptr),
     m_bufferInterface(nullptr),
     m_color(Color::BLACK),
-    m_foggy(false),
-    m_wallTruthVisible(false),
-    m_tileColorsVisible(false),
-    m_tileFogVisible(false),
-    m_tileTextVisible(false) {
+    m_foggy(false) {
 }
 
 TileGraphic::TileGraphic(
         const Tile* tile,
         BufferInterface* bufferInterface,
-        bool wallTruthVisible,
-        bool tileColorsVisible,
-        bool tileFogVisible,
-        bool tileTextVisible,
         bool autopopulateTextWithDistance) :
         m_tile(tile),
         m_bufferInterface(bufferInterface),
         m_color(STRING_TO_COLOR().value(P()->tileBaseColor())),
-        m_foggy(true),
-        m_wallTruthVisible(wallTruthVisible),
-        m_tileColorsVisible(tileColorsVisible),
-        m_tileFogVisible(tileFogVisible),
-        m_tileTextVisible(tileTextVisible) {
+        m_foggy(true) {
     if (autopopulateTextWithDistance) {
-        m_text = (
+        m_initialText = (
             0 <= m_tile->getDistance()
             ? QString::number(m_tile->getDistance())
             : "inf"
         );
     }
+    m_text = m_initialText;
 }
 
 void TileGraphic::setColor(Color color) {
@@ -69,24 +58,21 @@ void TileGraphic::setText(const QString& text) {
     updateText();
 }
 
-void TileGraphic::setWallTruthVisible(bool visible) {
-    m_wallTruthVisible = visible;
-    updateWalls();
-}
-
-void TileGraphic::setTileColorsVisible(bool visible) {
-    m_tileColorsVisible = visible;
-    updateColor();
-}
-
-void TileGraphic::setTileFogVisible(bool visible) {
-    m_tileFogVisible = visible;
-    updateFog();
-}
-
-void TileGraphic::setTileTextVisible(bool visible) {
-    m_tileTextVisible = visible;
-    updateText();
+void TileGraphic::reset() {
+    Color baseColor = STRING_TO_COLOR().value(P()->tileBaseColor());
+    if (m_color != baseColor) {
+        setColor(baseColor);
+    }
+    if (!m_declaredWalls.isEmpty()) {
+        m_declaredWalls.clear();
+        updateWalls();
+    }
+    if (!m_foggy) {
+        setFogginess(true);
+    }
+    if (m_text != m_initialText) {
+        setText(m_initialText);
+    }
 }
 
 void TileGraphic::drawPolygons() const {
@@ -94,14 +80,15 @@ void TileGraphic::drawPolygons() const {
     // Note that the order in which we call insertIntoGraphicCpuBuffer
     // determines the order in which the polygons are drawn. Also note that the
     // *StartingIndex methods in GrahicsUtilities.h depend upon this order.
+    // Layer visibility is applied by the shader, based on each layer tag, so
+    // we always insert what the algorithm would see if every layer were on.
 
     // Draw the base of the tile
     m_bufferInterface->insertIntoGraphicCpuBuffer(
         m_tile->getFullPolygon(),
-        m_tileColorsVisible
-            ? m_color
-            : STRING_TO_COLOR().value(P()->tileBaseColor()),
-        1.0);
+        m_color,
+        1.0,
+        GraphicLayer::TILE_COLOR);
 
     // Draw each of the walls of the tile
     for (Direction direction : DIRECTIONS()) {
@@ -109,7 +96,8 @@ void TileGraphic::drawPolygons() const {
         m_bufferInterface->insertIntoGraphicCpuBuffer(
             m_tile->getWallPolygon(direction),
             colorAndAlpha.first,
-            colorAndAlpha.second);
+            colorAndAlpha.second,
+            deduceWallLayer(direction));
     }
 
     // Draw the corners of the tile
@@ -117,14 +105,16 @@ void TileGraphic::drawPolygons() const {
         m_bufferInterface->insertIntoGraphicCpuBuffer(
             polygon,
             STRING_TO_COLOR().value(P()->tileCornerColor()),
-            1.0);
+            1.0,
+            GraphicLayer::NONE);
     }
 
     // Draw the fog
     m_bufferInterface->insertIntoGraphicCpuBuffer(
         m_tile->getFullPolygon(),
         STRING_TO_COLOR().value(P()->tileFogColor()),
-        m_foggy && m_tileFogVisible ? P()->tileFogAlpha() : 0.0);
+        m_foggy ? P()->tileFogAlpha() : 0.0,
+        GraphicLayer::TILE_FOG);
 }
 
 void TileGraphic::drawTextures() {
@@ -144,9 +134,7 @@ void TileGraphic::updateColor() const {
     m_bufferInterface->updateTileGraphicBaseColor(
         m_tile->getX(),
         m_tile->getY(),
-        m_tileColorsVisible
-            ? m_color
-            : STRING_TO_COLOR().value(P()->tileBaseColor()));
+        m_color);
 }
 
 void TileGraphic::updateWalls() const {
@@ -159,7 +147,7 @@ void TileGraphic::updateFog() const {
     m_bufferInterface->updateTileGraphicFog(
         m_tile->getX(),
         m_tile->getY(),
-        m_foggy && m_tileFogVisible ? P()->tileFogAlpha() : 0.0);
+        m_foggy ? P()->tileFogAlpha() : 0.0);
 }
 
 void TileGraphic::updateText() const {
@@ -193,7 +181,6 @@ void TileGraphic::updateText() const {
             );
             QChar c = ' ';
             if (
-                m_tileTextVisible &&
                 row < rowsOfText.size() &&
                 col < rowsOfText.at(row).size()
             ) {
@@ -230,48 +217,42 @@ QPair<Color, float> TileGraphic::deduceWallColorAndAlpha(Direction direction) co
     Color wallColor = STRING_TO_COLOR().value(P()->tileWallColor());
     float wallAlpha = 1.0;
 
-    // Either draw the true walls of the tile ...
-    if (m_wallTruthVisible) {
-        wallAlpha = m_tile->isWall(direction) ? 1.0 : 0.0;
-    }
+    // Note that the true walls of the tile are drawn by the shader, based on
+    // the wall's layer, so here we only deal with the (un)declared walls
 
-    // ... or the algorithm's (un)declared walls
-    else {
-
-        // If the wall was declared, use the wall color and tile base color ...
-        if (m_declaredWalls.contains(direction)) {
-            if (m_declaredWalls.value(direction)) {
-                // Correct declaration
-                if (m_tile->isWall(direction)) {
-                    wallColor = STRING_TO_COLOR().value(P()->tileWallColor());
-                }
-                // Incorrect declaration
-                else {
-                    wallColor = STRING_TO_COLOR().value(P()->tileIncorrectlyDeclaredWallColor());
-                }
+    // If the wall was declared, use the wall color and tile base color ...
+    if (m_declaredWalls.contains(direction)) {
+        if (m_declaredWalls.value(direction)) {
+            // Correct declaration
+            if (m_tile->isWall(direction)) {
+                wallColor = STRING_TO_COLOR().value(P()->tileWallColor());
             }
+            // Incorrect declaration
             else {
-                // Incorrect declaration
-                if (m_tile->isWall(direction)) {
-                    wallColor = STRING_TO_COLOR().value(P()->tileIncorrectlyDeclaredNoWallColor());
-                }
-                // Correct declaration
-                else {
-                    wallAlpha = 0.0;
-                }
+                wallColor = STRING_TO_COLOR().value(P()->tileIncorrectlyDeclaredWallColor());
             }
         }
-
-        // ... otherwise, use the undeclared walls colors
         else {
+            // Incorrect declaration
             if (m_tile->isWall(direction)) {
-                wallColor = STRING_TO_COLOR().value(P()->tileUndeclaredWallColor());
+                wallColor = STRING_TO_COLOR().value(P()->tileIncorrectlyDeclaredNoWallColor());
             }
+            // Correct declaration
             else {
-                wallColor = STRING_TO_COLOR().value(P()->tileUndeclaredNoWallColor());
+                wallAlpha = 0.0;
             }
         }
     }
+
+    // ... otherwise, use the undeclared walls colors
+    else {
+        if (m_tile->isWall(direction)) {
+            wallColor = STRING_TO_COLOR().value(P()->tileUndeclaredWallColor());
+        }
+        else {
+            wallColor = STRING_TO_COLOR().value(P()->tileUndeclaredNoWallColor());
+        }
+    }
     
     // If the wall color is the same as the default tile base color,
     // we interpret that to mean that the walls should be transparent
@@ -282,4 +263,12 @@ QPair<Color, float> TileGraphic::deduceWallColorAndAlpha(Direction direction) co
     return {wallColor, wallAlpha};
 }
 
+GraphicLayer TileGraphic::deduceWallLayer(Direction direction) const {
+    return (
+        m_tile->isWall(direction)
+        ? GraphicLayer::WALL_PRESENT
+        : GraphicLayer::WALL_ABSENT
+    );
+}
+
 } // namespace mms
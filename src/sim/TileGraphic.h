@@ -5,6 +5,7 @@
 
 #include "BufferInterface.h"
 #include "Color.h"
+#include "GraphicLayer.h"
 #include "Tile.h"
 
 namespace mms {
@@ -17,10 +18,6 @@ public:
     TileGraphic(
         const Tile* tile,
         BufferInterface* bufferInterface,
-        bool wallTruthVisible,
-        bool tileColorsVisible,
-        bool tileFogVisible,
-        bool tileTextVisible,
         bool autopopulateTextWithDistance);
 
     void setColor(const Color color);
@@ -29,10 +26,9 @@ public:
     void setFogginess(bool foggy);
     void setText(const QString& text);
 
-    void setWallTruthVisible(bool visible);
-    void setTileColorsVisible(bool visible);
-    void setTileFogVisible(bool visible);
-    void setTileTextVisible(bool visible);
+    // Restores the state the tile had when it was created, only touching
+    // the parts of the buffers that actually change
+    void reset();
 
     // TODO: MACK - rename these to "reload" or something
     void drawPolygons() const;
@@ -57,15 +53,13 @@ private:
     bool m_foggy;
     QString m_text;
 
-    // Togglable options
-    bool m_wallTruthVisible;
-    bool m_tileColorsVisible;
-    bool m_tileFogVisible;
-    bool m_tileTextVisible;
+    // The text that the tile starts with, so that it can be reset
+    QString m_initialText;
 
     // Helper functions
     void updateWall(Direction direction) const;
     QPair<Color, float> deduceWallColorAndAlpha(Direction direction) const;
+    GraphicLayer deduceWallLayer(Direction direction) const;
 };
 
 } // namespace mms
@@ -0,0 +1,43 @@
+#include "TrailRingBuffer.h"
+
+#include <algorithm>
+
+#include "Assert.h"
+
+namespace mms {
+
+TrailRingBuffer::TrailRingBuffer(int capacity) :
+    m_capacity(capacity),
+    m_size(0) {
+    ASSERT_LT(0, capacity);
+    m_points.resize(m_capacity);
+}
+
+int TrailRingBuffer::getCapacity() const {
+    return m_capacity;
+}
+
+void TrailRingBuffer::push(const TrailPoint& point) {
+    qint64 index = m_size.load();
+    m_points[index % m_capacity] = point;
+    m_size.storeRelease(index + 1);
+}
+
+qint64 TrailRingBuffer::size() const {
+    return m_size.loadAcquire();
+}
+
+qint64 TrailRingBuffer::getFirstIndex() const {
+    return getFirstIndex(size());
+}
+
+qint64 TrailRingBuffer::getFirstIndex(qint64 size) const {
+    // Leave an eighth of the ring as slack between the writer and readers
+    return std::max(static_cast<qint64>(0), size - m_capacity + m_capacity / 8);
+}
+
+TrailPoint TrailRingBuffer::at(qint64 index) const {
+    return m_points.at(index % m_capacity);
+}
+
+} // namespace mms
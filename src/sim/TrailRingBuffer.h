@@ -0,0 +1,51 @@
+#pragma once
+
+#include <QAtomicInteger>
+#include <QVector>
+
+namespace mms {
+
+// A point along the path of the mouse, packed small since there are many
+struct TrailPoint {
+    float x;     // meters
+    float y;     // meters
+    float speed; // meters per second, averaged since the previous point
+};
+
+// A fixed-size history of the path of the mouse, written by the model thread
+// and read by the map without locking. Points are only pushed once the mouse
+// has moved some distance since the last one, so a long run that's mostly
+// idle (or mostly fast) costs no more memory than a short one.
+class TrailRingBuffer {
+
+public:
+
+    TrailRingBuffer(int capacity);
+
+    int getCapacity() const;
+
+    // Appends a point; must only ever be called from one thread
+    void push(const TrailPoint& point);
+
+    // The total number of points pushed so far, and the index of the oldest
+    // point that may still be safely read. As with SampleRingBuffer, the
+    // ring is not fully used, so that a reader has some slack.
+    qint64 size() const;
+    qint64 getFirstIndex() const;
+    qint64 getFirstIndex(qint64 size) const;
+
+    // Returns the point at the index, which should be in
+    // [getFirstIndex(), size())
+    TrailPoint at(qint64 index) const;
+
+private:
+
+    int m_capacity;
+    QVector<TrailPoint> m_points;
+
+    // Published after each point is fully written
+    QAtomicInteger<qint64> m_size;
+
+};
+
+} // namespace mms
@@ -1,14 +1,29 @@
 #pragma once
 
-#include "RGB.h"
+#include <QtGlobal>
+
+#include "GraphicLayer.h"
 
 namespace mms {
 
+// Packed for upload to the GPU: positions are floats, and the color values
+// are unsigned bytes that GL normalizes to [0.0, 1.0], for 16 bytes total
 struct VertexGraphic {
-    double x; // x position
-    double y; // y position
-    RGB rgb;  // rgb values
-    double a; // alpha value
+    float x;            // x position
+    float y;            // y position
+    quint8 r;           // red value
+    quint8 g;           // green value
+    quint8 b;           // blue value
+    quint8 a;           // alpha value
+    GraphicLayer layer; // layer that the vertex belongs to
+    quint8 padding[3];  // unused, keeps vertices four-byte aligned
 };
 
+static_assert(sizeof(VertexGraphic) == 16, "VertexGraphic must be tightly packed");
+
+// Converts a color (or alpha) value in [0.0, 1.0] to its packed form
+inline quint8 packColorValue(double value) {
+    return static_cast<quint8>(qBound(0.0, value, 1.0) * 255.0 + 0.5);
+}
+
 } // namespace mms
@@ -2,11 +2,14 @@
 
 namespace mms {
 
+// Packed for upload to the GPU, like VertexGraphic
 struct VertexTexture {
-    double x; // x position
-    double y; // y position
-    double u; // u position (x position in the texture)
-    double v; // v position (y position in the texture)
+    float x; // x position
+    float y; // y position
+    float u; // u position (x position in the texture)
+    float v; // v position (y position in the texture)
 };
 
+static_assert(sizeof(VertexTexture) == 16, "VertexTexture must be tightly packed");
+
 } // namespace mms
@@ -42,7 +42,7 @@ Wheel::Wheel(
     polygon.push_back(Coordinate::Cartesian(radius *  1, halfWidth * -1));
     polygon.push_back(Coordinate::Cartesian(radius *  1, halfWidth *  1));
     polygon.push_back(Coordinate::Cartesian(radius * -1, halfWidth *  1));
-    m_initialPolygon = Polygon(polygon)
+    m_initialPolygon = Polygon(polygon, PolygonShape::CONVEX)
         .translate(wheelPosition)
         .rotateAroundPoint(wheelDirection, wheelPosition);
 
@@ -120,6 +120,12 @@ void Wheel::resetRelativeEncoder() {
     m_relativeRotation = Angle::Radians(0);
 }
 
+void Wheel::reset() {
+    m_currentSpeed = AngularVelocity::RadiansPerSecond(0);
+    m_absoluteRotation = Angle::Radians(0);
+    m_relativeRotation = Angle::Radians(0);
+}
+
 WheelEffect Wheel::getEffect(const AngularVelocity& speed) const {
     return {
         m_unitForwardEffect * speed.getRadiansPerSecond(),
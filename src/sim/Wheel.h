@@ -44,6 +44,9 @@ public:
     int readRelativeEncoder() const;
     void resetRelativeEncoder();
 
+    // Stops the wheel and zeroes both encoders, as when it was created
+    void reset();
+
 private:
 
     // Wheel
@@ -2,10 +2,10 @@
 
 #include <QAction>
 #include <QFileDialog>
+#include <QFileInfo>
 #include <QFrame>
 #include <QGroupBox>
 #include <QHBoxLayout>
-#include <QLinkedList>
 #include <QMenu>
 #include <QMenuBar>
 #include <QMessageBox>
@@ -50,7 +50,10 @@ Window::Window(QWidget *parent) :
         m_mouseGraphic(nullptr),
         m_view(nullptr),
         m_mouseInterface(nullptr),
-        m_mouseAlgoThread(nullptr),
+        m_previousMouse(nullptr),
+        m_previousMouseGraphic(nullptr),
+        m_previousView(nullptr),
+        m_telemetryPublisher(nullptr),
 
         // MazeAlgosTab
         m_mazeAlgoWidget(new QWidget()),
@@ -83,6 +86,7 @@ Window::Window(QWidget *parent) :
         m_mouseAlgoRunStatus(new QLabel()),
         m_mouseAlgoRunOutput(new QPlainTextEdit()),
         m_mouseAlgoStatsWidget(new MouseAlgoStatsWidget()),
+        m_mouseAlgoPlotWidget(new SamplePlotWidget()),
         m_mouseAlgoSeedWidget(new RandomSeedWidget()),
         m_mouseAlgoPauseButton(new QPushButton("Pause")) {
 
@@ -95,6 +99,15 @@ Window::Window(QWidget *parent) :
     m_model.moveToThread(&m_modelThread);
     m_modelThread.start();
 
+    // Optionally let external viewers watch the runs
+    if (!P()->telemetrySocketName().isEmpty()) {
+        m_telemetryPublisher = new TelemetryPublisher(
+            P()->telemetrySocketName(),
+            P()->telemetryUpdateRate(),
+            P()->telemetryMaxBufferedBytes(),
+            this);
+    }
+
     // Add the splitter to the window
     QSplitter* splitter = new QSplitter();
     splitter->setHandleWidth(6);
@@ -212,12 +225,17 @@ Window::Window(QWidget *parent) :
     // Create the maze files tab
     MazeFilesTab* mazeFilesTab = new MazeFilesTab(); 
     connect(
-        mazeFilesTab, &MazeFilesTab::mazeFileChanged,
+        mazeFilesTab, &MazeFilesTab::mazeChanged,
+        this, &Window::setMaze
+    );
+    connect(
+        mazeFilesTab, &MazeFilesTab::mazeLoadFailed,
         this, [=](const QString& path){
-            Maze* maze = Maze::fromFile(path);
-            if (maze != nullptr) {
-                setMaze(maze);
-            }
+            QMessageBox::warning(
+                this,
+                "Invalid Maze File",
+                QString("Unable to load the maze file \"%1\".").arg(path)
+            );
         }
     );
     tabWidget->addTab(mazeFilesTab, "Maze Files");
@@ -324,32 +342,10 @@ Window::Window(QWidget *parent) :
     );
     mapTimer->start(secondsPerFrame * 1000);
 
-    // TODO: MACK - this is very expensive - fix it
-    /*
-    // Start the info loop
-    QTimer* otherTimer = new QTimer();
-    QLinkedList<double>* timestamps = new QLinkedList<double>();
-    int numFrames = 10;
-    connect(otherTimer, &QTimer::timeout, this, [=](){
-        double now = SimUtilities::getHighResTimestamp();
-        timestamps->append(now);
-        if (timestamps->size() > numFrames) {
-            double then = timestamps->takeFirst();
-            double fps = numFrames / (now - then);
-        }
-        QPair<QStringList, QVector<QVariant>> runStats = getRunStats();
-        QStringList keys = runStats.first;
-        QVector<QVariant> values = runStats.second;
-        for (int i = 0; i < keys.size(); i += 1) {
-            QString text = values.at(i).toString();
-            if (values.at(i).type() == QVariant::Double) {
-                text = QString::number(values.at(i).toDouble(), 'f', 3);
-            }
-            m_runStats.value(keys.at(i))->setText(text);
-        }
-    });
-    //otherTimer->start(100); // 10 fps
-    */
+    // Refresh the run stats at 10 Hz
+    QTimer* runStatsTimer = new QTimer();
+    connect(runStatsTimer, &QTimer::timeout, this, &Window::refreshRunStats);
+    runStatsTimer->start(100);
 }
 
 void Window::closeEvent(QCloseEvent *event) {
@@ -358,6 +354,7 @@ void Window::closeEvent(QCloseEvent *event) {
     mazeAlgoRunStop();
     mouseAlgoBuildStop();
     mouseAlgoRunStop();
+    deletePreviousRunObjects();
     m_map.shutdown();
     m_model.shutdown();
     m_modelThread.quit();
@@ -367,9 +364,12 @@ void Window::closeEvent(QCloseEvent *event) {
 
 void Window::setMaze(Maze* maze) {
 
-    // Stop running maze/mouse algos
+    // Stop running maze/mouse algos. The previous run's objects refer to
+    // the old maze, so they can't be reused.
     mazeAlgoRunStop();
     mouseAlgoRunStop();
+    deletePreviousRunObjects();
+    m_crashedMouseAlgo.clear();
 
     // Next, update the maze and truth
     Maze* oldMaze = m_maze;
@@ -388,6 +388,9 @@ void Window::setMaze(Maze* maze) {
     m_model.setMaze(m_maze);
     m_map.setMaze(m_maze);
     m_map.setView(m_truth);
+    if (m_telemetryPublisher != nullptr) {
+        m_telemetryPublisher->setMaze(m_maze);
+    }
 
     // Update maze stats UI widgets
     m_mazeWidthLabel->setText(QString::number(m_maze->getWidth()));
@@ -667,9 +670,8 @@ void Window::algoActionStop(
     }
 }
 
-QPair<QStringList, QVector<QVariant>> Window::getRunStats() const {
-
-    static QStringList keys = {
+QStringList Window::getRunStatsKeys() {
+    return {
         "Tiles Traversed",
         "Closest Distance to Center",
         "Current X (m)",
@@ -683,47 +685,70 @@ QPair<QStringList, QVector<QVariant>> Window::getRunStats() const {
         "Time Since Origin Departure",
         "Best Time to Center",
         "Crashed",
+        "Current Clearance (mm)",
+        "Min Clearance (mm)",
     };
+}
+
+QStringList Window::getRunStatsValues(const RunStats& stats) const {
 
-    QVector<QVariant> values;
-    MouseStats stats = m_model.getMouseStats();
+    static const int numKeys = getRunStatsKeys().size();
+
+    QStringList values;
+    values.reserve(numKeys);
 
     // This means the mouse isn't in the maze
-    if (stats.closestDistanceToCenter < 0) {
-        for (int i = 0; i < keys.size(); i += 1) {
+    if (!stats.hasMouse || m_maze == nullptr) {
+        for (int i = 0; i < numKeys; i += 1) {
             values.append("N/A");
         }
-    }
-    else {
-        // TODO: MACK - m_mouse can be null here :/ ...
-        values.append(
-            QString::number(stats.traversedTileLocations.size()) + " / " +
-            QString::number(m_maze->getWidth() * m_maze->getHeight())
-        );
-        values.append(stats.closestDistanceToCenter);
-        values.append(m_mouse->getCurrentTranslation().getX().getMeters());
-        values.append(m_mouse->getCurrentTranslation().getY().getMeters());
-        values.append(m_mouse->getCurrentRotation().getDegreesZeroTo360());
-        values.append(m_mouse->getCurrentDiscretizedTranslation().first);
-        values.append(m_mouse->getCurrentDiscretizedTranslation().second);
-        values.append(DIRECTION_TO_STRING().value(m_mouse->getCurrentDiscretizedRotation()));
-        values.append(SimUtilities::formatDuration(SimTime::get()->elapsedRealTime()));
-        values.append(SimUtilities::formatDuration(SimTime::get()->elapsedSimTime()));
-        values.append(
-            stats.timeOfOriginDeparture.getSeconds() < 0
-            ? "NONE"
-            : SimUtilities::formatDuration(
-                SimTime::get()->elapsedSimTime() - stats.timeOfOriginDeparture)
-        );
-        values.append(
-            stats.bestTimeToCenter.getSeconds() < 0
-            ? "NONE"
-            : SimUtilities::formatDuration(stats.bestTimeToCenter)
-        );
-        values.append((m_mouse->didCrash() ? "TRUE" : "FALSE"));
+        return values;
     }
 
-    return {keys, values};
+    values.append(
+        QString::number(stats.tilesTraversed) + " / " +
+        QString::number(m_maze->getWidth() * m_maze->getHeight())
+    );
+    values.append(QString::number(stats.closestDistanceToCenter));
+    values.append(QString::number(stats.translation.getX().getMeters(), 'f', 3));
+    values.append(QString::number(stats.translation.getY().getMeters(), 'f', 3));
+    values.append(QString::number(stats.rotation.getDegreesZeroTo360(), 'f', 3));
+    values.append(QString::number(stats.tile.first));
+    values.append(QString::number(stats.tile.second));
+    values.append(DIRECTION_TO_STRING().value(stats.direction));
+    values.append(SimUtilities::formatDuration(SimTime::get()->elapsedRealTime()));
+    values.append(SimUtilities::formatDuration(stats.elapsedSimTime));
+    values.append(
+        stats.timeOfOriginDeparture.getSeconds() < 0
+        ? "NONE"
+        : SimUtilities::formatDuration(
+            stats.elapsedSimTime - stats.timeOfOriginDeparture)
+    );
+    values.append(
+        stats.bestTimeToCenter.getSeconds() < 0
+        ? "NONE"
+        : SimUtilities::formatDuration(stats.bestTimeToCenter)
+    );
+    values.append(stats.crashed ? "TRUE" : "FALSE");
+    values.append(
+        !stats.hasClearance
+        ? "NONE"
+        : QString::number(stats.clearance * 1000.0, 'f', 1)
+    );
+    values.append(
+        !stats.hasClearance
+        ? "NONE"
+        : QString::number(stats.minClearance * 1000.0, 'f', 1)
+    );
+    return values;
+}
+
+void Window::refreshRunStats() {
+    // Nobody's looking, so don't bother
+    if (!m_mouseAlgoStatsWidget->isVisible()) {
+        return;
+    }
+    m_mouseAlgoStatsWidget->setValues(getRunStatsValues(m_model.getRunStats()));
 }
 
 #if(0)
@@ -1241,6 +1266,7 @@ void Window::mouseAlgoTabInit() {
     m_mouseAlgoOutputTabWidget->addTab(m_mouseAlgoRunOutput, "Run Output");
     m_mouseAlgoOutputTabWidget->addTab(m_mouseAlgoRunOutput, "Run Output");
     m_mouseAlgoOutputTabWidget->addTab(m_mouseAlgoStatsWidget, "Stats");
+    m_mouseAlgoOutputTabWidget->addTab(m_mouseAlgoPlotWidget, "Plots");
 
     // Set the default values for some widgets
     for (QPlainTextEdit* output : {
@@ -1259,8 +1285,7 @@ void Window::mouseAlgoTabInit() {
     }
 
     // Add the algo run stats
-    QPair<QStringList, QVector<QVariant>> runStats = getRunStats();
-    m_mouseAlgoStatsWidget->init(runStats.first);
+    m_mouseAlgoStatsWidget->init(getRunStatsKeys());
 
     // Add the mouse algos
     mouseAlgoRefresh(SettingsRecent::getRecentMouseAlgo());
@@ -1476,306 +1501,315 @@ void Window::mouseAlgoRunStart() {
         return;
     }
 
-    // Generate the mouse, check mouse file success
-    Mouse* newMouse = new Mouse(m_maze);
-    bool success = newMouse->reload(mouseFile);
-    if (!success) {
-        QMessageBox::warning(
-            this,
-            "Invalid Mouse File",
-            QString("Mouse file \"%1\"could not be loaded.").arg(
-                mouseFile
-            )
-        );
-        delete newMouse;
-        return;
+    // Reuse the mouse of the current or previous run if it was loaded from
+    // the same, unmodified mouse file, since parsing and triangulating the
+    // mouse is relatively expensive. Otherwise, generate a new mouse.
+    QDateTime lastModified = QFileInfo(mouseFile).lastModified();
+    Mouse* previousMouse = (m_mouse != nullptr ? m_mouse : m_previousMouse);
+    bool reusePrevious = (
+        previousMouse != nullptr &&
+        previousMouse->getMouseFile() == mouseFile &&
+        m_mouseFileLastModified == lastModified
+    );
+    Mouse* newMouse = nullptr;
+    if (!reusePrevious) {
+        newMouse = new Mouse(m_maze);
+        bool success = newMouse->reload(mouseFile);
+        if (!success) {
+            QMessageBox::warning(
+                this,
+                "Invalid Mouse File",
+                QString("Mouse file \"%1\"could not be loaded.").arg(
+                    mouseFile
+                )
+            );
+            delete newMouse;
+            return;
+        }
     }
 
     // Stop running maze/mouse algorithms
     mazeAlgoRunStop();
     mouseAlgoRunStop();
 
-    // Create some more objects
-    MazeView* newView = new MazeView(
-        m_maze,
-        m_wallTruthCheckbox->isChecked(),
-        m_colorCheckbox->isChecked(),
-        m_fogCheckbox->isChecked(),
-        m_textCheckbox->isChecked(),
-        false // autopopulateTextWithDistance
-    );
-    MouseGraphic* newMouseGraphic = new MouseGraphic(newMouse);
+    // Either reset the previous run's objects or create some more objects
+    MazeView* newView = nullptr;
+    MouseGraphic* newMouseGraphic = nullptr;
+    if (reusePrevious) {
+        newMouse = m_previousMouse;
+        newView = m_previousView;
+        newMouseGraphic = m_previousMouseGraphic;
+        m_previousMouse = nullptr;
+        m_previousView = nullptr;
+        m_previousMouseGraphic = nullptr;
+        newMouse->resetToInitialState();
+        if (m_crashedMouseAlgo != algoName) {
+            newView->reset();
+        }
+        MazeGraphic* mazeGraphic = newView->getMazeGraphic();
+        mazeGraphic->setWallTruthVisible(m_wallTruthCheckbox->isChecked());
+        mazeGraphic->setTileColorsVisible(m_colorCheckbox->isChecked());
+        mazeGraphic->setTileFogVisible(m_fogCheckbox->isChecked());
+        mazeGraphic->setTileTextVisible(m_textCheckbox->isChecked());
+    }
+    else {
+        deletePreviousRunObjects();
+        m_mouseFileLastModified = lastModified;
+        newView = new MazeView(
+            m_maze,
+            m_wallTruthCheckbox->isChecked(),
+            m_colorCheckbox->isChecked(),
+            m_fogCheckbox->isChecked(),
+            m_textCheckbox->isChecked(),
+            false // autopopulateTextWithDistance
+        );
+        newMouseGraphic = new MouseGraphic(newMouse);
+    }
+    newView->getMazeGraphic()->setTelemetryPublisher(m_telemetryPublisher);
+    bool resumingAfterCrash = (reusePrevious && m_crashedMouseAlgo == algoName);
+    m_crashedMouseAlgo.clear();
+
+    // The mouse interface holds the state and connections of a single run,
+    // and is cheap to create, so it's never reused
     MouseInterface* newMouseInterface = new MouseInterface(
         m_maze,
         newMouse,
-        newView
+        newView,
+        &m_model
     );
 
     // Clear the output, and jump to it
     m_mouseAlgoRunOutput->clear();
     m_mouseAlgoOutputTabWidget->setCurrentWidget(m_mouseAlgoRunOutput);
+    if (resumingAfterCrash) {
+        m_mouseAlgoRunOutput->appendPlainText(
+            "Keeping the walls, colors, and text declared before the previous "
+            "run crashed (see getDeclaredState)");
+    }
 
     // Append the random seed to the command
     command += " ";
     command += QString::number(m_mouseAlgoSeedWidget->next());
 
-    // The thread on which the mouse interface will execute
-    QThread* newMouseAlgoThread = new QThread();
-
-    // Instantiate the algorithm's QProcess object in a separate thread to
-    // prevent the Controller from blocking the GUI loop while performing an
-    // algorithm-requested action.
-    connect(newMouseAlgoThread, &QThread::started, newMouseInterface, [=](){
-        
-        // Create the subprocess on which we'll execute the mouse algorithm
-        QProcess* newProcess = new QProcess();
-
-        // Ideally, we could call readAllStandardOutput() and appendPlainText()
-        // within the same lambda. Unfortunately, this isn't possible:
-        // - readAllStandardOutput() and readAllStandardError() aren't thread
-        //   safe, and so they must both be called in the algo thread
-        // - appendPlainText() can only be called from within the UI thread
-        // Thus, we have to use a queued signal/slot connection between the
-        // mouse interface (which has affinity in the algo thread) and the
-        // Window (which has affinity in the UI thread), hence two connect()
-        // calls.
-        connect(
-            newProcess,
-            &QProcess::readyReadStandardOutput,
-            newMouseInterface,
-            [=](){
-                QString output = newProcess->readAllStandardOutput();
-                newMouseInterface->handleStandardOutput(output);
-            }
-        );
-        connect(
-            newMouseInterface,
-            &MouseInterface::algoOutput,
-            this,
-            [=](QString output){
-                m_mouseAlgoRunOutput->appendPlainText(output);
-            }
-        );
+    // The algorithm's process and the mouse interface both live on the UI
+    // thread; the mouse interface never blocks, since movements finish
+    // asynchronously, so the UI stays responsive while the mouse moves
+    QProcess* newProcess = new QProcess();
+    connect(
+        newProcess,
+        &QProcess::readyReadStandardOutput,
+        this,
+        [=](){
+            QString output = newProcess->readAllStandardOutput();
+            newMouseInterface->handleStandardOutput(output);
+        }
+    );
+    connect(
+        newMouseInterface,
+        &MouseInterface::algoOutput,
+        this,
+        [=](QString output){
+            m_mouseAlgoRunOutput->appendPlainText(output);
+        }
+    );
 
-        // Process all stderr commands as appropriate
-        connect(
-            newProcess,
-            &QProcess::readyReadStandardError,
-            // Handle the process's stderr on the mouse's event loop to
-            // prevent the UI from freezing during a blocking mouse action
-            newMouseInterface,
-            [=](){
-                QString text = newProcess->readAllStandardError();
-                QStringList lines = getLines(text, &m_stderrBuffer);
-                for (const QString& line : lines) {
-                    QString response = newMouseInterface->dispatch(line);
-                    if (!response.isEmpty()) {
-                        newProcess->write((response + "\n").toStdString().c_str());
-                    }
-                }
+    // Process all stderr commands as appropriate
+    connect(
+        newProcess,
+        &QProcess::readyReadStandardError,
+        newMouseInterface,
+        [=](){
+            QString text = newProcess->readAllStandardError();
+            QStringList lines = SimUtilities::getLines(text, &m_stderrBuffer);
+            for (const QString& line : lines) {
+                newMouseInterface->handleCommand(line);
             }
-        );
+        }
+    );
+    connect(
+        newMouseInterface,
+        &MouseInterface::response,
+        newProcess,
+        [=](QString response){
+            newProcess->write((response + "\n").toStdString().c_str());
+        }
+    );
 
-        // Connect the input buttons to the algorithm
-        for (int i = 0; i < m_mouseAlgoInputButtons.size(); i += 1) {
-            QPushButton* button = m_mouseAlgoInputButtons.at(i);
-            connect(button, &QPushButton::clicked, this, [=](){
-                button->setEnabled(false);
-                // Note: we can't call inputButtonWasPressed directly because
-                // it's not thread-safe; instead, we use a queued connection
-                emit inputButtonWasPressed(i);
-            });
-            connect(
-                this,
-                &Window::inputButtonWasPressed,
-                newMouseInterface,
-                &MouseInterface::inputButtonWasPressed
-            );
-            connect(
-                newMouseInterface,
-                &MouseInterface::inputButtonWasAcknowledged,
-                this,
-                [=](int button) {
-                    m_mouseAlgoInputButtons.at(button)->setEnabled(true);
-                }
-            );
+    // Connect the input buttons to the algorithm
+    for (int i = 0; i < m_mouseAlgoInputButtons.size(); i += 1) {
+        QPushButton* button = m_mouseAlgoInputButtons.at(i);
+        connect(button, &QPushButton::clicked, newMouseInterface, [=](){
+            button->setEnabled(false);
+            newMouseInterface->inputButtonWasPressed(i);
+        });
+    }
+    connect(
+        newMouseInterface,
+        &MouseInterface::inputButtonWasAcknowledged,
+        this,
+        [=](int button) {
+            m_mouseAlgoInputButtons.at(button)->setEnabled(true);
         }
+    );
 
-        // First, connect the newTileLocationTraversed signal to a lambda that
-        // clears tile fog *before* adding the mouse to the maze. This ensures
-        // that the first tile's fog is always cleared (the initial value of
-        // automaticallyClearFog is true). This means that, if an algorithm
-        // doesn't want to automatically clear tile fog, it'll have to disable
-        // tile fog and then mark the first tile as foggy.
-        connect(
-            &m_model,
-            &Model::newTileLocationTraversed,
-            // TODO: upforgrabs
-            // Changing "newMouseInterface" to "this" makes it so that the fog
-            // clears as soon as the mouse enters a tile (rather than waiting
-            // for the algorithm-requested action to finish). However, it also
-            // causes segfaults. Your mission is to make this work without
-            // causing segfaults.
-            newMouseInterface,
-            [=](int x, int y){
-                if (newMouseInterface->getDynamicOptions().automaticallyClearFog) {
-                    newView->getMazeGraphic()->setTileFogginess(x, y, false);
-                }
+    // First, connect the newTileLocationTraversed signal to a lambda that
+    // clears tile fog *before* adding the mouse to the maze. This ensures
+    // that the first tile's fog is always cleared (the initial value of
+    // automaticallyClearFog is true). This means that, if an algorithm
+    // doesn't want to automatically clear tile fog, it'll have to disable
+    // tile fog and then mark the first tile as foggy.
+    connect(
+        &m_model,
+        &Model::newTileLocationTraversed,
+        newMouseInterface,
+        [=](int x, int y){
+            if (newMouseInterface->getDynamicOptions().automaticallyClearFog) {
+                newView->getMazeGraphic()->setTileFogginess(x, y, false);
             }
-        );
-
-        // We need to add the mouse to the world *after* the making the
-        // previous connection (thus ensuring that tile fog is cleared
-        // automatically), but *before* we actually start the algorithm (lest
-        // the mouse position/orientation not be updated properly during the
-        // beginning of the mouse algo's execution)
-        m_model.setMouse(newMouse);
-
-        // Re-enable run button when build finishes, clean up the process
-        connect(
-            newProcess,
-            static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(
-                &QProcess::finished
-            ),
-            this,
-            [=](int exitCode, QProcess::ExitStatus exitStatus){
+        }
+    );
 
-                // TODO: MACK - does the thread get cleaned up if the mouse exits normally?
+    // We need to add the mouse to the world *after* the making the
+    // previous connection (thus ensuring that tile fog is cleared
+    // automatically), but *before* we actually start the algorithm (lest
+    // the mouse position/orientation not be updated properly during the
+    // beginning of the mouse algo's execution)
+    m_model.setMouse(newMouse);
 
-                // Set the button to "Action"
-                disconnect(
-                    m_mouseAlgoRunButton, &QPushButton::clicked,
-                    this, &Window::mouseAlgoRunStop
-                );
-                connect(
-                    m_mouseAlgoRunButton, &QPushButton::clicked,
-                    this, &Window::mouseAlgoRunStart
-                );
-                m_mouseAlgoRunButton->setText("Run");
-
-                // Update the status label, call stderrPostAction
-                if (exitStatus == QProcess::NormalExit && exitCode == 0) {
-                    m_mouseAlgoRunStatus->setText("COMPLETE");
-                    m_mouseAlgoRunStatus->setStyleSheet(
-                        "QLabel { background: rgb(150, 255, 100); }"
-                    );
-                }
-                else {
-                    // This special case is necessary because
-                    // mouseAlgoRunStop() finishes before this executes
-                    if (m_mouseAlgoRunStatus->text() != "CANCELED") {
-                        m_mouseAlgoRunStatus->setText("FAILED");
-                    }
-                    m_mouseAlgoRunStatus->setStyleSheet(
-                        "QLabel { background: rgb(255, 150, 150); }"
-                    );
-                }
-            }
-        );
-
-        // When the thread finishes, clean everything up
-        connect(newMouseAlgoThread, &QThread::finished, this, [=](){
-            newProcess->terminate();
-            newProcess->waitForFinished();
-            delete newProcess;
-            delete newMouseAlgoThread;
-            delete newMouseInterface;
-            delete newMouseGraphic;
-            delete newView;
-            delete newMouse;
-        });
+    // Re-enable run button when build finishes
+    connect(
+        newProcess,
+        static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(
+            &QProcess::finished
+        ),
+        this,
+        [=](int exitCode, QProcess::ExitStatus exitStatus){
 
-        // If the process fails to start, stop the thread and cleanup
-        bool success = ProcessUtilities::start(command, dirPath, newProcess);
-        if (!success) {
-            connect(
-                newMouseInterface,
-                &MouseInterface::mouseAlgoCannotStart,
-                this,
-                &Window::handleMouseAlgoCannotStart
+            // Set the button to "Action"
+            disconnect(
+                m_mouseAlgoRunButton, &QPushButton::clicked,
+                this, &Window::mouseAlgoRunStop
             );
-            newMouseInterface->emitMouseAlgoCannotStart(
-                newProcess->errorString()
+            connect(
+                m_mouseAlgoRunButton, &QPushButton::clicked,
+                this, &Window::mouseAlgoRunStart
             );
-            newMouseAlgoThread->quit();
-            return;
-        }
+            m_mouseAlgoRunButton->setText("Run");
 
-        // Update the member variables because, at this
-        // point, the algorithm started successfully
-        m_mouse = newMouse;
-        m_view = newView;
-        m_mouseGraphic = newMouseGraphic;
-        m_mouseInterface = newMouseInterface;
-        m_mouseAlgoThread = newMouseAlgoThread;
-        m_mouseAlgoRunProcess = newProcess;
-        m_map.setView(newView);
-        m_map.setMouseGraphic(newMouseGraphic);
-
-        // We have to do some gymnastics here (similar to above)
-        // to ensure that the UI updates happen on the UI thread
-        connect(
-            newMouseInterface,
-            &MouseInterface::mouseAlgoStarted,
-            this,
-            [=](){
-                // UI updates on successful start
-                m_viewButton->setEnabled(true);
-                m_viewButton->setChecked(true);
-                m_followCheckbox->setEnabled(true);
-                m_mouseAlgoPauseButton->setEnabled(true);
-                for (QPushButton* button : m_mouseAlgoInputButtons) {
-                    button->setEnabled(true);
-                }
-                m_mouseAlgoRunStatus->setText("RUNNING");
+            // Update the status label, call stderrPostAction
+            if (exitStatus == QProcess::NormalExit && exitCode == 0) {
+                m_mouseAlgoRunStatus->setText("COMPLETE");
                 m_mouseAlgoRunStatus->setStyleSheet(
-                    "QLabel { background: rgb(255, 255, 100); }"
-                );
-                disconnect(
-                    m_mouseAlgoRunButton, &QPushButton::clicked,
-                    this, &Window::mouseAlgoRunStart
+                    "QLabel { background: rgb(150, 255, 100); }"
                 );
-                connect(
-                    m_mouseAlgoRunButton, &QPushButton::clicked,
-                    this, &Window::mouseAlgoRunStop
+            }
+            else {
+                // This special case is necessary because
+                // mouseAlgoRunStop() sets the status before this executes
+                if (m_mouseAlgoRunStatus->text() != "CANCELED") {
+                    m_mouseAlgoRunStatus->setText("FAILED");
+                    m_crashedMouseAlgo = algoName;
+                }
+                m_mouseAlgoRunStatus->setStyleSheet(
+                    "QLabel { background: rgb(255, 150, 150); }"
                 );
-                m_mouseAlgoRunButton->setText("Cancel");
             }
-        );
-        newMouseInterface->emitMouseAlgoStarted();
-    });
+        }
+    );
+
+    // If the process fails to start, clean up
+    bool success = ProcessUtilities::start(command, dirPath, newProcess);
+    if (!success) {
+        handleMouseAlgoCannotStart(newProcess->errorString());
+        delete newProcess;
+        delete newMouseInterface;
+        m_previousMouse = newMouse;
+        m_previousMouseGraphic = newMouseGraphic;
+        m_previousView = newView;
+        return;
+    }
+
+    newMouseInterface->setAlgoProcessId(newProcess->processId());
+
+    // Update the member variables because, at this
+    // point, the algorithm started successfully
+    m_mouse = newMouse;
+    m_view = newView;
+    m_mouseGraphic = newMouseGraphic;
+    m_mouseInterface = newMouseInterface;
+    m_mouseAlgoRunProcess = newProcess;
+    m_map.setView(newView);
+    m_map.setMouseGraphic(newMouseGraphic);
+    m_map.setTrailBuffer(m_model.getTrailBuffer());
+    if (m_telemetryPublisher != nullptr) {
+        m_telemetryPublisher->setMouse(newMouse);
+    }
 
-    // Start the mouse interface thread
-    newMouseInterface->moveToThread(newMouseAlgoThread);
-    newMouseAlgoThread->start();
+    // UI updates on successful start
+    m_mouseAlgoPlotWidget->setBuffers(
+        m_model.getSampleBuffers(),
+        Model::getSecondsPerSample());
+    m_viewButton->setEnabled(true);
+    m_viewButton->setChecked(true);
+    m_followCheckbox->setEnabled(true);
+    m_mouseAlgoPauseButton->setEnabled(true);
+    for (QPushButton* button : m_mouseAlgoInputButtons) {
+        button->setEnabled(true);
+    }
+    m_mouseAlgoRunStatus->setText("RUNNING");
+    m_mouseAlgoRunStatus->setStyleSheet(
+        "QLabel { background: rgb(255, 255, 100); }"
+    );
+    disconnect(
+        m_mouseAlgoRunButton, &QPushButton::clicked,
+        this, &Window::mouseAlgoRunStart
+    );
+    connect(
+        m_mouseAlgoRunButton, &QPushButton::clicked,
+        this, &Window::mouseAlgoRunStop
+    );
+    m_mouseAlgoRunButton->setText("Cancel");
 }
 
 void Window::mouseAlgoRunStop() {
 
-    // Only stop the algo thread if an algo is running
+    // Only stop the algo if an algo is running
     if (m_mouseInterface != nullptr) {
-        // If the mouse interface exists, the thread exists
-        ASSERT_FA(m_mouseAlgoThread == nullptr);
-        // Request the event loop to stop
-        m_mouseAlgoThread->quit();
-        // Quickly return control to the event loop
+        // Stop the movement in progress, if any, so that no more mouse
+        // functions will execute
         m_mouseInterface->requestStop();
-        // Wait for the event loop to actually stop
-        m_mouseAlgoThread->wait();
-        // At this point, no more mouse functions will execute
         m_mouseAlgoRunStatus->setText("CANCELED");
     }
 
     // Regardless of whether or not an algo is running, put the Window in a
-    // "mouseless" state (note that the objects themselves get deleted in a
-    // separate callback). Note that we do this *after* stopping the algo
-    // thread so that we can be sure no more stderr will be emitted.
+    // "mouseless" state. Note that we do this *after* stopping the mouse
+    // interface so that we can be sure no more movements will start.
     m_stderrBuffer.clear();
     m_map.setMouseGraphic(nullptr);
+    m_map.setTrailBuffer(nullptr);
     m_map.setView(m_truth);
     m_model.removeMouse();
+    if (m_telemetryPublisher != nullptr) {
+        m_telemetryPublisher->setMouse(nullptr);
+    }
+
+    // Now that the model no longer refers to them, clean everything up
+    if (m_mouseAlgoRunProcess != nullptr) {
+        m_mouseAlgoRunProcess->terminate();
+        m_mouseAlgoRunProcess->waitForFinished();
+        delete m_mouseAlgoRunProcess;
+    }
+    delete m_mouseInterface;
+
+    // Keep the mouse, its graphic, and its view so that the next run can
+    // reset them in place, rather than build them from scratch
+    if (m_mouse != nullptr) {
+        deletePreviousRunObjects();
+        m_previousMouse = m_mouse;
+        m_previousMouseGraphic = m_mouseGraphic;
+        m_previousView = m_view;
+    }
     m_mouseAlgoRunProcess = nullptr;
-    m_mouseAlgoThread = nullptr;
     m_mouseInterface = nullptr;
     m_mouseGraphic = nullptr;
     m_view = nullptr;
@@ -1793,6 +1827,15 @@ void Window::mouseAlgoRunStop() {
     }
 }
 
+void Window::deletePreviousRunObjects() {
+    delete m_previousMouseGraphic;
+    delete m_previousView;
+    delete m_previousMouse;
+    m_previousMouseGraphic = nullptr;
+    m_previousView = nullptr;
+    m_previousMouse = nullptr;
+}
+
 void Window::handleMouseAlgoCannotStart(QString errorString) {
     m_mouseAlgoRunStatus->setText("ERROR");
     m_mouseAlgoRunStatus->setStyleSheet(
@@ -1880,36 +1923,4 @@ QVector<ConfigDialogField> Window::mouseAlgoGetFields() {
     };
 }
 
-QStringList Window::getLines(const QString& text, QStringList* buffer) {
-
-    // TODO: upforgrabs
-    // Determine whether or not this function is perf sensitive. If so,
-    // refactor this so that we're not copying QStrings between lists.
-
-    // Separate the text by line
-    QStringList parts = SimUtilities::splitLines(text);
-
-    // We'll return list of complete lines
-    QStringList lines;
-
-    // If the text has at least one newline character, we definitely have a
-    // complete line; combine it with the contents of the buffer and append
-    // it to the list of lines to be returned
-    if (1 < parts.size()) {
-        lines.append(buffer->join("") + parts.at(0));
-        buffer->clear();
-    }
-
-    // All newline-separated parts in the text are lines
-    for (int i = 1; i < parts.size() - 1; i += 1) {
-        lines.append(parts.at(i));
-    }
-
-    // Store the last part of the text (empty string if the text ended
-    // with newline) in the buffer, to be combined with future input
-    buffer->append(parts.at(parts.size() - 1));
-
-    return lines;
-}
-
 } // namespace mms
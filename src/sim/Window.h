@@ -3,6 +3,7 @@
 #include <QCheckBox>
 #include <QCloseEvent>
 #include <QComboBox>
+#include <QDateTime>
 #include <QLabel>
 #include <QMainWindow>
 #include <QPlainTextEdit>
@@ -20,6 +21,8 @@
 #include "MouseGraphic.h"
 #include "MouseInterface.h"
 #include "RandomSeedWidget.h"
+#include "SamplePlotWidget.h"
+#include "TelemetryPublisher.h"
 
 namespace mms {
 
@@ -34,9 +37,6 @@ public:
 
 signals:
 
-    // Emits this signal when a user presses an input button
-    void inputButtonWasPressed(int button);
-
     // Emits this signal when the mouse algo can't start
     void mouseAlgoCannotStart(QString errorString);
 
@@ -80,6 +80,22 @@ private:
     MazeView* m_view;
     MouseInterface* m_mouseInterface;
 
+    // The mouse, its graphic, and its view from the previous run, kept so
+    // that the next run can reset them in place rather than rebuild them,
+    // as long as the mouse file hasn't changed in the meantime
+    Mouse* m_previousMouse;
+    MouseGraphic* m_previousMouseGraphic;
+    MazeView* m_previousView;
+    QDateTime m_mouseFileLastModified;
+    void deletePreviousRunObjects();
+
+    // The algorithm of the previous run, if it crashed; its next run keeps
+    // the declared state, which it can retrieve with getDeclaredState
+    QString m_crashedMouseAlgo;
+
+    // Streams the maze and mouse to external viewers, if enabled
+    TelemetryPublisher* m_telemetryPublisher;
+
     // Helper function for updating the maze 
     void setMaze(Maze* maze);
 
@@ -167,10 +183,6 @@ private:
     void mouseAlgoBuildStop();
     void mouseAlgoBuildStderr();
 
-    // The event loop for the mouse algo process. We need a separate loop so
-    // that the GUI doesn't lock up on blocking algo commands, like sleep
-    QThread* m_mouseAlgoThread;
-
     // Mouse algo running
     QStringList m_stderrBuffer;
     QProcess* m_mouseAlgoRunProcess;
@@ -178,6 +190,7 @@ private:
     QLabel* m_mouseAlgoRunStatus;
     QPlainTextEdit* m_mouseAlgoRunOutput;
     MouseAlgoStatsWidget* m_mouseAlgoStatsWidget;
+    SamplePlotWidget* m_mouseAlgoPlotWidget;
     void mouseAlgoRunStart();
     void mouseAlgoRunStop();
     void handleMouseAlgoCannotStart(QString errorString);
@@ -191,14 +204,12 @@ private:
     void mouseAlgoRefresh(const QString& name = "");
     QVector<ConfigDialogField> mouseAlgoGetFields();
 
-    // Given some text (and a buffer containing past input), return
-    // all complete lines and append remaining text to the buffer
-    QStringList getLines(const QString& text, QStringList* buffer);
-
     // ----- Misc ----- //
 
-    QMap<QString, QLabel*> m_runStats;
-    QPair<QStringList, QVector<QVariant>> getRunStats() const;
+    // The live run stats, which are refreshed from the model's snapshot
+    static QStringList getRunStatsKeys();
+    QStringList getRunStatsValues(const RunStats& stats) const;
+    void refreshRunStats();
 };
 
 } // namespace mms
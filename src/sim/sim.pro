@@ -1,5 +1,7 @@
 QT += core
 QT += gui
+QT += network
+QT += sql
 QT += xml
 QT += widgets
 